@@ -0,0 +1,79 @@
+#include <cstdint>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "BinarySearchTree.h"
+#include "bench.h"
+
+/*
+    Insert/erase churn on a BinarySearchTree with one new/delete per node
+    (HeapNodes) against one whose nodes come from a NodePool
+    (PooledNodes<>).
+
+    USAGE: ./build/node_pool [nodes] [operations]
+        nodes defaults to 1M live keys, operations to 5M
+
+    Keys are random (the tree does not balance itself), drawn from twice
+    the number of live nodes. Each operation erases a random key and
+    inserts another one, so the tree stays about the same size while its
+    nodes are recycled. Lookups of random keys and clear() are timed
+    after the churn.
+*/
+
+namespace {
+
+    using Pooled = PooledNodes<>;
+
+    template <class Tree>
+    void run(const char* label, size_t n, size_t ops) {
+        std::mt19937_64 rng(42);
+        const uint64_t key_space = 2 * n;
+        double t_fill = 0, t_churn = 0, t_find = 0, t_clear = 0;
+        size_t found = 0;
+        {
+            Tree tree;
+            t_fill = bench::seconds([&] {
+                for (size_t i = 0; i < n; i++) {
+                    int key = static_cast<int>(rng() % key_space);
+                    tree.insert({ key, key });
+                }
+            });
+
+            t_churn = bench::seconds([&] {
+                for (size_t op = 0; op < ops; op++) {
+                    tree.erase(static_cast<int>(rng() % key_space));
+                    int key = static_cast<int>(rng() % key_space);
+                    tree.insert({ key, key });
+                }
+            });
+
+            t_find = bench::seconds([&] {
+                for (size_t i = 0; i < n; i++) {
+                    found += tree.contains(static_cast<int>(rng() % key_space));
+                }
+            });
+            bench::keep(found);
+
+            t_clear = bench::seconds([&] { tree.clear(); });
+        }
+
+        std::cout << label << std::endl;
+        bench::report("  fill", t_fill * 1e3, "ms");
+        bench::report("  churn (erase + insert)", t_churn / ops * 1e9, "ns/op");
+        bench::report("  lookups after churn", t_find / n * 1e9, "ns/op");
+        bench::report("  clear", t_clear * 1e3, "ms");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 5000000;
+
+    bench::header("BinarySearchTree<int, int> churn, " + std::to_string(n) + " keys, " + std::to_string(ops) + " operations");
+    run<BinarySearchTree<int, int>>("new/delete per node", n, ops);
+    run<BinarySearchTree<int, int, std::less<int>, Pooled>>("NodePool", n, ops);
+    return 0;
+}
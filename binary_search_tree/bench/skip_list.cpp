@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "BinarySearchTree.h"
+#include "SkipList.h"
+#include "bench.h"
+
+/*
+    SkipList against BinarySearchTree on three workloads:
+
+    - sorted insert: keys 0, 1, 2, ... in order, which turns the
+      unbalanced tree into a linked list (O(n) per insert)
+    - random insert, then random lookups: a shuffled 0..n-1
+    - range scan: count and sum the values of `width` consecutive keys
+      from a random start; the SkipList walks its bottom level from
+      lower_bound, the tree (which has no iterators) looks up every key
+
+    USAGE: ./build/skip_list [keys] [sorted keys] [scans] [width]
+        defaults to 1M keys, 20000 sorted keys, 200000 scans of width 100
+
+    The sorted run is kept small because the tree takes quadratic time
+    (and recursion depth) on it.
+*/
+
+namespace {
+
+    using Tree = BinarySearchTree<int, int>;
+    using Skip = SkipList<int, int>;
+
+    void sorted_insert(size_t n) {
+        bench::header("sorted insert, " + std::to_string(n) + " keys");
+        double t_tree = bench::seconds([&] {
+            Tree tree;
+            for (size_t i = 0; i < n; i++) {
+                tree.insert({ static_cast<int>(i), static_cast<int>(i) });
+            }
+            bench::keep(tree.size());
+        });
+        double t_skip = bench::seconds([&] {
+            Skip list;
+            for (size_t i = 0; i < n; i++) {
+                list.insert({ static_cast<int>(i), static_cast<int>(i) });
+            }
+            bench::keep(list.size());
+        });
+        bench::report("BinarySearchTree", t_tree / n * 1e9, "ns/insert");
+        bench::report("SkipList", t_skip / n * 1e9, "ns/insert");
+        bench::report("SkipList speedup", t_tree / t_skip, "x");
+    }
+
+    void random_and_scan(size_t n, size_t scans, size_t width) {
+        std::vector<int> keys(n);
+        std::iota(keys.begin(), keys.end(), 0);
+        std::shuffle(keys.begin(), keys.end(), std::mt19937_64(42));
+
+        Tree tree;
+        Skip list;
+        double t_tree_insert = bench::seconds([&] {
+            for (int key : keys) {
+                tree.insert({ key, key });
+            }
+        });
+        double t_skip_insert = bench::seconds([&] {
+            for (int key : keys) {
+                list.insert({ key, key });
+            }
+        });
+
+        bench::header("random insert, " + std::to_string(n) + " keys");
+        bench::report("BinarySearchTree", t_tree_insert / n * 1e9, "ns/insert");
+        bench::report("SkipList", t_skip_insert / n * 1e9, "ns/insert");
+        bench::report("SkipList height", static_cast<double>(list.height()), "levels");
+
+        std::shuffle(keys.begin(), keys.end(), std::mt19937_64(7));
+        int64_t sum = 0;
+        double t_tree_find = bench::seconds([&] {
+            for (int key : keys) {
+                sum += tree.find(key);
+            }
+        });
+        double t_skip_find = bench::seconds([&] {
+            for (int key : keys) {
+                sum += list.find(key)->second;
+            }
+        });
+        bench::keep(sum);
+
+        bench::header("random find, " + std::to_string(n) + " keys");
+        bench::report("BinarySearchTree", t_tree_find / n * 1e9, "ns/find");
+        bench::report("SkipList", t_skip_find / n * 1e9, "ns/find");
+
+        std::mt19937_64 rng(99);
+        std::vector<int> starts(scans);
+        for (int& start : starts) {
+            start = static_cast<int>(rng() % (n - width));
+        }
+        double t_tree_scan = bench::seconds([&] {
+            for (int start : starts) {
+                for (int key = start; key < start + static_cast<int>(width); key++) {
+                    if (tree.contains(key)) {
+                        sum += tree.find(key);
+                    }
+                }
+            }
+        });
+        double t_skip_scan = bench::seconds([&] {
+            for (int start : starts) {
+                int end = start + static_cast<int>(width);
+                for (auto it = list.lower_bound(start); it != list.end() && it->first < end; ++it) {
+                    sum += it->second;
+                }
+            }
+        });
+        bench::keep(sum);
+
+        bench::header("range scan, " + std::to_string(scans) + " scans of " + std::to_string(width) + " keys");
+        bench::report("BinarySearchTree (a lookup per key)", t_tree_scan / scans * 1e9, "ns/scan");
+        bench::report("SkipList (lower_bound + iterate)", t_skip_scan / scans * 1e9, "ns/scan");
+        bench::report("SkipList speedup", t_tree_scan / t_skip_scan, "x");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t sorted = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+    size_t scans = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 200000;
+    size_t width = argc > 4 ? std::strtoull(argv[4], nullptr, 10) : 100;
+
+    sorted_insert(sorted);
+    random_and_scan(n, scans, width);
+    return 0;
+}
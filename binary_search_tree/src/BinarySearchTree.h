@@ -3,9 +3,14 @@
 #include <functional> // std::less
 #include <iostream>
 #include <queue> // std::queue
+#include <type_traits> // std::is_trivially_destructible
 #include <utility> // std::pair
 
-template <typename K, typename V, typename Comparator = std::less<K>>
+#include "NodePool.h"
+
+// NodeAlloc decides where the nodes live: HeapNodes (one new/delete per
+// node) or PooledNodes<> (slab pages owned by the tree), see NodePool.h
+template <typename K, typename V, typename Comparator = std::less<K>, typename NodeAlloc = HeapNodes>
 class BinarySearchTree
 {
   public:
@@ -37,10 +42,12 @@ class BinarySearchTree
     using node           = BinaryNode;
     using node_ptr       = node*;
     using const_node_ptr = const node*;
+    using node_pool      = typename NodeAlloc::template pool<node>;
 
     node_ptr _root;
     size_type _size;
     key_compare comp;
+    node_pool nodes;
 
   public:
     BinarySearchTree() {
@@ -54,7 +61,7 @@ class BinarySearchTree
             
 
     }
-    BinarySearchTree( BinarySearchTree && rhs ) {
+    BinarySearchTree( BinarySearchTree && rhs ) : nodes( std::move( rhs.nodes ) ) {
         _root = rhs._root;
         _size = rhs._size;
         rhs._root = nullptr;
@@ -80,7 +87,14 @@ class BinarySearchTree
     }
 
     void clear() {
-        clear( _root );
+        if (node_pool::bulk_release && std::is_trivially_destructible<pair>::value) {
+            // nothing to destroy, hand back the pool's pages at once
+            nodes.release();
+            _root = nullptr;
+        }
+        else {
+            clear( _root );
+        }
         _size = 0;
     }
 
@@ -108,6 +122,7 @@ class BinarySearchTree
         }
 
         clear();
+        nodes = std::move(rhs.nodes);
         _root = rhs._root;
         _size = rhs._size;
         rhs._root = nullptr;
@@ -120,7 +135,7 @@ class BinarySearchTree
     void insert( const_reference x, node_ptr & t ) {
 
         if (t == nullptr) { //if empty
-            t = new BinaryNode(x, nullptr, nullptr);
+            t = nodes.create(x, nullptr, nullptr);
             ++_size;
             return;
         }
@@ -139,7 +154,7 @@ class BinarySearchTree
     }
     void insert( pair && x, node_ptr & t ) {
         if (t == nullptr) {
-            t = new BinaryNode(std::move(x), nullptr, nullptr);
+            t = nodes.create(std::move(x), nullptr, nullptr);
             _size++;
             return;
         } 
@@ -168,7 +183,7 @@ class BinarySearchTree
         //no children
         else if (t->right == nullptr && t->left == nullptr) {
 
-            delete t;
+            nodes.destroy(t);
             t = nullptr;
             _size--;
             return;
@@ -177,7 +192,7 @@ class BinarySearchTree
         else if (t->right == nullptr) {
             node_ptr temp = t;
             t = t->left;
-            delete temp;
+            nodes.destroy(temp);
             _size--;
             return;
         }
@@ -185,7 +200,7 @@ class BinarySearchTree
         else if (t->left == nullptr) {
             node_ptr temp = t;
             t = t->right;
-            delete temp;
+            nodes.destroy(temp);
             _size--;
             return;
         }
@@ -266,55 +281,55 @@ class BinarySearchTree
         if (t->right != nullptr) {
             clear(t->right);
         }
-        delete t;
+        nodes.destroy(t);
         t = nullptr;
     }
     
-    node_ptr clone ( const_node_ptr t ) const {
+    node_ptr clone ( const_node_ptr t ) {
         if (t == nullptr) {
             return nullptr;
         }
-        node_ptr n = new BinaryNode(t->element, clone(t->left), clone(t->right));
+        node_ptr n = nodes.create(t->element, clone(t->left), clone(t->right));
         return n;
     }
 
   public:
-    template <typename KK, typename VV, typename CC>
-    friend void printLevelByLevel( const BinarySearchTree<KK, VV, CC>& bst, std::ostream & out );
+    template <typename KK, typename VV, typename CC, typename AA>
+    friend void printLevelByLevel( const BinarySearchTree<KK, VV, CC, AA>& bst, std::ostream & out );
 
-    template <typename KK, typename VV, typename CC>
-    friend std::ostream& printNode(std::ostream& o, const typename BinarySearchTree<KK, VV, CC>::node& bn);
+    template <typename KK, typename VV, typename CC, typename AA>
+    friend std::ostream& printNode(std::ostream& o, const typename BinarySearchTree<KK, VV, CC, AA>::node& bn);
 
-    template <typename KK, typename VV, typename CC>
-    friend void printTree( const BinarySearchTree<KK, VV, CC>& bst, std::ostream & out );
+    template <typename KK, typename VV, typename CC, typename AA>
+    friend void printTree( const BinarySearchTree<KK, VV, CC, AA>& bst, std::ostream & out );
 
-    template <typename KK, typename VV, typename CC>
-    friend void printTree(typename BinarySearchTree<KK, VV, CC>::const_node_ptr t, std::ostream & out, unsigned depth );
+    template <typename KK, typename VV, typename CC, typename AA>
+    friend void printTree(typename BinarySearchTree<KK, VV, CC, AA>::const_node_ptr t, std::ostream & out, unsigned depth );
 
-    template <typename KK, typename VV, typename CC>
+    template <typename KK, typename VV, typename CC, typename AA>
     friend void vizTree(
-        typename BinarySearchTree<KK, VV, CC>::const_node_ptr node, 
+        typename BinarySearchTree<KK, VV, CC, AA>::const_node_ptr node, 
         std::ostream & out,
-        typename BinarySearchTree<KK, VV, CC>::const_node_ptr prev
+        typename BinarySearchTree<KK, VV, CC, AA>::const_node_ptr prev
     );
 
-    template <typename KK, typename VV, typename CC>
+    template <typename KK, typename VV, typename CC, typename AA>
     friend void vizTree(
-        const BinarySearchTree<KK, VV, CC> & bst, 
+        const BinarySearchTree<KK, VV, CC, AA> & bst, 
         std::ostream & out
     );
 };
 
-template <typename KK, typename VV, typename CC>
-std::ostream& printNode(std::ostream & o, const typename BinarySearchTree<KK, VV, CC>::node & bn) {
+template <typename KK, typename VV, typename CC, typename AA>
+std::ostream& printNode(std::ostream & o, const typename BinarySearchTree<KK, VV, CC, AA>::node & bn) {
     return o << '(' << bn.element.first << ", " << bn.element.second << ')';
 }
 
-template <typename KK, typename VV, typename CC>
-void printLevelByLevel( const BinarySearchTree<KK, VV, CC>& bst, std::ostream & out = std::cout ) {
-    using node = typename BinarySearchTree<KK, VV, CC>::node;
-    using node_ptr = typename BinarySearchTree<KK, VV, CC>::node_ptr;
-    using const_node_ptr = typename BinarySearchTree<KK, VV, CC>::const_node_ptr;
+template <typename KK, typename VV, typename CC, typename AA>
+void printLevelByLevel( const BinarySearchTree<KK, VV, CC, AA>& bst, std::ostream & out = std::cout ) {
+    using node = typename BinarySearchTree<KK, VV, CC, AA>::node;
+    using node_ptr = typename BinarySearchTree<KK, VV, CC, AA>::node_ptr;
+    using const_node_ptr = typename BinarySearchTree<KK, VV, CC, AA>::const_node_ptr;
     
     if (bst._root == nullptr) {
         return;
@@ -363,25 +378,25 @@ void printLevelByLevel( const BinarySearchTree<KK, VV, CC>& bst, std::ostream &
 
 
 
-template <typename KK, typename VV, typename CC>
-void printTree( const BinarySearchTree<KK, VV, CC> & bst, std::ostream & out = std::cout ) { printTree<KK, VV, CC>(bst._root, out ); }
+template <typename KK, typename VV, typename CC, typename AA>
+void printTree( const BinarySearchTree<KK, VV, CC, AA> & bst, std::ostream & out = std::cout ) { printTree<KK, VV, CC, AA>(bst._root, out ); }
 
-template <typename KK, typename VV, typename CC>
-void printTree(typename BinarySearchTree<KK, VV, CC>::const_node_ptr t, std::ostream & out, unsigned depth = 0 ) {
+template <typename KK, typename VV, typename CC, typename AA>
+void printTree(typename BinarySearchTree<KK, VV, CC, AA>::const_node_ptr t, std::ostream & out, unsigned depth = 0 ) {
     if (t != nullptr) {
-        printTree<KK, VV, CC>(t->right, out, depth + 1);
+        printTree<KK, VV, CC, AA>(t->right, out, depth + 1);
         for (unsigned i = 0; i < depth; ++i)
             out << '\t';
-        printNode<KK, VV, CC>(out, *t) << '\n';
-        printTree<KK, VV, CC>(t->left, out, depth + 1);
+        printNode<KK, VV, CC, AA>(out, *t) << '\n';
+        printTree<KK, VV, CC, AA>(t->left, out, depth + 1);
     }
 }
 
-template <typename KK, typename VV, typename CC>
+template <typename KK, typename VV, typename CC, typename AA>
 void vizTree(
-    typename BinarySearchTree<KK, VV, CC>::const_node_ptr node, 
+    typename BinarySearchTree<KK, VV, CC, AA>::const_node_ptr node, 
     std::ostream & out,
-    typename BinarySearchTree<KK, VV, CC>::const_node_ptr prev = nullptr
+    typename BinarySearchTree<KK, VV, CC, AA>::const_node_ptr prev = nullptr
 ) {
     if(node) {
         std::hash<KK> khash{};
@@ -397,17 +412,17 @@ void vizTree(
         
         out << "node_" << (uint32_t) khash(node->element.first) << ";" << std::endl;
     
-        vizTree<KK, VV, CC>(node->left, out, node);
-        vizTree<KK, VV, CC>(node->right, out, node);
+        vizTree<KK, VV, CC, AA>(node->left, out, node);
+        vizTree<KK, VV, CC, AA>(node->right, out, node);
     }
 }
 
-template <typename KK, typename VV, typename CC>
+template <typename KK, typename VV, typename CC, typename AA>
 void vizTree(
-    const BinarySearchTree<KK, VV, CC> & bst, 
+    const BinarySearchTree<KK, VV, CC, AA> & bst, 
     std::ostream & out = std::cout
 ) {
     out << "digraph Tree {" << std::endl;
-    vizTree<KK, VV, CC>(bst._root, out);
+    vizTree<KK, VV, CC, AA>(bst._root, out);
     out << "}" << std::endl;
 }
@@ -0,0 +1,289 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <new> // placement new
+#include <utility> // std::forward
+
+/*
+    Node allocation policies
+    ------------------------
+
+    The node based containers (List, BinarySearchTree, UnorderedMap) take
+    an allocation policy as a template parameter:
+
+    List<int>                    nodes are new'ed and deleted one by one
+    List<int, PooledNodes<>>     nodes come from a NodePool owned by the list
+
+    A policy is a class with a nested template pool<Node> that provides
+
+    Node* create(args...)        allocates and constructs a node
+    void destroy(Node*)          destroys and frees one node
+    void release()               frees every node at once, without running
+                                 destructors
+    void adopt(pool& other)      takes over every node of other, which
+                                 is left empty
+    static bool bulk_release     whether release() is cheaper than
+                                 destroying the nodes one by one
+    static bool transferable     whether a single node may be handed to
+                                 another container and freed by its pool
+
+    Containers hold their pool by value, so moving a container moves its
+    pool with it and a copy gets a new, empty pool. Operations that move
+    all of one container's nodes into another (List::splice of a whole
+    list, List::merge) adopt the other pool; moving only some nodes is
+    only possible when the policy is transferable.
+
+    NodePool
+    --------
+
+    Hands out fixed-size node slots carved from pages of NodesPerPage
+    slots. A freed slot goes on an intrusive free list (the link is stored
+    in the dead node itself) and is the next one handed out, so churn
+    (insert, erase, insert ...) never reaches malloc once the pool has
+    warmed up. Nodes allocated together sit next to each other in memory.
+
+    release() frees whole pages, O(pages) instead of O(nodes); containers
+    use it for clear() and destruction when their elements are trivially
+    destructible.
+
+    With ThreadCache = true, release() keeps up to MaxCachedPages pages in
+    a per-thread cache (per node type) instead of freeing them, and new
+    pages are taken from that cache first. That helps when many short-lived
+    containers of the same type are created and dropped on one thread.
+
+    A NodePool is not thread safe; like the container owning it, it must
+    be used from one thread at a time.
+
+    This file is kept identical in list/src, binary_search_tree/src and
+    unordered_map/src; each module's node_pool test compares the copies.
+*/
+
+template <class Node, size_t NodesPerPage = 64, bool ThreadCache = false, size_t MaxCachedPages = 256>
+class NodePool {
+    static_assert(NodesPerPage > 0, "a page needs at least one node");
+
+    union Slot {
+        Slot* next; // while the slot is on the free list
+        alignas(Node) unsigned char storage[sizeof(Node)];
+    };
+
+    struct Page {
+        Page* next;
+        Slot slots[NodesPerPage];
+    };
+
+    // Pages released on this thread, waiting to be reused
+    struct Cache {
+        Page* pages = nullptr;
+        size_t count = 0;
+
+        ~Cache() {
+            while (pages != nullptr) {
+                Page* next = pages->next;
+                delete pages;
+                pages = next;
+            }
+        }
+    };
+
+    static Cache& cache() {
+        static thread_local Cache c;
+        return c;
+    }
+
+    Page* pages;      // every page this pool owns, newest first
+    Page* last_page;  // the oldest page, so adopt() can append without a walk
+    Slot* free_list;  // freed slots, most recently freed first
+    Slot* free_tail;  // the last slot on the free list, stale while it is empty
+    size_t unused;    // slots of the newest page never handed out
+
+    Slot* take_slot() {
+        if (free_list != nullptr) {
+            Slot* slot = free_list;
+            free_list = slot->next;
+            return slot;
+        }
+        if (unused == 0) {
+            add_page();
+        }
+        return &pages->slots[NodesPerPage - unused--];
+    }
+
+    void give_back(Slot* slot) noexcept {
+        if (free_list == nullptr) {
+            free_tail = slot;
+        }
+        slot->next = free_list;
+        free_list = slot;
+    }
+
+    void add_page() {
+        Page* page = nullptr;
+        if (ThreadCache && cache().pages != nullptr) {
+            page = cache().pages;
+            cache().pages = page->next;
+            cache().count--;
+        }
+        else {
+            page = new Page;
+        }
+        if (pages == nullptr) {
+            last_page = page;
+        }
+        page->next = pages;
+        pages = page;
+        unused = NodesPerPage;
+    }
+
+public:
+    static constexpr bool bulk_release = true;
+    static constexpr bool transferable = false;
+    static constexpr size_t nodes_per_page = NodesPerPage;
+
+    NodePool() noexcept : pages(nullptr), last_page(nullptr), free_list(nullptr), free_tail(nullptr), unused(0) {}
+
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    NodePool(NodePool&& other) noexcept
+        : pages(other.pages), last_page(other.last_page), free_list(other.free_list), free_tail(other.free_tail), unused(other.unused) {
+        other.pages = nullptr;
+        other.last_page = nullptr;
+        other.free_list = nullptr;
+        other.free_tail = nullptr;
+        other.unused = 0;
+    }
+
+    // The nodes of this pool must already be destroyed (or trivially destructible)
+    NodePool& operator=(NodePool&& other) noexcept {
+        if (this != &other) {
+            release();
+            pages = other.pages;
+            last_page = other.last_page;
+            free_list = other.free_list;
+            free_tail = other.free_tail;
+            unused = other.unused;
+            other.pages = nullptr;
+            other.last_page = nullptr;
+            other.free_list = nullptr;
+            other.free_tail = nullptr;
+            other.unused = 0;
+        }
+        return *this;
+    }
+
+    ~NodePool() {
+        release();
+    }
+
+    template <class... Args>
+    Node* create(Args&&... args) {
+        Slot* slot = take_slot();
+        try {
+            return new (slot->storage) Node(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            give_back(slot);
+            throw;
+        }
+    }
+
+    void destroy(Node* node) noexcept {
+        node->~Node();
+        give_back(reinterpret_cast<Slot*>(node));
+    }
+
+    // Takes over other's pages, and with them every node other handed out.
+    // The slots other never used or freed can be handed out by this pool.
+    // O(1): both lists are spliced at their tails, and at most one page's
+    // never used slots (NodesPerPage) are moved to the free list.
+    void adopt(NodePool& other) noexcept {
+        if (this == &other || other.pages == nullptr) {
+            return;
+        }
+
+        // the never used slots of other's newest page go on the free list
+        while (other.unused > 0) {
+            other.give_back(&other.pages->slots[NodesPerPage - other.unused--]);
+        }
+        if (other.free_list != nullptr) {
+            other.free_tail->next = free_list;
+            if (free_list == nullptr) {
+                free_tail = other.free_tail;
+            }
+            free_list = other.free_list;
+        }
+
+        // other's pages go behind ours, so our newest page stays first
+        if (pages == nullptr) {
+            pages = other.pages;
+        }
+        else {
+            last_page->next = other.pages;
+        }
+        last_page = other.last_page;
+
+        other.pages = nullptr;
+        other.last_page = nullptr;
+        other.free_list = nullptr;
+        other.free_tail = nullptr;
+    }
+
+    // Frees every page without running the nodes' destructors
+    void release() noexcept {
+        while (pages != nullptr) {
+            Page* next = pages->next;
+            if (ThreadCache && cache().count < MaxCachedPages) {
+                pages->next = cache().pages;
+                cache().pages = pages;
+                cache().count++;
+            }
+            else {
+                delete pages;
+            }
+            pages = next;
+        }
+        last_page = nullptr;
+        free_list = nullptr;
+        free_tail = nullptr;
+        unused = 0;
+    }
+
+    size_t page_count() const noexcept {
+        size_t count = 0;
+        for (Page* page = pages; page != nullptr; page = page->next) {
+            count++;
+        }
+        return count;
+    }
+};
+
+// Default policy: every node is its own new and delete
+struct HeapNodes {
+    template <class Node>
+    class pool {
+    public:
+        static constexpr bool bulk_release = false;
+        static constexpr bool transferable = true;
+
+        template <class... Args>
+        Node* create(Args&&... args) {
+            return new Node(std::forward<Args>(args)...);
+        }
+
+        void destroy(Node* node) noexcept {
+            delete node;
+        }
+
+        void release() noexcept {}
+
+        void adopt(pool&) noexcept {}
+    };
+};
+
+// Nodes come from a NodePool owned by the container
+template <size_t NodesPerPage = 64, bool ThreadCache = false>
+struct PooledNodes {
+    template <class Node>
+    using pool = NodePool<Node, NodesPerPage, ThreadCache>;
+};
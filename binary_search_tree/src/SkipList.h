@@ -0,0 +1,486 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstdint> // uint64_t
+#include <functional> // std::less
+#include <iterator> // std::bidirectional_iterator_tag
+#include <new> // placement new, ::operator new
+#include <type_traits> // std::enable_if_t, std::is_same
+#include <utility> // std::pair, std::move, std::forward
+
+/*
+    SkipList
+    --------
+
+    An ordered map with the interface of std::map's core: find,
+    lower_bound/upper_bound, insert, erase, and bidirectional iterators
+    that walk the keys in order.
+
+    Every node sits in a sorted linked list (the bottom level), and a
+    random subset of nodes is also linked into sparser lists above it:
+
+    level 2  head ------------------------> 40 ------------------> end
+    level 1  head --------> 17 -----------> 40 --------> 63 -----> end
+    level 0  head -> 5 ---> 17 -> 23 -> 31 -> 40 -> 51 -> 63 -> 70 -> head
+
+    A search starts on the top level and drops a level whenever the next
+    key would overshoot, so it visits O(log n) nodes on average whatever
+    order the keys were inserted in. Unlike BinarySearchTree, sorted input
+    does not make it degenerate.
+
+    A node reaches each level above the bottom with probability 1/4, drawn
+    from a xoshiro256 generator, so nodes average 1.33 links. The links
+    (the node's "tower") are allocated in the same block as the node,
+    right after the element, so one allocation and usually one cache line
+    serve both.
+
+    Like List, the bottom level is doubly linked and closed into a ring
+    through the head sentinel, which is also end(): --end() is the last
+    element and iteration never tests for null. The upper levels are
+    singly linked and end in nullptr.
+*/
+
+template <typename K, typename V, typename Comparator = std::less<K>>
+class SkipList {
+public:
+    using key_type        = K;
+    using mapped_type     = V;
+    using value_type      = std::pair<const K, V>;
+    using key_compare     = Comparator;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+
+private:
+    // xoshiro256++ seeded through splitmix64, the same generator as the
+    // tests' xoshiro256, kept here so that SkipList.h stands alone
+    class TowerRandom {
+        uint64_t s[4];
+
+        static uint64_t rotl(uint64_t x, int k) noexcept { return (x << k) | (x >> (64 - k)); }
+
+    public:
+        explicit TowerRandom(uint64_t seed) noexcept {
+            for (uint64_t& word : s) {
+                uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+                z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+                z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+                word = z ^ (z >> 31);
+            }
+        }
+
+        uint64_t operator()() noexcept {
+            const uint64_t result = rotl(s[0] + s[3], 23) + s[0];
+            const uint64_t t = s[1] << 17;
+            s[2] ^= s[0];
+            s[3] ^= s[1];
+            s[1] ^= s[2];
+            s[0] ^= s[3];
+            s[2] ^= t;
+            s[3] = rotl(s[3], 45);
+            return result;
+        }
+    };
+
+    // 4^32 elements before the towers stop growing
+    static constexpr unsigned max_height = 32;
+
+    struct Links {
+        Links* prev;     // bottom level only
+        unsigned height; // levels in the tower
+    };
+
+    // The tower of height links follows the node in the same block
+    struct Node : Links {
+        value_type element;
+
+        template <class... Args>
+        explicit Node(unsigned height, Args&&... args) : element(std::forward<Args>(args)...) {
+            this->prev = nullptr;
+            this->height = height;
+        }
+    };
+
+    static_assert(alignof(Node) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "the element type is over-aligned");
+
+    // tower(links)[i] is the next node on level i. The head keeps its tower
+    // at the same offset, so nodes and the head are walked alike.
+    static Links** tower(const Links* links) noexcept {
+        return reinterpret_cast<Links**>(const_cast<char*>(reinterpret_cast<const char*>(links)) + sizeof(Node));
+    }
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = SkipList::value_type;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+
+    private:
+        friend class SkipList;
+
+        Links* links;
+
+        explicit basic_iterator(Links* links) noexcept : links(links) {}
+
+    public:
+        basic_iterator() noexcept : links(nullptr) {}
+
+        // iterator converts to const_iterator
+        template <typename P, typename R,
+                  typename = std::enable_if_t<!std::is_same<P, pointer_type>::value && std::is_same<pointer_type, const_pointer>::value>>
+        basic_iterator(const basic_iterator<P, R>& other) noexcept : links(other.links) {}
+
+        reference operator*() const { return static_cast<Node*>(links)->element; }
+        pointer operator->() const { return &static_cast<Node*>(links)->element; }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            links = tower(links)[0];
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator temp(*this);
+            links = tower(links)[0];
+            return temp;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            links = links->prev;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator temp(*this);
+            links = links->prev;
+            return temp;
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept { return links == other.links; }
+        bool operator!=(const basic_iterator& other) const noexcept { return links != other.links; }
+
+        template <typename, typename>
+        friend class basic_iterator;
+    };
+
+public:
+    using iterator       = basic_iterator<pointer, reference>;
+    using const_iterator = basic_iterator<const_pointer, const_reference>;
+
+private:
+    // The head sentinel: a Links and a full tower, laid out like a node
+    alignas(Node) unsigned char head_block[sizeof(Node) + max_height * sizeof(Links*)];
+    unsigned _height; // levels in use, at least 1
+    size_type _size;
+    key_compare comp;
+    TowerRandom rng;
+
+    Links* head() const noexcept { return reinterpret_cast<Links*>(const_cast<unsigned char*>(head_block)); }
+
+    static const key_type& key_of(const Links* links) noexcept { return static_cast<const Node*>(links)->element.first; }
+
+    // Does links hold a key less than key, on a level where the list continues?
+    bool before(const Links* links, const key_type& key) const {
+        return links != nullptr && links != head() && comp(key_of(links), key);
+    }
+
+    bool not_after(const Links* links, const key_type& key) const {
+        return links != nullptr && links != head() && !comp(key, key_of(links));
+    }
+
+    // 1 + the number of times a 1/4 chance comes up in a row
+    unsigned random_height() {
+        uint64_t bits = rng();
+        unsigned height = 1;
+        while (height < max_height && (bits & 3) == 0) {
+            height++;
+            bits >>= 2;
+        }
+        return height;
+    }
+
+    template <class... Args>
+    Node* create(unsigned height, Args&&... args) {
+        void* block = ::operator new(sizeof(Node) + height * sizeof(Links*));
+        try {
+            return new (block) Node(height, std::forward<Args>(args)...);
+        }
+        catch (...) {
+            ::operator delete(block);
+            throw;
+        }
+    }
+
+    static void destroy(Links* links) noexcept {
+        Node* node = static_cast<Node*>(links);
+        node->~Node();
+        ::operator delete(node);
+    }
+
+    void reset() noexcept {
+        new (head_block) Links{ nullptr, max_height };
+        tower(head())[0] = head();
+        for (unsigned i = 1; i < max_height; i++) {
+            tower(head())[i] = nullptr;
+        }
+        head()->prev = head();
+        _height = 1;
+        _size = 0;
+    }
+
+    // Fills update[i] with the last node on level i whose key is less than key
+    Links* find_predecessors(const key_type& key, Links** update) {
+        Links* links = head();
+        const Links* stop = nullptr; // the node that ended the level above
+        for (unsigned i = _height; i-- > 0;) {
+            Links* next;
+            while ((next = tower(links)[i]) != stop && before(next, key)) {
+                links = next;
+            }
+            stop = next;
+            update[i] = links;
+        }
+        return tower(links)[0];
+    }
+
+    // The first node whose key is not less than key (or the head)
+    Links* first_not_before(const key_type& key) const {
+        const Links* links = head();
+        const Links* stop = nullptr;
+        for (unsigned i = _height; i-- > 0;) {
+            Links* next;
+            while ((next = tower(links)[i]) != stop && before(next, key)) {
+                links = next;
+            }
+            stop = next;
+        }
+        return tower(links)[0];
+    }
+
+    // The first node whose key is greater than key (or the head)
+    Links* first_after(const key_type& key) const {
+        const Links* links = head();
+        const Links* stop = nullptr;
+        for (unsigned i = _height; i-- > 0;) {
+            Links* next;
+            while ((next = tower(links)[i]) != stop && not_after(next, key)) {
+                links = next;
+            }
+            stop = next;
+        }
+        return tower(links)[0];
+    }
+
+    // Links node in after update[i] on each of its levels
+    void link(Node* node, Links** update) {
+        for (unsigned i = _height; i < node->height; i++) {
+            update[i] = head();
+        }
+        if (node->height > _height) {
+            _height = node->height;
+        }
+        for (unsigned i = 0; i < node->height; i++) {
+            tower(node)[i] = tower(update[i])[i];
+            tower(update[i])[i] = node;
+        }
+        node->prev = update[0];
+        tower(node)[0]->prev = node;
+        _size++;
+    }
+
+    void unlink(Links* target, Links** update) noexcept {
+        for (unsigned i = 0; i < target->height; i++) {
+            tower(update[i])[i] = tower(target)[i];
+        }
+        tower(target)[0]->prev = update[0];
+        destroy(target);
+        _size--;
+        while (_height > 1 && tower(head())[_height - 1] == nullptr) {
+            _height--;
+        }
+    }
+
+    template <class Value>
+    std::pair<iterator, bool> insert_unique(Value&& value) {
+        Links* update[max_height];
+        Links* found = find_predecessors(value.first, update);
+        if (found != head() && !comp(value.first, key_of(found))) {
+            return { iterator(found), false };
+        }
+        Node* node = create(random_height(), std::forward<Value>(value));
+        link(node, update);
+        return { iterator(node), true };
+    }
+
+    // Rebuilds other's nodes at the back, with the same tower heights
+    void append_copy(const SkipList& other) {
+        Links* last[max_height];
+        for (unsigned i = 0; i < max_height; i++) {
+            last[i] = head();
+        }
+        for (const Links* links = tower(other.head())[0]; links != other.head(); links = tower(links)[0]) {
+            Node* node = create(links->height, static_cast<const Node*>(links)->element);
+            link(node, last);
+            for (unsigned i = 0; i < node->height; i++) {
+                last[i] = node;
+            }
+        }
+    }
+
+    // Takes other's nodes; only the links that point at other's head move
+    void steal(SkipList& other) noexcept {
+        if (other._size == 0) {
+            return;
+        }
+        for (unsigned i = 0; i < max_height; i++) {
+            tower(head())[i] = tower(other.head())[i];
+        }
+        _height = other._height;
+        _size = other._size;
+        head()->prev = other.head()->prev;
+        tower(head())[0]->prev = head();
+        tower(head()->prev)[0] = head();
+        other.reset();
+    }
+
+public:
+    static constexpr uint64_t default_seed = 0x5ee1ab1e5eedULL;
+
+    SkipList() : comp(), rng(default_seed) { reset(); }
+
+    explicit SkipList(const key_compare& comp, uint64_t seed = default_seed) : comp(comp), rng(seed) { reset(); }
+
+    SkipList(const SkipList& other) : comp(other.comp), rng(other.rng) {
+        reset();
+        append_copy(other);
+    }
+
+    SkipList(SkipList&& other) noexcept : comp(std::move(other.comp)), rng(other.rng) {
+        reset();
+        steal(other);
+    }
+
+    ~SkipList() { clear(); }
+
+    SkipList& operator=(const SkipList& other) {
+        if (this != &other) {
+            clear();
+            comp = other.comp;
+            append_copy(other);
+        }
+        return *this;
+    }
+
+    SkipList& operator=(SkipList&& other) noexcept {
+        if (this != &other) {
+            clear();
+            comp = std::move(other.comp);
+            steal(other);
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(tower(head())[0]); }
+    const_iterator begin() const noexcept { return const_iterator(tower(head())[0]); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(head()); }
+    const_iterator end() const noexcept { return const_iterator(head()); }
+    const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+
+    // Levels in use: about log4(size), for sorted input too
+    size_type height() const noexcept { return _height; }
+
+    iterator find(const key_type& key) {
+        Links* links = first_not_before(key);
+        return iterator(links != head() && !comp(key, key_of(links)) ? links : head());
+    }
+    const_iterator find(const key_type& key) const {
+        return const_cast<SkipList*>(this)->find(key);
+    }
+
+    bool contains(const key_type& key) const { return find(key) != end(); }
+    size_type count(const key_type& key) const { return contains(key) ? 1 : 0; }
+
+    // The first element whose key is not less than key
+    iterator lower_bound(const key_type& key) { return iterator(first_not_before(key)); }
+    const_iterator lower_bound(const key_type& key) const { return const_iterator(first_not_before(key)); }
+
+    // The first element whose key is greater than key
+    iterator upper_bound(const key_type& key) { return iterator(first_after(key)); }
+    const_iterator upper_bound(const key_type& key) const { return const_iterator(first_after(key)); }
+
+    // Leaves an existing element with the same key alone, like std::map
+    std::pair<iterator, bool> insert(const value_type& value) { return insert_unique(value); }
+    std::pair<iterator, bool> insert(value_type&& value) { return insert_unique(std::move(value)); }
+
+    // Overwrites the value of an existing element with the same key
+    std::pair<iterator, bool> insert_or_assign(const key_type& key, const mapped_type& value) {
+        Links* update[max_height];
+        Links* found = find_predecessors(key, update);
+        if (found != head() && !comp(key, key_of(found))) {
+            static_cast<Node*>(found)->element.second = value;
+            return { iterator(found), false };
+        }
+        Node* node = create(random_height(), key, value);
+        link(node, update);
+        return { iterator(node), true };
+    }
+
+    mapped_type& operator[](const key_type& key) {
+        Links* update[max_height];
+        Links* found = find_predecessors(key, update);
+        if (found == head() || comp(key, key_of(found))) {
+            Node* node = create(random_height(), key, mapped_type());
+            link(node, update);
+            found = node;
+        }
+        return static_cast<Node*>(found)->element.second;
+    }
+
+    // Returns how many elements were erased (0 or 1)
+    size_type erase(const key_type& key) {
+        Links* update[max_height];
+        Links* found = find_predecessors(key, update);
+        if (found == head() || comp(key, key_of(found))) {
+            return 0;
+        }
+        unlink(found, update);
+        return 1;
+    }
+
+    // Erases the element at pos, returns an iterator to the one after it
+    iterator erase(const_iterator pos) {
+        Links* update[max_height];
+        Links* next = tower(pos.links)[0];
+        unlink(find_predecessors(key_of(pos.links), update), update);
+        return iterator(next);
+    }
+
+    // Erases [first, last), returns last
+    iterator erase(const_iterator first, const_iterator last) {
+        while (first != last) {
+            first = erase(first);
+        }
+        return iterator(last.links);
+    }
+
+    void clear() noexcept {
+        Links* links = tower(head())[0];
+        while (links != head()) {
+            Links* next = tower(links)[0];
+            destroy(links);
+            links = next;
+        }
+        reset();
+    }
+};
@@ -0,0 +1,110 @@
+#include <fstream>
+#include <map>
+#include <sstream>
+#include <string>
+#include "executable.h"
+
+using PooledTree = BinarySearchTree<int, int, std::less<int>, PooledNodes<16>>;
+
+TEST(node_pool_matches_map) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        PooledTree bst;
+        std::map<int, int> gt;
+
+        for(size_t op = 0; op < 300; op++) {
+            int key = t.range<int>(0, 100);
+            if(t.range<int>(0, 3) == 0) {
+                bst.erase(key);
+                gt.erase(key);
+            }
+            else {
+                int value = t.get<int>();
+                bst.insert({key, value});
+                gt[key] = value;
+            }
+        }
+
+        ASSERT_EQ(gt.size(), bst.size());
+        for(auto const & kv : gt) {
+            ASSERT_TRUE(bst.contains(kv.first));
+            ASSERT_EQ(kv.second, bst.find(kv.first));
+        }
+
+        PooledTree copy = bst;
+        PooledTree moved = std::move(bst);
+        ASSERT_TRUE(bst.empty());
+        ASSERT_EQ(gt.size(), copy.size());
+        ASSERT_EQ(gt.size(), moved.size());
+        if(!gt.empty()) {
+            ASSERT_EQ(gt.begin()->first, moved.min().first);
+            ASSERT_EQ(gt.rbegin()->first, copy.max().first);
+        }
+    }
+}
+
+TEST(node_pool_allocates_pages) {
+    Memhook mh;
+    PooledTree bst;
+    for(int i = 0; i < 40; i++) {
+        bst.insert({(i * 37) % 40, i});
+    }
+    // 40 nodes on pages of 16
+    ASSERT_EQ(3ULL, mh.n_allocs());
+
+    // churn reuses freed slots
+    for(int i = 0; i < 1000; i++) {
+        bst.erase(i % 40);
+        bst.insert({i % 40, i});
+    }
+    ASSERT_EQ(3ULL, mh.n_allocs());
+    ASSERT_EQ(0ULL, mh.n_frees());
+
+    // clear() of trivially destructible pairs frees whole pages
+    bst.clear();
+    ASSERT_EQ(3ULL, mh.n_frees());
+    ASSERT_TRUE(bst.empty());
+
+    // the printing helpers work with any policy
+    bst.insert({2, 20});
+    bst.insert({1, 10});
+    std::stringstream ss;
+    printLevelByLevel(bst, ss);
+    ASSERT_TRUE(ss.str() == "(2, 20) \n(1, 10) null \n");
+}
+
+TEST(node_pool_non_trivial_pairs) {
+    BinarySearchTree<std::string, std::string, std::less<std::string>, PooledNodes<4>> bst;
+    std::string long_string(100, 'x');
+    for(int i = 0; i < 20; i++) {
+        bst.insert({std::to_string(i), long_string});
+    }
+    bst.erase("5");
+    bst.erase("10");
+    ASSERT_EQ(18ULL, bst.size());
+    ASSERT_FALSE(bst.contains("5"));
+    ASSERT_TRUE(bst.find("7") == long_string);
+    bst.clear();
+    ASSERT_TRUE(bst.empty());
+}
+
+namespace {
+    // The contents of a file, empty if it can't be read
+    std::string read_file(const char* path) {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+}
+
+// NodePool.h is copied into list, binary_search_tree and unordered_map, so
+// a fix to one copy has to reach the others. Paths are relative to tests/.
+TEST(node_pool_header_matches_other_modules) {
+    const std::string mine = read_file("../src/NodePool.h");
+    ASSERT_FALSE(mine.empty());
+    for(const char* other : { "../../list/src/NodePool.h", "../../unordered_map/src/NodePool.h" }) {
+        ASSERT_TRUE(read_file(other) == mine);
+    }
+}
@@ -0,0 +1,131 @@
+#include <iterator>
+#include <map>
+#include <string>
+#include "executable.h"
+#include "SkipList.h"
+
+TEST(skip_list_matches_map) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        SkipList<int, std::string> sl;
+        std::map<int, std::string> gt;
+
+        for(size_t op = 0; op < 300; op++) {
+            int key = t.range<int>(0, 100);
+            int action = t.range<int>(0, 6);
+            if(action == 0) {
+                ASSERT_EQ(gt.erase(key), sl.erase(key));
+            }
+            else if(action == 1 && !gt.empty()) {
+                // erase by iterator, from lower_bound
+                auto it = sl.lower_bound(key);
+                auto gt_it = gt.lower_bound(key);
+                if(gt_it != gt.end()) {
+                    auto next = sl.erase(it);
+                    auto gt_next = gt.erase(gt_it);
+                    ASSERT_EQ(gt_next == gt.end(), next == sl.end());
+                    if(gt_next != gt.end()) {
+                        ASSERT_EQ(gt_next->first, next->first);
+                    }
+                }
+            }
+            else if(action == 2) {
+                std::string value = std::to_string(t.get<int>());
+                sl.insert_or_assign(key, value);
+                gt[key] = value;
+            }
+            else if(action == 3) {
+                sl[key] += "x";
+                gt[key] += "x";
+            }
+            else {
+                std::string value = std::to_string(t.get<int>());
+                bool inserted = sl.insert({key, value}).second;
+                ASSERT_EQ(gt.insert({key, value}).second, inserted);
+            }
+            ASSERT_EQ(gt.size(), sl.size());
+        }
+
+        // in order both ways
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), sl.begin(), sl.end()));
+        ASSERT_TRUE(std::equal(gt.rbegin(), gt.rend(), std::make_reverse_iterator(sl.end()), std::make_reverse_iterator(sl.begin())));
+
+        for(int key = -1; key <= 100; key++) {
+            ASSERT_EQ(gt.count(key), sl.count(key));
+            auto lb = sl.lower_bound(key);
+            auto ub = sl.upper_bound(key);
+            ASSERT_EQ(std::distance(gt.begin(), gt.lower_bound(key)), std::distance(sl.begin(), lb));
+            ASSERT_EQ(std::distance(gt.begin(), gt.upper_bound(key)), std::distance(sl.begin(), ub));
+            if(gt.count(key)) {
+                ASSERT_TRUE(gt.at(key) == sl.find(key)->second);
+            }
+            else {
+                ASSERT_TRUE(sl.find(key) == sl.end());
+            }
+        }
+
+        const SkipList<int, std::string> copy = sl;
+        SkipList<int, std::string> moved = std::move(sl);
+        ASSERT_TRUE(sl.empty());
+        ASSERT_TRUE(sl.begin() == sl.end());
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), copy.begin(), copy.end()));
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), moved.begin(), moved.end()));
+        if(!gt.empty()) {
+            ASSERT_EQ(gt.rbegin()->first, std::prev(moved.end())->first);
+        }
+
+        // the moved-from list is usable again
+        sl.insert({1, "one"});
+        ASSERT_EQ(1ULL, sl.size());
+        sl = copy;
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), sl.begin(), sl.end()));
+    }
+}
+
+TEST(skip_list_range_scan) {
+    SkipList<int, int> sl;
+    for(int key = 0; key < 1000; key += 2) {
+        sl.insert({key, key * 10});
+    }
+
+    // the keys in [101, 121): 102, 104, ..., 120
+    int expected = 102;
+    for(auto it = sl.lower_bound(101); it != sl.end() && it->first < 121; ++it) {
+        ASSERT_EQ(expected, it->first);
+        ASSERT_EQ(expected * 10, it->second);
+        expected += 2;
+    }
+    ASSERT_EQ(122, expected);
+
+    auto first = sl.lower_bound(100);
+    auto last = sl.upper_bound(200);
+    ASSERT_EQ(51, std::distance(first, last));
+    ASSERT_TRUE(sl.erase(first, last) == sl.upper_bound(200));
+    ASSERT_EQ(449ULL, sl.size());
+    ASSERT_FALSE(sl.contains(150));
+    ASSERT_TRUE(sl.lower_bound(100)->first == 202);
+    ASSERT_TRUE(sl.lower_bound(999) == sl.end());
+}
+
+TEST(skip_list_sorted_input_stays_shallow) {
+    Memhook mh;
+    {
+        SkipList<int, int> sl;
+        for(int key = 0; key < 10000; key++) {
+            sl.insert({key, key});
+        }
+        // log4(10000) is about 6.6
+        ASSERT_TRUE(sl.height() >= 4);
+        ASSERT_TRUE(sl.height() <= 14);
+        // one allocation per node, tower included
+        ASSERT_EQ(10000ULL, mh.n_allocs());
+
+        for(int key = 0; key < 10000; key += 2) {
+            ASSERT_EQ(1ULL, sl.erase(key));
+        }
+        ASSERT_EQ(5000ULL, sl.size());
+        ASSERT_EQ(1, sl.begin()->first);
+    }
+    ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+}
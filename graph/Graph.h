@@ -107,8 +107,10 @@ class VisitedSet {
 };
 
 //use bfs
+// Visited can be any type with VisitedSet's interface, e.g. BitVisitedSet from vector/src/BitVector.h
+template <class Visited = VisitedSet>
 void bfs(const Graph& graph, size_t start_vertex) {
-    VisitedSet visited(graph.num_vertices());
+    Visited visited(graph.num_vertices());
     std::queue<size_t> q;
 
     visited.process(start_vertex);
@@ -130,7 +132,8 @@ void bfs(const Graph& graph, size_t start_vertex) {
 }
 
 
-void dfs(const Graph& graph, size_t start_vertex, VisitedSet& visited) {
+template <class Visited>
+void dfs(const Graph& graph, size_t start_vertex, Visited& visited) {
     visited.process(start_vertex);
     std::cout << start_vertex << " ";
 
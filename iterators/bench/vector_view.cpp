@@ -0,0 +1,107 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <sys/mman.h> // mmap, munmap
+
+#include "Vector.h"
+#include "Vector_Basic.h"
+#include "VectorView.h"
+#include "bench.h"
+
+/*
+    Cost of wrapping an existing buffer so it can be walked with
+    Vector_Basic's iterators: copying it into a Vector_Basic against
+    a VectorView over it, then iterating either one.
+
+    USAGE: ./build/vector_view [elements]
+        elements defaults to 100M int32 (400 MB)
+
+    Vector_Basic's constructor copies, so it needs a second buffer of the
+    same size; that is 800 MB resident at the default size. The view is
+    also built over a Vector and over an anonymous mmap region, which
+    cost the same O(1).
+*/
+
+namespace {
+
+    template <typename Iter>
+    int64_t sum(Iter first, Iter last) {
+        int64_t s = 0;
+        for (; first != last; ++first) {
+            s += *first;
+        }
+        return s;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+
+    std::vector<int32_t> source(n);
+    for (size_t i = 0; i < n; i++) {
+        source[i] = static_cast<int32_t>(i % 1000);
+    }
+    std::cout << n << " int32 (" << n * sizeof(int32_t) / 1e6 << " MB)" << std::endl;
+
+    bench::header("wrap a std::vector");
+    int64_t copied_sum = 0;
+    double t_copy = 0, t_copied_iter = 0;
+    {
+        Vector_Basic<int32_t>* copy = nullptr;
+        t_copy = bench::seconds([&] { copy = new Vector_Basic<int32_t>(source); });
+        t_copied_iter = bench::seconds([&] { copied_sum = sum(copy->begin(), copy->end()); });
+        // Vector_Basic has no destructor, release its array by hand
+        delete[] &*copy->begin();
+        delete copy;
+    }
+    double t_view = bench::seconds_per_run([&] {
+        VectorView<int32_t> view(source);
+        bench::keep(view.data());
+    });
+    bench::report("Vector_Basic(std::vector) copy", t_copy * 1e3, "ms");
+    bench::report("VectorView(std::vector)", t_view * 1e9, "ns");
+
+    bench::header("iterate once");
+    VectorView<int32_t> view(source);
+    int64_t view_sum = 0;
+    double t_view_iter = bench::seconds([&] { view_sum = sum(view.begin(), view.end()); });
+    bench::report("Vector_Basic iterators (copy)", t_copied_iter * 1e3, "ms");
+    bench::report("VectorView iterators", t_view_iter * 1e3, "ms");
+    bench::report("wrap + iterate, copy", (t_copy + t_copied_iter) * 1e3, "ms");
+    bench::report("wrap + iterate, view", (t_view + t_view_iter) * 1e3, "ms");
+    bench::report("speedup", (t_copy + t_copied_iter) / (t_view + t_view_iter), "x");
+
+    bench::header("other sources");
+    {
+        Vector<int32_t> vec(1000);
+        double t = bench::seconds_per_run([&] {
+            VectorView<int32_t> v(vec);
+            bench::keep(v.data());
+        });
+        bench::report("VectorView(Vector)", t * 1e9, "ns");
+    }
+    {
+        const size_t bytes = n * sizeof(int32_t);
+        void* region = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+        if (region == MAP_FAILED) {
+            std::cerr << "mmap failed" << std::endl;
+            return 1;
+        }
+        VectorView<int32_t> mapped;
+        double t = bench::seconds_per_run([&] {
+            mapped = VectorView<int32_t>::from_bytes(region, bytes);
+            bench::keep(mapped.data());
+        });
+        bench::report("VectorView::from_bytes(mmap)", t * 1e9, "ns");
+        bench::report("mmap elements viewed", static_cast<double>(mapped.size()), "");
+        munmap(region, bytes);
+    }
+
+    if (copied_sum != view_sum) {
+        std::cerr << "copy and view disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,101 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "Vector.h"
+#include "views.h"
+#include "bench.h"
+
+/*
+    A 4-stage pipeline over a Vector<int>, run lazily with views and
+    eagerly by materializing a Vector after every stage:
+
+        filter(x % 3 == 0) -> transform(x * x) -> filter(x % 2 == 0) -> take(n / 8)
+
+    and the result summed.
+
+    USAGE: ./build/views [elements]
+        elements defaults to 10M
+
+    About 1 in 6 inputs passes both filters, so the take keeps roughly the
+    first three quarters of them: the lazy version stops early once it has
+    enough, the materialized one runs every stage over everything and pays
+    for the intermediate Vectors (allocation, growth copies and the extra
+    passes over memory).
+*/
+
+namespace {
+
+    bool multiple_of_3(int x) { return x % 3 == 0; }
+    int64_t square(int x) { return static_cast<int64_t>(x) * x; }
+    bool even(int64_t x) { return x % 2 == 0; }
+
+    int64_t lazy(Vector<int>& input, size_t limit) {
+        auto pipeline = input
+            | views::filter(multiple_of_3)
+            | views::transform(square)
+            | views::filter(even)
+            | views::take(limit);
+        int64_t sum = 0;
+        for (auto it = pipeline.begin(); it != pipeline.end(); ++it) {
+            sum += *it;
+        }
+        return sum;
+    }
+
+    int64_t materialized(Vector<int>& input, size_t limit) {
+        Vector<int> filtered;
+        for (auto it = input.begin(); it != input.end(); ++it) {
+            if (multiple_of_3(*it)) {
+                filtered.push_back(*it);
+            }
+        }
+        Vector<int64_t> squared;
+        for (auto it = filtered.begin(); it != filtered.end(); ++it) {
+            squared.push_back(square(*it));
+        }
+        Vector<int64_t> evens;
+        for (auto it = squared.begin(); it != squared.end(); ++it) {
+            if (even(*it)) {
+                evens.push_back(*it);
+            }
+        }
+        Vector<int64_t> taken;
+        for (auto it = evens.begin(); it != evens.end() && taken.size() < limit; ++it) {
+            taken.push_back(*it);
+        }
+        int64_t sum = 0;
+        for (auto it = taken.begin(); it != taken.end(); ++it) {
+            sum += *it;
+        }
+        return sum;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    const size_t limit = n / 8;
+
+    Vector<int> input;
+    uint32_t state = 12345;
+    for (size_t i = 0; i < n; i++) {
+        state = state * 1664525u + 1013904223u;
+        input.push_back(static_cast<int>(state >> 16));
+    }
+    std::cout << n << " ints, taking the first " << limit << " results" << std::endl;
+
+    int64_t lazy_sum = 0, eager_sum = 0;
+    double t_lazy = bench::seconds_per_run([&] { lazy_sum = lazy(input, limit); bench::keep(lazy_sum); }, 1.0);
+    double t_eager = bench::seconds_per_run([&] { eager_sum = materialized(input, limit); bench::keep(eager_sum); }, 1.0);
+
+    bench::header("filter -> transform -> filter -> take");
+    bench::report("materialized Vectors", t_eager * 1e3, "ms");
+    bench::report("lazy views", t_lazy * 1e3, "ms");
+    bench::report("speedup", t_eager / t_lazy, "x");
+
+    if (lazy_sum != eager_sum) {
+        std::cerr << "lazy and materialized results disagree" << std::endl;
+        return 1;
+    }
+    return 0;
+}
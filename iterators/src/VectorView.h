@@ -0,0 +1,104 @@
+#ifndef VECTOR_VIEW_H
+#define VECTOR_VIEW_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uintptr_t
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <type_traits> // std::enable_if_t, std::is_convertible
+#include <utility> // std::declval
+
+#include "Vector_Basic.h"
+
+/*
+    VectorView
+    ----------
+
+    A non-owning view of elements that live somewhere else. Building
+    a Vector_Basic from a std::vector allocates and copies every element;
+    a VectorView only remembers where they are, so wrapping a buffer of
+    any size is O(1) and never allocates:
+
+    std::vector<int> samples = load();
+    VectorView<int> view(samples);          // no copy
+    for (auto it = view.begin(); it != view.end(); ++it) { ... }
+
+    It can be built from
+    - any contiguous container with data() and size(): std::vector,
+      Vector, std::array, std::string ...
+    - a Vector_Basic
+    - a pointer and an element count
+    - a region of raw bytes such as an mmap'ed file, with from_bytes()
+
+    The iterator is Vector_Basic<T>::iterator, so code written against
+    Vector_Basic's iterators works on a view unchanged.
+
+    The view does not keep its elements alive: the container or mapping
+    must outlive it, and anything that reallocates the container (e.g. a
+    push_back past its capacity) leaves the view dangling. Changes made
+    through the view's iterators change the viewed elements.
+*/
+
+template <class T>
+class VectorView {
+public:
+    using iterator = typename Vector_Basic<T>::iterator;
+
+private:
+    T* ptr;
+    size_t count;
+
+    // Containers whose data() can be viewed as T*
+    template <class Container>
+    using if_contiguous = std::enable_if_t<
+        std::is_convertible<decltype(std::declval<Container&>().data()), T*>::value>;
+
+public:
+    VectorView() noexcept : ptr(nullptr), count(0) {}
+
+    VectorView(T* data, size_t count) noexcept : ptr(data), count(count) {}
+
+    // std::vector, Vector, std::array, ... (only lvalues: a temporary would dangle)
+    template <class Container, class = if_contiguous<Container>>
+    VectorView(Container& container) noexcept : ptr(container.data()), count(container.size()) {}
+
+    template <class Container, class = if_contiguous<Container>>
+    VectorView(Container&& container) = delete;
+
+    VectorView(Vector_Basic<T>& vec) noexcept : ptr(&*vec.begin()), count(vec.end() - vec.begin()) {}
+
+    // Views a region of raw bytes (e.g. from mmap) as elements of T. The
+    // region must be aligned for T; trailing bytes short of a whole
+    // element are not part of the view.
+    static VectorView from_bytes(void* region, size_t bytes) {
+        if (reinterpret_cast<uintptr_t>(region) % alignof(T) != 0) {
+            throw std::invalid_argument("region is not aligned for the element type");
+        }
+        return VectorView(static_cast<T*>(region), bytes / sizeof(T));
+    }
+
+    iterator begin() const noexcept { return iterator(ptr); }
+    iterator end() const noexcept { return iterator(ptr) + count; }
+
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+    size_t size() const noexcept { return count; }
+    T* data() const noexcept { return ptr; }
+
+    T& operator[](size_t pos) const noexcept { return ptr[pos]; }
+    T& at(size_t pos) const {
+        if (pos >= count) throw (std::out_of_range("index is out of range"));
+        return ptr[pos];
+    }
+
+    T& front() const { return ptr[0]; }
+    T& back() const { return ptr[count - 1]; }
+
+    // Views of part of the elements
+    VectorView subview(size_t offset, size_t length) const {
+        if (offset > count || length > count - offset) throw (std::out_of_range("subview is out of range"));
+        return VectorView(ptr + offset, length);
+    }
+    VectorView first(size_t length) const { return subview(0, length); }
+    VectorView last(size_t length) const { return subview(count - length, length); }
+};
+
+#endif
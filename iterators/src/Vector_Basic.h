@@ -3,6 +3,7 @@
 
 #include <vector>
 #include <cstddef> // size_t
+#include <type_traits> // std::true_type
 
 template <class T>
 class Vector_Basic {
@@ -44,6 +45,8 @@ public:
         using difference_type   = ptrdiff_t;
         using pointer           = T*;
         using reference         = T&;
+        // The elements are adjacent in memory (see sort::is_contiguous_iterator)
+        using is_contiguous     = std::true_type;
     private:
         // Add your own data members here
         pointer ptr;
@@ -0,0 +1,593 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::iterator_traits, iterator tags, std::distance
+#include <optional>
+#include <type_traits> // std::enable_if_t, std::is_base_of, std::decay_t, std::void_t
+#include <utility> // std::forward, std::move, std::pair
+
+/*
+    Lazy views
+    ----------
+
+    Composable views over anything with begin() and end(): Vector,
+    Vector_Basic, std::vector, arrays wrapped in a VectorView, or another
+    view. A view only stores iterators and the functions it applies; no
+    element is touched until the result is iterated, and a whole chain
+    runs as a single pass with no intermediate containers:
+
+    Vector<int> values = ...;
+    auto pipeline = values
+        | views::filter([](int x) { return x % 3 == 0; })
+        | views::transform([](int x) { return x * x; })
+        | views::drop(10)
+        | views::take(100);
+    for (auto it = pipeline.begin(); it != pipeline.end(); ++it) { ... }
+
+    Adaptors (use with |, or call them on a range: views::take(5)(values)):
+    - filter(pred)       elements for which pred is true
+    - transform(fn)      fn applied to each element, computed on access
+    - take(n), drop(n)   the first n / all but the first n elements
+    - stride(k)          every k-th element, starting with the first
+    - chunk(n)           consecutive sub-ranges of n elements (the last may
+                         be shorter). Over contiguous storage (Vector,
+                         Vector_Basic, pointers) every chunk has data() and
+                         size(), ready for a SIMD kernel.
+    - enumerate          (index, element) pairs
+    and views::zip(a, b) pairs up two ranges, stopping at the shorter one.
+
+    Views do not own elements: the containers must outlive the views built
+    on them, and growing a container invalidates views over it like it
+    invalidates iterators. That is also why a view can only be built on a
+    container that is a named object, not on a temporary.
+
+    Random access survives where it can: transform over a random access
+    range is random access, and take/drop over one are plain sub-ranges
+    (so they stay contiguous, too). filter, stride, chunk, zip and
+    enumerate produce forward iterators.
+*/
+
+namespace views {
+
+    // Marks types that are views, so they are copied into a pipeline
+    // instead of being referred to like containers
+    struct view_base {};
+
+    // Whether an iterator's elements are adjacent in memory: pointers, and
+    // iterators declaring  using is_contiguous = std::true_type;  as
+    // Vector's and Vector_Basic's do. Specialize it for other iterators.
+    template <class It, class = void>
+    struct is_contiguous : std::is_pointer<It> {};
+
+    template <class It>
+    struct is_contiguous<It, std::void_t<typename It::is_contiguous>> : It::is_contiguous {};
+
+    namespace detail {
+
+        template <class It>
+        constexpr bool is_random_access = std::is_base_of<std::random_access_iterator_tag,
+            typename std::iterator_traits<It>::iterator_category>::value;
+
+        // Advances it by n, but not past last
+        template <class It>
+        It next_bounded(It it, size_t n, It last) {
+            if constexpr (is_random_access<It>) {
+                const size_t left = static_cast<size_t>(last - it);
+                return it + static_cast<ptrdiff_t>(n < left ? n : left);
+            }
+            else {
+                for (; n > 0 && it != last; n--) {
+                    ++it;
+                }
+                return it;
+            }
+        }
+
+        // Holds a function object and stays assignable even when the
+        // function (e.g. a capturing lambda) is not, so iterators holding
+        // one can be assigned
+        template <class Fn>
+        class box {
+            std::optional<Fn> fn;
+
+        public:
+            box() = default;
+            explicit box(Fn f) : fn(std::move(f)) {}
+
+            box(const box&) = default;
+            box& operator=(const box& other) {
+                if (this != &other) {
+                    fn.reset();
+                    if (other.fn) {
+                        fn.emplace(*other.fn);
+                    }
+                }
+                return *this;
+            }
+
+            template <class... Args>
+            decltype(auto) operator()(Args&&... args) const {
+                return (*fn)(std::forward<Args>(args)...);
+            }
+        };
+    }
+
+    // A pair of iterators, the view every pipeline starts from
+    template <class It>
+    class Subrange : public view_base {
+        It first, last;
+
+    public:
+        using iterator = It;
+
+        Subrange() = default;
+        Subrange(It first, It last) : first(first), last(last) {}
+
+        It begin() const { return first; }
+        It end() const { return last; }
+
+        [[nodiscard]] bool empty() const { return first == last; }
+        size_t size() const { return static_cast<size_t>(std::distance(first, last)); }
+
+        decltype(auto) front() const { return *first; }
+        decltype(auto) operator[](size_t pos) const { return first[pos]; }
+
+        // Pointer to the first element, for handing contiguous storage to
+        // kernels that take a pointer and a length
+        template <class I = It, class = std::enable_if_t<is_contiguous<I>::value>>
+        auto data() const { return &*first; }
+    };
+
+    // Turns a range into a view: views are copied, containers are referred to
+    template <class Range>
+    auto all(Range&& range) {
+        using R = std::decay_t<Range>;
+        if constexpr (std::is_base_of<view_base, R>::value) {
+            return R(std::forward<Range>(range));
+        }
+        else {
+            static_assert(std::is_lvalue_reference<Range>::value,
+                "a view over a temporary container would dangle; name the container first");
+            return Subrange<decltype(range.begin())>(range.begin(), range.end());
+        }
+    }
+
+    template <class It, class Pred>
+    class FilterView : public view_base {
+        It first, last;
+        detail::box<Pred> pred;
+
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = typename std::iterator_traits<It>::value_type;
+            using difference_type   = ptrdiff_t;
+            using pointer           = typename std::iterator_traits<It>::pointer;
+            using reference         = typename std::iterator_traits<It>::reference;
+
+        private:
+            It cur, last;
+            detail::box<Pred> pred;
+
+            void satisfy() {
+                while (cur != last && !pred(*cur)) {
+                    ++cur;
+                }
+            }
+
+        public:
+            iterator() = default;
+            iterator(It cur, It last, const detail::box<Pred>& pred) : cur(cur), last(last), pred(pred) { satisfy(); }
+
+            [[nodiscard]] reference operator*() const { return *cur; }
+            [[nodiscard]] It base() const { return cur; }
+
+            iterator& operator++() {
+                ++cur;
+                satisfy();
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& rhs) const { return cur == rhs.cur; }
+            [[nodiscard]] bool operator!=(const iterator& rhs) const { return cur != rhs.cur; }
+        };
+
+        FilterView(It first, It last, Pred pred) : first(first), last(last), pred(std::move(pred)) {}
+
+        iterator begin() const { return iterator(first, last, pred); }
+        iterator end() const { return iterator(last, last, pred); }
+    };
+
+    template <class It, class Fn>
+    class TransformView : public view_base {
+        It first, last;
+        detail::box<Fn> fn;
+
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::conditional_t<detail::is_random_access<It>,
+                std::random_access_iterator_tag, std::forward_iterator_tag>;
+            using reference         = decltype(std::declval<const detail::box<Fn>&>()(*std::declval<It>()));
+            using value_type        = std::decay_t<reference>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = void;
+
+        private:
+            It cur;
+            detail::box<Fn> fn;
+
+        public:
+            iterator() = default;
+            iterator(It cur, const detail::box<Fn>& fn) : cur(cur), fn(fn) {}
+
+            [[nodiscard]] reference operator*() const { return fn(*cur); }
+            [[nodiscard]] reference operator[](difference_type offset) const { return fn(cur[offset]); }
+            [[nodiscard]] It base() const { return cur; }
+
+            iterator& operator++() {
+                ++cur;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++cur;
+                return temp;
+            }
+            iterator& operator--() {
+                --cur;
+                return *this;
+            }
+            iterator operator--(int) {
+                iterator temp = *this;
+                --cur;
+                return temp;
+            }
+
+            iterator& operator+=(difference_type offset) {
+                cur += offset;
+                return *this;
+            }
+            iterator& operator-=(difference_type offset) {
+                cur -= offset;
+                return *this;
+            }
+            [[nodiscard]] iterator operator+(difference_type offset) const { return iterator(cur + offset, fn); }
+            [[nodiscard]] friend iterator operator+(difference_type offset, const iterator& it) { return it + offset; }
+            [[nodiscard]] iterator operator-(difference_type offset) const { return iterator(cur - offset, fn); }
+            [[nodiscard]] difference_type operator-(const iterator& rhs) const { return cur - rhs.cur; }
+
+            [[nodiscard]] bool operator==(const iterator& rhs) const { return cur == rhs.cur; }
+            [[nodiscard]] bool operator!=(const iterator& rhs) const { return cur != rhs.cur; }
+            [[nodiscard]] bool operator<(const iterator& rhs) const { return cur < rhs.cur; }
+            [[nodiscard]] bool operator>(const iterator& rhs) const { return cur > rhs.cur; }
+            [[nodiscard]] bool operator<=(const iterator& rhs) const { return cur <= rhs.cur; }
+            [[nodiscard]] bool operator>=(const iterator& rhs) const { return cur >= rhs.cur; }
+        };
+
+        TransformView(It first, It last, Fn fn) : first(first), last(last), fn(std::move(fn)) {}
+
+        iterator begin() const { return iterator(first, fn); }
+        iterator end() const { return iterator(last, fn); }
+        size_t size() const { return static_cast<size_t>(std::distance(first, last)); }
+    };
+
+    // take() over a range without random access: counts the elements it hands out
+    template <class It>
+    class TakeView : public view_base {
+        It first, last;
+        size_t count;
+
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = typename std::iterator_traits<It>::value_type;
+            using difference_type   = ptrdiff_t;
+            using pointer           = typename std::iterator_traits<It>::pointer;
+            using reference         = typename std::iterator_traits<It>::reference;
+
+        private:
+            It cur;
+            size_t left;
+
+        public:
+            iterator() : cur(), left(0) {}
+            iterator(It cur, size_t left) : cur(cur), left(left) {}
+
+            [[nodiscard]] reference operator*() const { return *cur; }
+
+            iterator& operator++() {
+                ++cur;
+                --left;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            // Either n elements were taken or the underlying range ran out
+            [[nodiscard]] bool operator==(const iterator& rhs) const { return left == rhs.left || cur == rhs.cur; }
+            [[nodiscard]] bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+        };
+
+        TakeView(It first, It last, size_t count) : first(first), last(last), count(count) {}
+
+        iterator begin() const { return iterator(first, count); }
+        iterator end() const { return iterator(last, 0); }
+    };
+
+    template <class It>
+    class StrideView : public view_base {
+        It first, last;
+        size_t step;
+
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = typename std::iterator_traits<It>::value_type;
+            using difference_type   = ptrdiff_t;
+            using pointer           = typename std::iterator_traits<It>::pointer;
+            using reference         = typename std::iterator_traits<It>::reference;
+
+        private:
+            It cur, last;
+            size_t step;
+
+        public:
+            iterator() : cur(), last(), step(1) {}
+            iterator(It cur, It last, size_t step) : cur(cur), last(last), step(step) {}
+
+            [[nodiscard]] reference operator*() const { return *cur; }
+
+            iterator& operator++() {
+                cur = detail::next_bounded(cur, step, last);
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& rhs) const { return cur == rhs.cur; }
+            [[nodiscard]] bool operator!=(const iterator& rhs) const { return cur != rhs.cur; }
+        };
+
+        StrideView(It first, It last, size_t step) : first(first), last(last), step(step) {}
+
+        iterator begin() const { return iterator(first, last, step); }
+        iterator end() const { return iterator(last, last, step); }
+    };
+
+    template <class It>
+    class ChunkView : public view_base {
+        It first, last;
+        size_t length;
+
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using value_type        = Subrange<It>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = void;
+            using reference         = Subrange<It>;
+
+        private:
+            It cur, next, last;
+            size_t length;
+
+        public:
+            iterator() : cur(), next(), last(), length(1) {}
+            iterator(It cur, It last, size_t length)
+                : cur(cur), next(detail::next_bounded(cur, length, last)), last(last), length(length) {}
+
+            [[nodiscard]] reference operator*() const { return Subrange<It>(cur, next); }
+
+            iterator& operator++() {
+                cur = next;
+                next = detail::next_bounded(cur, length, last);
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& rhs) const { return cur == rhs.cur; }
+            [[nodiscard]] bool operator!=(const iterator& rhs) const { return cur != rhs.cur; }
+        };
+
+        ChunkView(It first, It last, size_t length) : first(first), last(last), length(length) {}
+
+        iterator begin() const { return iterator(first, last, length); }
+        iterator end() const { return iterator(last, last, length); }
+    };
+
+    template <class It>
+    class EnumerateView : public view_base {
+        It first, last;
+
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using reference         = std::pair<size_t, typename std::iterator_traits<It>::reference>;
+            using value_type        = std::pair<size_t, typename std::iterator_traits<It>::value_type>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = void;
+
+        private:
+            It cur;
+            size_t index;
+
+        public:
+            iterator() : cur(), index(0) {}
+            iterator(It cur, size_t index) : cur(cur), index(index) {}
+
+            [[nodiscard]] reference operator*() const { return reference(index, *cur); }
+
+            iterator& operator++() {
+                ++cur;
+                ++index;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            [[nodiscard]] bool operator==(const iterator& rhs) const { return cur == rhs.cur; }
+            [[nodiscard]] bool operator!=(const iterator& rhs) const { return cur != rhs.cur; }
+        };
+
+        EnumerateView(It first, It last) : first(first), last(last) {}
+
+        iterator begin() const { return iterator(first, 0); }
+        iterator end() const { return iterator(last, 0); }
+    };
+
+    template <class It1, class It2>
+    class ZipView : public view_base {
+        It1 first1, last1;
+        It2 first2, last2;
+
+    public:
+        class iterator {
+        public:
+            using iterator_category = std::forward_iterator_tag;
+            using reference         = std::pair<typename std::iterator_traits<It1>::reference,
+                                                typename std::iterator_traits<It2>::reference>;
+            using value_type        = std::pair<typename std::iterator_traits<It1>::value_type,
+                                                typename std::iterator_traits<It2>::value_type>;
+            using difference_type   = ptrdiff_t;
+            using pointer           = void;
+
+        private:
+            It1 cur1;
+            It2 cur2;
+
+        public:
+            iterator() = default;
+            iterator(It1 cur1, It2 cur2) : cur1(cur1), cur2(cur2) {}
+
+            [[nodiscard]] reference operator*() const { return reference(*cur1, *cur2); }
+
+            iterator& operator++() {
+                ++cur1;
+                ++cur2;
+                return *this;
+            }
+            iterator operator++(int) {
+                iterator temp = *this;
+                ++(*this);
+                return temp;
+            }
+
+            // Reaching the end of either range ends the zip
+            [[nodiscard]] bool operator==(const iterator& rhs) const { return cur1 == rhs.cur1 || cur2 == rhs.cur2; }
+            [[nodiscard]] bool operator!=(const iterator& rhs) const { return !(*this == rhs); }
+        };
+
+        ZipView(It1 first1, It1 last1, It2 first2, It2 last2)
+            : first1(first1), last1(last1), first2(first2), last2(last2) {}
+
+        iterator begin() const { return iterator(first1, first2); }
+        iterator end() const { return iterator(last1, last2); }
+    };
+
+    namespace detail {
+
+        // A view factory waiting for its range: range | adaptor or adaptor(range)
+        template <class Make>
+        struct adaptor {
+            Make make;
+
+            template <class Range>
+            auto operator()(Range&& range) const {
+                auto view = all(std::forward<Range>(range));
+                return make(view.begin(), view.end());
+            }
+        };
+
+        template <class Make>
+        adaptor<Make> make_adaptor(Make make) {
+            return adaptor<Make>{ std::move(make) };
+        }
+
+        template <class Range, class Make>
+        auto operator|(Range&& range, const adaptor<Make>& a) {
+            return a(std::forward<Range>(range));
+        }
+
+        struct enumerate_fn {
+            template <class It>
+            EnumerateView<It> operator()(It first, It last) const { return EnumerateView<It>(first, last); }
+        };
+    }
+
+    template <class Pred>
+    auto filter(Pred pred) {
+        return detail::make_adaptor([pred](auto first, auto last) {
+            return FilterView<decltype(first), Pred>(first, last, pred);
+        });
+    }
+
+    template <class Fn>
+    auto transform(Fn fn) {
+        return detail::make_adaptor([fn](auto first, auto last) {
+            return TransformView<decltype(first), Fn>(first, last, fn);
+        });
+    }
+
+    inline auto take(size_t count) {
+        return detail::make_adaptor([count](auto first, auto last) {
+            using It = decltype(first);
+            if constexpr (detail::is_random_access<It>) {
+                return Subrange<It>(first, detail::next_bounded(first, count, last));
+            }
+            else {
+                return TakeView<It>(first, last, count);
+            }
+        });
+    }
+
+    inline auto drop(size_t count) {
+        return detail::make_adaptor([count](auto first, auto last) {
+            return Subrange<decltype(first)>(detail::next_bounded(first, count, last), last);
+        });
+    }
+
+    inline auto stride(size_t step) {
+        return detail::make_adaptor([step](auto first, auto last) {
+            return StrideView<decltype(first)>(first, last, step > 0 ? step : 1);
+        });
+    }
+
+    inline auto chunk(size_t length) {
+        return detail::make_adaptor([length](auto first, auto last) {
+            return ChunkView<decltype(first)>(first, last, length > 0 ? length : 1);
+        });
+    }
+
+    inline constexpr detail::adaptor<detail::enumerate_fn> enumerate{};
+
+    template <class Range1, class Range2>
+    auto zip(Range1&& a, Range2&& b) {
+        auto va = all(std::forward<Range1>(a));
+        auto vb = all(std::forward<Range2>(b));
+        return ZipView<decltype(va.begin()), decltype(vb.begin())>(va.begin(), va.end(), vb.begin(), vb.end());
+    }
+}
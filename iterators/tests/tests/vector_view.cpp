@@ -0,0 +1,85 @@
+#include "executable.h"
+#include "VectorView.h"
+#include "../../../vector/src/Vector.h"
+
+#include <array>
+#include <vector>
+
+TEST(view_wraps_without_copying) {
+    Typegen t;
+
+    std::vector<int> gt(t.range<size_t>(1, 0xFFF));
+    for (size_t i = 0; i < gt.size(); i++) {
+        gt[i] = t.get<int>();
+    }
+    Vector<int> vec;
+    for (int x : gt) {
+        vec.push_back(x);
+    }
+
+    Memhook mh;
+    VectorView<int> from_std(gt);
+    VectorView<int> from_vector(vec);
+    VectorView<int> from_pointer(gt.data(), gt.size());
+    ASSERT_EQ(0UL, mh.n_allocs());
+
+    ASSERT_EQ(gt.size(), from_std.size());
+    ASSERT_EQ(gt.size(), from_vector.size());
+    ASSERT_EQ(gt.data(), from_std.data());
+    ASSERT_EQ(vec.data(), from_vector.data());
+
+    // same iterator type as Vector_Basic
+    Vector_Basic<int>::iterator it = from_pointer.begin();
+    size_t i = 0;
+    for (; it != from_pointer.end(); ++it, ++i) {
+        ASSERT_EQ(gt[i], *it);
+        ASSERT_EQ(vec[i], from_vector[i]);
+    }
+    ASSERT_EQ(gt.size(), i);
+    ASSERT_EQ(gt.back(), from_std.back());
+    ASSERT_EXCEPTION(from_std.at(gt.size()), std::out_of_range);
+}
+
+TEST(view_writes_through) {
+    std::array<int, 6> data = { 5, 4, 3, 2, 1, 0 };
+    VectorView<int> view(data);
+
+    for (auto it = view.begin(); it != view.end(); ++it) {
+        *it *= 10;
+    }
+    ASSERT_EQ(50, data[0]);
+    ASSERT_EQ(0, data[5]);
+
+    VectorView<int> middle = view.subview(1, 3);
+    ASSERT_EQ(3ULL, middle.size());
+    ASSERT_EQ(40, middle.front());
+    ASSERT_EQ(20, middle.back());
+    ASSERT_EQ(10, view.last(2).front());
+    ASSERT_EQ(40, view.first(2).back());
+    ASSERT_EXCEPTION(view.subview(4, 3), std::out_of_range);
+
+    const std::vector<int> constant = { 1, 2, 3 };
+    VectorView<const int> readonly(constant);
+    ASSERT_EQ(3ULL, readonly.size());
+    ASSERT_EQ(2, readonly[1]);
+}
+
+TEST(view_from_vector_basic_and_bytes) {
+    std::vector<int> gt = { 7, 8, 9 };
+    Vector_Basic<int> basic(gt);
+    VectorView<int> view(basic);
+    ASSERT_EQ(3ULL, view.size());
+    ASSERT_EQ(&*basic.begin(), view.data());
+
+    // raw bytes, as from mmap: a partial trailing element is left out
+    alignas(int) unsigned char region[4 * sizeof(int) + 2] = {};
+    VectorView<int> ints = VectorView<int>::from_bytes(region, sizeof(region));
+    ASSERT_EQ(4ULL, ints.size());
+    ints[3] = 42;
+    ASSERT_EQ(42, reinterpret_cast<int*>(region)[3]);
+    ASSERT_EXCEPTION(VectorView<int>::from_bytes(region + 1, 8), std::invalid_argument);
+
+    VectorView<int> empty;
+    ASSERT_TRUE(empty.empty());
+    ASSERT_TRUE(empty.begin() == empty.end());
+}
@@ -0,0 +1,138 @@
+#include "executable.h"
+#include "views.h"
+#include "VectorView.h"
+#include "../../../vector/src/Vector.h"
+
+#include <list>
+#include <vector>
+
+TEST(views_pipeline_matches_loops) {
+    Typegen t;
+
+    std::vector<int> gt(t.range<size_t>(0x100, 0xFFF));
+    for (size_t i = 0; i < gt.size(); i++) {
+        gt[i] = t.range<int>(-1000, 1000);
+    }
+    Vector<int> vec;
+    for (int x : gt) {
+        vec.push_back(x);
+    }
+
+    // what the pipeline should produce, computed with plain loops
+    std::vector<long> expected;
+    size_t seen = 0;
+    for (int x : gt) {
+        if (x % 3 == 0) {
+            if (seen++ >= 5 && expected.size() < 50) {
+                expected.push_back(static_cast<long>(x) * x);
+            }
+        }
+    }
+
+    Memhook mh;
+    auto pipeline = vec
+        | views::filter([](int x) { return x % 3 == 0; })
+        | views::transform([](int x) { return static_cast<long>(x) * x; })
+        | views::drop(5)
+        | views::take(50);
+
+    size_t i = 0;
+    for (auto it = pipeline.begin(); it != pipeline.end(); ++it, ++i) {
+        ASSERT_EQ(expected[i], *it);
+    }
+    ASSERT_EQ(expected.size(), i);
+    ASSERT_EQ(0UL, mh.n_allocs());
+}
+
+TEST(views_keep_random_access) {
+    std::vector<int> gt = { 1, 2, 3, 4, 5, 6, 7, 8, 9, 10 };
+    Vector_Basic<int> basic(gt);
+
+    auto squares = basic | views::transform([](int x) { return x * x; });
+    using Iter = decltype(squares.begin());
+    ASSERT_TRUE((std::is_same<std::iterator_traits<Iter>::iterator_category, std::random_access_iterator_tag>::value));
+    ASSERT_EQ(10L, squares.end() - squares.begin());
+    ASSERT_EQ(49, squares.begin()[6]);
+
+    // take/drop over random access are plain sub-ranges of the same iterators
+    auto middle = basic | views::drop(2) | views::take(5);
+    ASSERT_TRUE((std::is_same<decltype(middle.begin()), Vector_Basic<int>::iterator>::value));
+    ASSERT_EQ(5ULL, middle.size());
+    ASSERT_EQ(3, middle.front());
+    ASSERT_EQ(7, middle[4]);
+
+    // taking more than there is stops at the end
+    auto all = basic | views::take(100);
+    ASSERT_EQ(10ULL, all.size());
+    auto none = basic | views::drop(100);
+    ASSERT_TRUE(none.empty());
+
+    // writes go through to the container
+    for (auto it = middle.begin(); it != middle.end(); ++it) {
+        *it = 0;
+    }
+    ASSERT_EQ(2, *(basic.begin() + 1));
+    ASSERT_EQ(0, *(basic.begin() + 2));
+    ASSERT_EQ(8, *(basic.begin() + 7));
+}
+
+TEST(views_chunk_stride_enumerate_zip) {
+    std::vector<int> data(23);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<int>(i);
+    }
+    VectorView<int> view(data);
+
+    // chunks over contiguous storage expose data() and size()
+    size_t chunks = 0, total = 0;
+    for (auto it = (view | views::chunk(5)).begin(); it != (view | views::chunk(5)).end(); ++it, ++chunks) {
+        auto c = *it;
+        ASSERT_EQ(data.data() + chunks * 5, c.data());
+        ASSERT_EQ(chunks < 4 ? 5ULL : 3ULL, c.size());
+        total += c.size();
+    }
+    ASSERT_EQ(5ULL, chunks);
+    ASSERT_EQ(data.size(), total);
+
+    // Vector and Vector_Basic iterators are contiguous too
+    ASSERT_TRUE(views::is_contiguous<Vector<int>::iterator>::value);
+    ASSERT_TRUE(views::is_contiguous<Vector_Basic<int>::iterator>::value);
+    ASSERT_FALSE(views::is_contiguous<std::list<int>::iterator>::value);
+
+    int expected = 0;
+    auto every_fourth = view | views::stride(4);
+    for (auto it = every_fourth.begin(); it != every_fourth.end(); ++it, expected += 4) {
+        ASSERT_EQ(expected, *it);
+    }
+    ASSERT_EQ(24, expected);
+
+    std::vector<double> weights = { 0.5, 1.5, 2.5 };
+    size_t n = 0;
+    auto zipped = views::zip(data, weights);
+    for (auto it = zipped.begin(); it != zipped.end(); ++it, ++n) {
+        auto pair = *it;
+        ASSERT_EQ(static_cast<int>(n), pair.first);
+        ASSERT_EQ(weights[n], pair.second);
+        pair.first = -1; // references into data
+    }
+    ASSERT_EQ(3ULL, n);
+    ASSERT_EQ(-1, data[2]);
+    ASSERT_EQ(3, data[3]);
+
+    // views compose over non-random-access ranges too
+    std::list<int> linked = { 4, 8, 15, 16, 23, 42 };
+    auto odd = linked | views::filter([](int x) { return x % 2 == 1; }) | views::enumerate;
+    int odd_values[] = { 15, 23 };
+    size_t k = 0;
+    for (auto it = odd.begin(); it != odd.end(); ++it, ++k) {
+        ASSERT_EQ(k, (*it).first);
+        ASSERT_EQ(odd_values[k], (*it).second);
+    }
+    ASSERT_EQ(2ULL, k);
+
+    auto first_three = linked | views::stride(2) | views::take(2);
+    auto it = first_three.begin();
+    ASSERT_EQ(4, *it++);
+    ASSERT_EQ(15, *it++);
+    ASSERT_TRUE(it == first_three.end());
+}
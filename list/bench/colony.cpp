@@ -0,0 +1,129 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "Colony.h"
+#include "List.h"
+#include "Vector.h"
+#include "bench.h"
+
+/*
+    An entity pool under churn: every frame despawns a share of the
+    entities at random, spawns as many new ones, then updates every
+    entity once. Compared on Colony<Entity>, List<Entity> and
+    Vector<Entity>.
+
+    USAGE: ./build/colony [entities] [frames] [churn %]
+        defaults to 100000 entities, 200 frames and 10% churn
+
+    Colony and List keep an iterator per entity as its handle, and erase
+    through it. Vector has no stable handles: a despawn moves the last
+    entity into the hole (swap and pop), which is the cheapest a Vector
+    can do but moves entities that other code may be pointing at.
+*/
+
+namespace {
+
+    struct Entity {
+        float x, y, z;
+        float vx, vy, vz;
+        uint64_t id;
+        uint64_t state[4];
+    };
+
+    Entity spawn(uint64_t id) {
+        return Entity{ 0, 0, 0, 1, 2, 3, id, { id, 0, 0, 0 } };
+    }
+
+    uint64_t update(Entity& e) {
+        e.x += e.vx;
+        e.y += e.vy;
+        e.z += e.vz;
+        e.state[1]++;
+        return e.id;
+    }
+
+    struct Workload {
+        size_t entities, frames, churn;
+    };
+
+    // Colony or List: handles are iterators, despawn erases through one
+    template <class Container, class Insert>
+    double run_handles(const Workload& w, Insert insert) {
+        Container pool;
+        std::vector<typename Container::iterator> handles;
+        uint64_t next_id = 0;
+        for (size_t i = 0; i < w.entities; i++) {
+            handles.push_back(insert(pool, spawn(next_id++)));
+        }
+        std::mt19937_64 rng(42);
+        uint64_t sum = 0;
+        double t = bench::seconds([&] {
+            for (size_t frame = 0; frame < w.frames; frame++) {
+                for (size_t i = 0; i < w.churn; i++) {
+                    size_t victim = rng() % handles.size();
+                    pool.erase(handles[victim]);
+                    handles[victim] = handles.back();
+                    handles.pop_back();
+                }
+                for (size_t i = 0; i < w.churn; i++) {
+                    handles.push_back(insert(pool, spawn(next_id++)));
+                }
+                for (Entity& e : pool) {
+                    sum += update(e);
+                }
+            }
+        });
+        bench::keep(sum);
+        return t / w.frames * 1e3;
+    }
+
+    double run_vector(const Workload& w) {
+        Vector<Entity> pool;
+        uint64_t next_id = 0;
+        for (size_t i = 0; i < w.entities; i++) {
+            pool.push_back(spawn(next_id++));
+        }
+        std::mt19937_64 rng(42);
+        uint64_t sum = 0;
+        double t = bench::seconds([&] {
+            for (size_t frame = 0; frame < w.frames; frame++) {
+                for (size_t i = 0; i < w.churn; i++) {
+                    size_t victim = rng() % pool.size();
+                    pool[victim] = pool.back();
+                    pool.pop_back();
+                }
+                for (size_t i = 0; i < w.churn; i++) {
+                    pool.push_back(spawn(next_id++));
+                }
+                for (Entity& e : pool) {
+                    sum += update(e);
+                }
+            }
+        });
+        bench::keep(sum);
+        return t / w.frames * 1e3;
+    }
+}
+
+int main(int argc, char** argv) {
+    Workload w;
+    w.entities = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000;
+    w.frames = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+    size_t percent = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 10;
+    w.churn = w.entities * percent / 100;
+
+    bench::header(std::to_string(w.entities) + " entities of " + std::to_string(sizeof(Entity)) + " bytes, "
+                  + std::to_string(w.churn) + " despawned and spawned per frame");
+    double t_colony = run_handles<Colony<Entity>>(w, [](Colony<Entity>& pool, const Entity& e) { return pool.insert(e); });
+    double t_list = run_handles<List<Entity>>(w, [](List<Entity>& pool, const Entity& e) { return pool.insert(pool.end(), e); });
+    double t_vector = run_vector(w);
+    bench::report("Colony<Entity>", t_colony, "ms/frame");
+    bench::report("List<Entity>", t_list, "ms/frame");
+    bench::report("Vector<Entity> (swap and pop, unstable)", t_vector, "ms/frame");
+    bench::report("Colony speedup over List", t_list / t_colony, "x");
+    return 0;
+}
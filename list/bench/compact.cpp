@@ -0,0 +1,100 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "List.h"
+#include "bench.h"
+
+/*
+    Traversal of a List whose nodes have been scattered by random inserts
+    and erases, before and after List::compact(), for the default heap
+    nodes and for PooledNodes<>.
+
+    USAGE: ./build/compact [elements] [shuffles] [passes]
+        defaults to 1M elements, 4M erase/reinsert shuffles and 20 passes
+
+    The list is built in order, then every shuffle erases a random element
+    and reinserts its value before another random element, so the nodes
+    end up visited in random memory order. compact() moves them back into
+    traversal order. The last section runs the same compaction as
+    compact_step(4096) slices between traversals, the way a background
+    task would.
+*/
+
+namespace {
+
+    template <class ListType>
+    void shuffle(ListType& ll, size_t n, size_t shuffles) {
+        std::vector<typename ListType::iterator> its;
+        its.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            its.push_back(ll.insert(ll.end(), static_cast<int64_t>(i)));
+        }
+        std::mt19937_64 rng(42);
+        for (size_t op = 0; op < shuffles; op++) {
+            size_t a = rng() % n;
+            size_t b = rng() % n;
+            if (a == b) {
+                continue;
+            }
+            int64_t value = *its[a];
+            ll.erase(its[a]);
+            its[a] = ll.insert(its[b], value);
+        }
+    }
+
+    template <class ListType>
+    double traverse(const ListType& ll, size_t passes) {
+        int64_t sum = 0;
+        double t = bench::seconds([&] {
+            for (size_t pass = 0; pass < passes; pass++) {
+                for (int64_t value : ll) {
+                    sum += value;
+                }
+            }
+        });
+        bench::keep(sum);
+        return t / passes / ll.size() * 1e9;
+    }
+
+    template <class ListType>
+    void run(const std::string& name, size_t n, size_t shuffles, size_t passes) {
+        bench::header(name + ", " + std::to_string(n) + " elements");
+
+        ListType ll;
+        shuffle(ll, n, shuffles);
+        double before = traverse(ll, passes);
+        double t_compact = bench::seconds([&] { ll.compact(); });
+        double after = traverse(ll, passes);
+
+        bench::report("traverse, shuffled", before, "ns/element");
+        bench::report("compact()", t_compact / n * 1e9, "ns/element");
+        bench::report("traverse, compacted", after, "ns/element");
+        bench::report("speedup", before / after, "x");
+
+        ListType stepped;
+        shuffle(stepped, n, shuffles);
+        size_t slices = 0;
+        double t_steps = bench::seconds([&] {
+            while (!stepped.compact_step(4096)) {
+                slices++;
+            }
+        });
+        bench::report("compact_step(4096) slices", static_cast<double>(slices + 1), "");
+        bench::report("compact_step(4096), per slice", t_steps / (slices + 1) * 1e6, "us");
+        bench::report("traverse, after the slices", traverse(stepped, passes), "ns/element");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t shuffles = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 4000000;
+    size_t passes = argc > 3 ? std::strtoull(argv[3], nullptr, 10) : 20;
+
+    run<List<int64_t>>("List<int64_t>", n, shuffles, passes);
+    run<List<int64_t, PooledNodes<>>>("List<int64_t, PooledNodes<>>", n, shuffles, passes);
+    return 0;
+}
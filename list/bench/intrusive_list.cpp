@@ -0,0 +1,91 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "IntrusiveList.h"
+#include "List.h"
+#include "bench.h"
+
+/*
+    Queue churn over request objects that already live in a pool: a
+    List<Request> (one node allocation and one copy per push),
+    List<Request, PooledNodes<>>, a List<Request*> and an IntrusiveList
+    linking the requests themselves.
+
+    USAGE: ./build/intrusive_list [requests in flight] [operations]
+        defaults to 10000 requests in flight and 20M operations
+
+    Every operation takes the request at the front of the queue, touches
+    it, and queues the next request from the pool at the back, so the
+    queue keeps its depth.
+*/
+
+namespace {
+
+    struct Request {
+        uint64_t id;
+        uint64_t payload[6];
+        ListHook hook;
+    };
+
+    template <class Queue, class Push, class Front>
+    double churn(std::vector<Request>& pool, size_t depth, size_t ops, Push push, Front front) {
+        Queue queue;
+        for (size_t i = 0; i < depth; i++) {
+            push(queue, pool[i]);
+        }
+        size_t next = depth;
+        uint64_t sum = 0;
+
+        double t = bench::seconds([&] {
+            for (size_t op = 0; op < ops; op++) {
+                Request& request = front(queue);
+                sum += request.id + request.payload[0];
+                queue.pop_front();
+                push(queue, pool[next]);
+                next = next + 1 == pool.size() ? 0 : next + 1;
+            }
+        });
+        bench::keep(sum);
+        return t / ops;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t depth = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000;
+    size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000000;
+
+    // one more request than the queue holds, so the one being queued is never still in it
+    std::vector<Request> pool(depth + 1);
+    for (size_t i = 0; i < pool.size(); i++) {
+        pool[i].id = i;
+        pool[i].payload[0] = i * 3;
+    }
+
+    bench::header("queue churn, " + std::to_string(depth) + " requests of " + std::to_string(sizeof(Request)) + " bytes in flight");
+
+    double t_copy = churn<List<Request>>(pool, depth, ops,
+        [](List<Request>& q, Request& r) { q.push_back(r); },
+        [](List<Request>& q) -> Request& { return q.front(); });
+    bench::report("List<Request>", t_copy * 1e9, "ns/op");
+
+    double t_pooled = churn<List<Request, PooledNodes<>>>(pool, depth, ops,
+        [](List<Request, PooledNodes<>>& q, Request& r) { q.push_back(r); },
+        [](List<Request, PooledNodes<>>& q) -> Request& { return q.front(); });
+    bench::report("List<Request, PooledNodes<>>", t_pooled * 1e9, "ns/op");
+
+    double t_pointer = churn<List<Request*>>(pool, depth, ops,
+        [](List<Request*>& q, Request& r) { q.push_back(&r); },
+        [](List<Request*>& q) -> Request& { return *q.front(); });
+    bench::report("List<Request*>", t_pointer * 1e9, "ns/op");
+
+    using RequestQueue = IntrusiveList<Request, &Request::hook>;
+    double t_intrusive = churn<RequestQueue>(pool, depth, ops,
+        [](RequestQueue& q, Request& r) { q.push_back(r); },
+        [](RequestQueue& q) -> Request& { return q.front(); });
+    bench::report("IntrusiveList<Request, &Request::hook>", t_intrusive * 1e9, "ns/op");
+    bench::report("speedup over List<Request>", t_copy / t_intrusive, "x");
+    return 0;
+}
@@ -0,0 +1,153 @@
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "MpmcQueue.h"
+#include "Queue.h"
+#include "bench.h"
+
+/*
+    Producer/consumer throughput of MpmcQueue against a Queue<int> behind
+    a std::mutex with two std::condition_variables, bounded to the same
+    capacity, with the threads split evenly between producers and
+    consumers: 1 of each (2 threads) up to 16 of each (32 threads).
+
+    MpmcQueue is measured once an element at a time (push/pop) and once
+    in batches of 32 (push_range/pop_up_to).
+
+    USAGE: ./build/mpmc_queue [elements] [capacity]
+        defaults to 4M elements through a queue of 1024
+*/
+
+namespace {
+
+    // The textbook blocking queue: one lock, wait while full or empty
+    class LockedQueue {
+        Queue<int> queue;
+        size_t capacity;
+        std::mutex mutex;
+        std::condition_variable not_empty, not_full;
+
+    public:
+        explicit LockedQueue(size_t capacity) : capacity(capacity) {}
+
+        void push(int value) {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_full.wait(lock, [&] { return queue.size() < capacity; });
+            queue.push(value);
+            lock.unlock();
+            not_empty.notify_one();
+        }
+
+        int pop() {
+            std::unique_lock<std::mutex> lock(mutex);
+            not_empty.wait(lock, [&] { return !queue.empty(); });
+            int value = queue.front();
+            queue.pop();
+            lock.unlock();
+            not_full.notify_one();
+            return value;
+        }
+    };
+
+    // Runs pairs producers and pairs consumers, each moving elements / pairs elements
+    template <class Produce, class Consume>
+    double run_pairs(size_t pairs, size_t elements, Produce produce, Consume consume) {
+        size_t per_thread = elements / pairs;
+        std::vector<int64_t> sums(pairs, 0);
+        double t = bench::seconds([&] {
+            std::vector<std::thread> threads;
+            for (size_t p = 0; p < pairs; p++) {
+                threads.emplace_back([&, p] { sums[p] = consume(per_thread); });
+                threads.emplace_back([&] { produce(per_thread); });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+        });
+        for (int64_t sum : sums) {
+            bench::keep(sum);
+        }
+        return per_thread * pairs / t;
+    }
+
+    const size_t batch = 32;
+}
+
+int main(int argc, char** argv) {
+    size_t elements = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+    size_t capacity = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1024;
+
+    for (size_t pairs : { 1, 2, 4, 8, 16 }) {
+        bench::header(std::to_string(pairs) + " producers + " + std::to_string(pairs) + " consumers, capacity "
+                      + std::to_string(capacity) + ", " + std::to_string(std::thread::hardware_concurrency()) + " CPUs");
+
+        LockedQueue locked(capacity);
+        double t_locked = run_pairs(pairs, elements,
+            [&](size_t n) {
+                for (size_t i = 0; i < n; i++) {
+                    locked.push(static_cast<int>(i));
+                }
+            },
+            [&](size_t n) {
+                int64_t sum = 0;
+                for (size_t i = 0; i < n; i++) {
+                    sum += locked.pop();
+                }
+                return sum;
+            });
+        bench::report("mutex + condition_variable + Queue<int>", t_locked / 1e6, "M/s");
+
+        MpmcQueue<int> single(capacity);
+        double t_single = run_pairs(pairs, elements,
+            [&](size_t n) {
+                for (size_t i = 0; i < n; i++) {
+                    single.push(static_cast<int>(i));
+                }
+            },
+            [&](size_t n) {
+                int64_t sum = 0;
+                for (size_t i = 0; i < n; i++) {
+                    int value;
+                    single.pop(value);
+                    sum += value;
+                }
+                return sum;
+            });
+        bench::report("MpmcQueue<int>, push/pop", t_single / 1e6, "M/s");
+        bench::report("speedup over mutex", t_single / t_locked, "x");
+
+        MpmcQueue<int> batched(capacity);
+        double t_batched = run_pairs(pairs, elements,
+            [&](size_t n) {
+                int values[batch];
+                for (size_t i = 0; i < n; i += batch) {
+                    size_t count = n - i < batch ? n - i : batch;
+                    for (size_t k = 0; k < count; k++) {
+                        values[k] = static_cast<int>(i + k);
+                    }
+                    batched.push_range(values, values + count);
+                }
+            },
+            [&](size_t n) {
+                int64_t sum = 0;
+                int values[batch];
+                for (size_t i = 0; i < n;) {
+                    size_t got = batched.pop_up_to(values, n - i < batch ? n - i : batch);
+                    for (size_t k = 0; k < got; k++) {
+                        sum += values[k];
+                    }
+                    i += got;
+                }
+                return sum;
+            });
+        bench::report("MpmcQueue<int>, batches of 32", t_batched / 1e6, "M/s");
+        bench::report("speedup over mutex", t_batched / t_locked, "x");
+    }
+    return 0;
+}
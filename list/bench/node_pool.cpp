@@ -0,0 +1,84 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "List.h"
+#include "bench.h"
+
+/*
+    Insert/erase churn on a List with one new/delete per node (HeapNodes)
+    against one whose nodes come from a NodePool (PooledNodes<>).
+
+    USAGE: ./build/node_pool [nodes] [operations]
+        nodes defaults to 1M live elements, operations to 10M
+
+    The list is filled, then each operation erases the node at a random
+    position and inserts a new one before another random node, so the
+    list keeps its size while its nodes are recycled. After the churn
+    the list is walked front to back (the nodes are now in random heap
+    order) and finally cleared.
+*/
+
+namespace {
+
+    template <class ListType>
+    void run(const char* label, size_t n, size_t ops) {
+        std::mt19937_64 rng(42);
+        double t_fill = 0, t_churn = 0, t_walk = 0, t_clear = 0;
+        int64_t total = 0;
+        {
+            ListType list;
+            // handles[i] is an iterator to some live node
+            std::vector<typename ListType::iterator> handles;
+            handles.reserve(n);
+
+            t_fill = bench::seconds([&] {
+                for (size_t i = 0; i < n; i++) {
+                    list.push_back(static_cast<int>(i));
+                    handles.push_back(--list.end());
+                }
+            });
+
+            t_churn = bench::seconds([&] {
+                for (size_t op = 0; op < ops; op++) {
+                    size_t victim = rng() % n;
+                    list.erase(handles[victim]);
+                    size_t before = rng() % n;
+                    if (before == victim) {
+                        handles[victim] = list.insert(list.end(), static_cast<int>(op));
+                    }
+                    else {
+                        handles[victim] = list.insert(handles[before], static_cast<int>(op));
+                    }
+                }
+            });
+
+            t_walk = bench::seconds([&] {
+                for (auto it = list.begin(); it != list.end(); ++it) {
+                    total += *it;
+                }
+            });
+            bench::keep(total);
+
+            t_clear = bench::seconds([&] { list.clear(); });
+        }
+
+        std::cout << label << std::endl;
+        bench::report("  fill", t_fill * 1e3, "ms");
+        bench::report("  churn (erase + insert)", t_churn / ops * 1e9, "ns/op");
+        bench::report("  walk after churn", t_walk * 1e3, "ms");
+        bench::report("  clear", t_clear * 1e3, "ms");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 10000000;
+
+    bench::header("List<int> churn, " + std::to_string(n) + " nodes, " + std::to_string(ops) + " operations");
+    run<List<int>>("new/delete per node", n, ops);
+    run<List<int, PooledNodes<>>>("NodePool", n, ops);
+    return 0;
+}
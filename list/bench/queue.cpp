@@ -0,0 +1,55 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <string>
+
+#include "Queue.h"
+#include "bench.h"
+
+/*
+    Steady-state Queue throughput: the queue is filled to a fixed depth,
+    then every operation pops the front and pushes a new element, for
+    Queue<int> on List<int> (the default), on RingBuffer<int>, and
+    std::queue<int> (a std::deque) for reference.
+
+    USAGE: ./build/queue [operations]
+        operations defaults to 20M per depth
+*/
+
+namespace {
+
+    template <class Q>
+    double churn(size_t depth, size_t ops) {
+        Q queue;
+        for (size_t i = 0; i < depth; i++) {
+            queue.push(static_cast<int>(i));
+        }
+        int64_t sum = 0;
+        double t = bench::seconds([&] {
+            for (size_t op = 0; op < ops; op++) {
+                sum += queue.front();
+                queue.pop();
+                queue.push(static_cast<int>(op));
+            }
+        });
+        bench::keep(sum);
+        return t / ops;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t ops = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+
+    for (size_t depth : { 16, 1024, 100000 }) {
+        bench::header("push + pop, " + std::to_string(depth) + " elements queued");
+        double t_list = churn<Queue<int>>(depth, ops);
+        double t_ring = churn<Queue<int, RingBuffer<int>>>(depth, ops);
+        double t_deque = churn<std::queue<int>>(depth, ops);
+        bench::report("Queue<int, List<int>>", t_list * 1e9, "ns/op");
+        bench::report("Queue<int, RingBuffer<int>>", t_ring * 1e9, "ns/op");
+        bench::report("std::queue<int>", t_deque * 1e9, "ns/op");
+        bench::report("RingBuffer speedup over List", t_list / t_ring, "x");
+    }
+    return 0;
+}
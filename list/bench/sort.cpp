@@ -0,0 +1,137 @@
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "List.h"
+#include "bench.h"
+
+/*
+    List::sort, which relinks the nodes in place, against the old way of
+    sorting a List: copy the elements into a std::vector, std::sort it and
+    rebuild the list from it.
+
+    USAGE: ./build/sort [nodes] [input-files directory]
+        nodes defaults to 1M, the directory to ../../sorting/input-files
+
+    The 1M node inputs are generated: random, random with many duplicates,
+    ordered, reversed, and ordered with 1% of the elements swapped. The
+    assignment's input files (10k elements each) are sorted too.
+
+    Each run refills the list. With new/delete per node the heap hands the
+    nodes back in the order the previous run freed them, so after the
+    first sort they are scattered and every pass over the list misses the
+    cache; the PooledNodes runs show the sort with nodes in order.
+*/
+
+namespace {
+
+    std::vector<int> read_file(const std::string& path) {
+        std::ifstream file(path);
+        std::vector<int> data;
+        int value;
+        while (file >> value) {
+            data.push_back(value);
+        }
+        return data;
+    }
+
+    template <class ListType>
+    void fill(ListType& list, const std::vector<int>& input) {
+        list.clear();
+        for (int value : input) {
+            list.push_back(value);
+        }
+    }
+
+    template <class ListType>
+    void copy_sort_rebuild(ListType& list) {
+        std::vector<int> copy(list.begin(), list.end());
+        std::sort(copy.begin(), copy.end());
+        list.clear();
+        for (int value : copy) {
+            list.push_back(value);
+        }
+    }
+
+    // Fastest of a few runs of fn, each on a freshly filled list; only fn is timed
+    template <class ListType, typename Fn>
+    double best_of(ListType& list, const std::vector<int>& input, Fn&& fn) {
+        double best = 0;
+        for (int run = 0; run < 5; run++) {
+            fill(list, input);
+            double t = bench::seconds([&] { fn(); });
+            if (run == 0 || t < best) {
+                best = t;
+            }
+        }
+        return best;
+    }
+
+    template <class ListType>
+    void compare(const std::string& name, const std::vector<int>& input) {
+        ListType list;
+        double t_copy = best_of(list, input, [&] { copy_sort_rebuild(list); });
+        double t_relink = best_of(list, input, [&] { list.sort(); });
+
+        if (!std::is_sorted(list.begin(), list.end())) {
+            std::cerr << name << ": List::sort left the list unsorted" << std::endl;
+            std::exit(1);
+        }
+
+        std::cout << name << " (" << input.size() << " nodes)" << std::endl;
+        bench::report("  copy, std::sort, rebuild", t_copy * 1e3, "ms");
+        bench::report("  List::sort", t_relink * 1e3, "ms");
+        bench::report("  speedup", t_copy / t_relink, "x");
+    }
+
+    template <class ListType>
+    void run_all(const std::vector<int>& random, const std::vector<int>& dups, const std::vector<int>& ordered,
+                 const std::vector<int>& reversed, const std::vector<int>& nearly) {
+        compare<ListType>("random", random);
+        compare<ListType>("random, 100 distinct", dups);
+        compare<ListType>("ordered", ordered);
+        compare<ListType>("reversed", reversed);
+        compare<ListType>("ordered, 1% swapped", nearly);
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::string dir = argc > 2 ? argv[2] : "../../sorting/input-files";
+
+    std::mt19937 rng(42);
+    std::vector<int> random(n), dups(n), ordered(n), reversed(n), nearly(n);
+    for (size_t i = 0; i < n; i++) {
+        random[i] = static_cast<int>(rng());
+        dups[i] = static_cast<int>(rng() % 100);
+        ordered[i] = static_cast<int>(i);
+        reversed[i] = static_cast<int>(n - i);
+    }
+    nearly = ordered;
+    for (size_t i = 0; i < n / 100; i++) {
+        std::swap(nearly[rng() % n], nearly[rng() % n]);
+    }
+
+    bench::header("List<int> sort, " + std::to_string(n) + " nodes");
+    run_all<List<int>>(random, dups, ordered, reversed, nearly);
+
+    // the same with nodes in allocation order, without the heap's reuse
+    // order from the previous runs scattering them
+    bench::header("List<int, PooledNodes<>> sort, " + std::to_string(n) + " nodes");
+    run_all<List<int, PooledNodes<>>>(random, dups, ordered, reversed, nearly);
+
+    bench::header("List<int> sort, assignment input files");
+    for (const char* name : { "rand10k", "randdup10k", "ordered10k", "reverse10k" }) {
+        std::vector<int> input = read_file(dir + "/" + name + ".dat");
+        if (input.empty()) {
+            std::cerr << "could not read " << dir << "/" << name << ".dat" << std::endl;
+            return 1;
+        }
+        compare<List<int>>(name, input);
+    }
+    return 0;
+}
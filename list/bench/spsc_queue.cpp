@@ -0,0 +1,185 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "Queue.h"
+#include "SpscQueue.h"
+#include "bench.h"
+
+/*
+    SpscQueue between two threads, pinned to CPUs 0 and 1 where the
+    platform allows it:
+
+    - ping-pong: each side bounces one integer back through a second
+      queue, so every round trip is two hand-offs of a cache line; the
+      result is the one-way latency (half a round trip)
+    - throughput: the producer pushes as fast as the consumer pops, one
+      element at a time and in batches through push_n/pop_n, against a
+      Queue<int, RingBuffer<int>> behind a std::mutex
+
+    USAGE: ./build/spsc_queue [round trips] [elements]
+        defaults to 1M round trips and 20M elements
+
+    With a single CPU the two threads share it and take turns; the numbers
+    then measure the scheduler more than the queue, and the header says so.
+*/
+
+namespace {
+
+    // Pins the calling thread to one CPU, modulo the CPUs there are
+    void pin(unsigned cpu) {
+#ifdef __linux__
+        unsigned cpus = std::thread::hardware_concurrency();
+        cpu_set_t set;
+        CPU_ZERO(&set);
+        CPU_SET(cpus == 0 ? 0 : cpu % cpus, &set);
+        pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+        (void)cpu;
+#endif
+    }
+
+    // Waits for work without starving the other thread when they share a CPU
+    inline void relax() { std::this_thread::yield(); }
+
+    double ping_pong(size_t round_trips) {
+        SpscQueue<uint64_t> ping(64), pong(64);
+
+        std::thread echo([&] {
+            pin(1);
+            for (size_t i = 0; i < round_trips; i++) {
+                while (ping.empty()) {
+                    relax();
+                }
+                uint64_t value = ping.front();
+                ping.pop();
+                pong.push(value + 1);
+            }
+        });
+
+        pin(0);
+        uint64_t sum = 0;
+        double t = bench::seconds([&] {
+            for (size_t i = 0; i < round_trips; i++) {
+                ping.push(i);
+                while (pong.empty()) {
+                    relax();
+                }
+                sum += pong.front();
+                pong.pop();
+            }
+        });
+        echo.join();
+        bench::keep(sum);
+        return t / round_trips / 2;
+    }
+
+    double spsc_throughput(size_t elements, size_t batch) {
+        SpscQueue<int> queue(4096);
+        int64_t sum = 0;
+
+        double t = bench::seconds([&] {
+            std::thread consumer([&] {
+                pin(1);
+                int out[256];
+                size_t received = 0;
+                while (received < elements) {
+                    size_t n = batch == 1 ? (queue.try_pop(out[0]) ? 1 : 0) : queue.pop_n(out, batch);
+                    for (size_t k = 0; k < n; k++) {
+                        sum += out[k];
+                    }
+                    received += n;
+                    if (n == 0) {
+                        relax();
+                    }
+                }
+            });
+
+            pin(0);
+            int in[256];
+            size_t sent = 0;
+            while (sent < elements) {
+                size_t n = batch < elements - sent ? batch : elements - sent;
+                for (size_t k = 0; k < n; k++) {
+                    in[k] = static_cast<int>(sent + k);
+                }
+                size_t pushed = n == 1 ? (queue.try_push(in[0]) ? 1 : 0) : queue.push_n(in, n);
+                sent += pushed;
+                if (pushed == 0) {
+                    relax();
+                }
+            }
+            consumer.join();
+        });
+        bench::keep(sum);
+        return elements / t;
+    }
+
+    double locked_throughput(size_t elements) {
+        Queue<int, RingBuffer<int>> queue;
+        std::mutex mutex;
+        int64_t sum = 0;
+
+        double t = bench::seconds([&] {
+            std::thread consumer([&] {
+                pin(1);
+                size_t received = 0;
+                while (received < elements) {
+                    bool got = false;
+                    {
+                        std::lock_guard<std::mutex> lock(mutex);
+                        if (!queue.empty()) {
+                            sum += queue.front();
+                            queue.pop();
+                            got = true;
+                        }
+                    }
+                    if (got) {
+                        received++;
+                    }
+                    else {
+                        relax();
+                    }
+                }
+            });
+
+            pin(0);
+            for (size_t i = 0; i < elements; i++) {
+                std::lock_guard<std::mutex> lock(mutex);
+                queue.push(static_cast<int>(i));
+            }
+            consumer.join();
+        });
+        bench::keep(sum);
+        return elements / t;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t round_trips = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t elements = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000000;
+
+    unsigned cpus = std::thread::hardware_concurrency();
+    std::string where = cpus >= 2 ? "threads pinned to CPUs 0 and 1" : "one CPU, threads take turns";
+
+    bench::header("ping-pong latency, " + where);
+    bench::report("SpscQueue<uint64_t>, one way", ping_pong(round_trips) * 1e9, "ns");
+
+    bench::header("throughput, " + std::to_string(elements) + " ints, " + where);
+    double locked = locked_throughput(elements);
+    bench::report("mutex + Queue<int, RingBuffer<int>>", locked / 1e6, "M/s");
+    for (size_t batch : { 1, 16, 256 }) {
+        double spsc = spsc_throughput(elements, batch);
+        bench::report("SpscQueue<int>, batch " + std::to_string(batch), spsc / 1e6, "M/s");
+        bench::report("speedup over mutex", spsc / locked, "x");
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+
+#include "List.h"
+#include "UnrolledList.h"
+#include "bench.h"
+
+/*
+    UnrolledList<int> against List<int>: a full traversal, and inserts
+    and erases at random positions.
+
+    USAGE: ./build/unrolled_list [elements] [operations]
+        elements defaults to 10M, operations to 1M
+
+    Random positions are reached with a cursor that walks forward a random
+    0 to 63 elements (wrapping at the end) before each insert or erase,
+    so both containers pay for the walk and the edit at an iterator; a
+    jump to a truly random index would be an O(n) walk for either one.
+    Each operation is an insert or an erase with equal odds, so the size
+    stays about the same.
+*/
+
+namespace {
+
+    template <class ListType>
+    void run(const std::string& label, size_t n, size_t ops) {
+        std::mt19937_64 rng(42);
+        double t_fill = 0, t_walk = 0, t_edit = 0, t_walk_after = 0;
+        int64_t total = 0;
+
+        ListType list;
+        t_fill = bench::seconds([&] {
+            for (size_t i = 0; i < n; i++) {
+                list.push_back(static_cast<int>(i));
+            }
+        });
+
+        auto walk = [&] {
+            for (auto it = list.begin(); it != list.end(); ++it) {
+                total += *it;
+            }
+        };
+        t_walk = bench::seconds(walk);
+
+        t_edit = bench::seconds([&] {
+            auto cursor = list.begin();
+            for (size_t op = 0; op < ops; op++) {
+                for (uint64_t step = rng() % 64; step > 0; step--) {
+                    if (++cursor == list.end()) {
+                        cursor = list.begin();
+                    }
+                }
+                if (rng() % 2 == 0) {
+                    cursor = list.insert(cursor, static_cast<int>(op));
+                }
+                else {
+                    cursor = list.erase(cursor);
+                    if (cursor == list.end()) {
+                        cursor = list.begin();
+                    }
+                }
+            }
+        });
+
+        t_walk_after = bench::seconds(walk);
+        bench::keep(total);
+
+        std::cout << label << std::endl;
+        bench::report("  fill (push_back)", t_fill * 1e3, "ms");
+        bench::report("  traversal", t_walk * 1e3, "ms");
+        bench::report("  random insert/erase", t_edit / ops * 1e9, "ns/op");
+        bench::report("  traversal after the edits", t_walk_after * 1e3, "ms");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t ops = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 1000000;
+
+    bench::header("List<int> vs UnrolledList<int>, " + std::to_string(n) + " elements");
+    run<List<int>>("List<int>", n, ops);
+    run<UnrolledList<int>>("UnrolledList<int> (" + std::to_string(UnrolledList<int>::block_capacity) + " per block)", n, ops);
+    run<UnrolledList<int, 4>>("UnrolledList<int, 4>", n, ops);
+    return 0;
+}
@@ -0,0 +1,433 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstdint> // uint16_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <new> // placement new
+#include <type_traits> // std::enable_if_t, std::is_same
+#include <utility> // std::move, std::forward
+
+/*
+    Colony
+    ------
+
+    An unordered container for objects that come and go all the time
+    (entities, connections, particles) and have to stay where they are:
+
+    - elements live in blocks of BlockSize slots, and are never moved, so
+      pointers, references and iterators stay valid until their element is
+      erased
+    - erase leaves a hole; insert fills a hole before it takes a new slot,
+      so the memory of a steady population is reused, not reallocated
+    - iteration walks each block front to back, jumping over the holes
+
+    Each block keeps a skip field, one counter per slot: 0 for a live
+    element, and for a run of erased slots the length of the run at both
+    its ends (the "low complexity jump-counting" skip field):
+
+        slots  A  .  .  .  B  C  .  D
+        skip   0  3  ?  3  0  0  1  0
+
+    ++ from A reads the 3 after it and lands on B; -- from B reads the 3
+    before it and lands on A. Both are O(1) whatever the length of the run,
+    and erasing an element only has to rewrite the two ends of the merged
+    run. The slots inside a run hold a doubly linked list of the runs in
+    their block, which is where insert finds a hole; the blocks that have
+    holes are chained together as well. A block whose last element is
+    erased is freed.
+
+    Insert places the element wherever there is room, so the order of
+    iteration is not the order of insertion.
+*/
+
+template <class T, size_t BlockSize = 64>
+class Colony {
+    static_assert(BlockSize > 1 && BlockSize < 0xffff, "the skip field counts slots in 16 bits");
+
+    using skip_type = uint16_t;
+    static constexpr skip_type none = 0xffff;
+
+    // Links of the run of erased slots starting at a slot, kept in the slot
+    struct FreeLinks {
+        skip_type prev, next;
+    };
+
+    struct alignas(alignof(T) > alignof(FreeLinks) ? alignof(T) : alignof(FreeLinks)) Slot {
+        unsigned char bytes[sizeof(T) > sizeof(FreeLinks) ? sizeof(T) : sizeof(FreeLinks)];
+    };
+
+    struct Block {
+        Block *prev = nullptr, *next = nullptr;           // every block, in iteration order
+        Block *prev_free = nullptr, *next_free = nullptr; // the blocks with holes
+        size_t count = 0;                                 // live elements
+        size_t top = 0;                                   // slots used so far, the rest are fresh
+        skip_type free_head = none;                       // first run of erased slots
+        skip_type skip[BlockSize + 1] = {};               // skip[BlockSize] stays 0
+        Slot slots[BlockSize];
+
+        T* element(size_t pos) noexcept { return reinterpret_cast<T*>(slots + pos); }
+        FreeLinks& links(size_t pos) noexcept { return *reinterpret_cast<FreeLinks*>(slots + pos); }
+    };
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+
+    private:
+        friend class Colony;
+
+        Block* block; // nullptr only for end() of an empty colony
+        size_t pos;   // slot in the block; the last block's top for end()
+
+        basic_iterator(Block* block, size_t pos) noexcept : block(block), pos(pos) {}
+
+    public:
+        basic_iterator() noexcept : block(nullptr), pos(0) {}
+
+        // iterator converts to const_iterator
+        template <typename P, typename R,
+                  typename = std::enable_if_t<!std::is_same<P, pointer_type>::value && std::is_same<pointer_type, const T*>::value>>
+        basic_iterator(const basic_iterator<P, R>& other) noexcept : block(other.block), pos(other.pos) {}
+
+        reference operator*() const { return *block->element(pos); }
+        pointer operator->() const { return block->element(pos); }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            pos++;
+            pos += block->skip[pos];
+            if (pos == block->top && block->next != nullptr) {
+                // blocks before the last are full, so this is a live element
+                block = block->next;
+                pos = block->skip[0];
+            }
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            for (;;) {
+                if (pos == 0) {
+                    block = block->prev;
+                    pos = block->top;
+                }
+                pos--;
+                if (block->skip[pos] == 0) {
+                    return *this;
+                }
+                // the end of a run: go to its start, then to the slot before it
+                pos -= block->skip[pos] - 1;
+            }
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator temp(*this);
+            --*this;
+            return temp;
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept {
+            return block == other.block && pos == other.pos;
+        }
+        bool operator!=(const basic_iterator& other) const noexcept {
+            return !(*this == other);
+        }
+
+        template <typename, typename>
+        friend class basic_iterator;
+    };
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+    static constexpr size_type block_size = BlockSize;
+
+private:
+    Block *first = nullptr, *last = nullptr;
+    Block* with_holes = nullptr;
+    size_type _size = 0;
+    size_type _blocks = 0;
+
+    // Unlinks a run start from its block's list of runs
+    static void unlink_run(Block* block, size_t start) noexcept {
+        FreeLinks& links = block->links(start);
+        if (links.prev != none) {
+            block->links(links.prev).next = links.next;
+        }
+        else {
+            block->free_head = links.next;
+        }
+        if (links.next != none) {
+            block->links(links.next).prev = links.prev;
+        }
+    }
+
+    // Puts the run starting at start in place of the one starting at old,
+    // or at the front of the list if old is none
+    static void relink_run(Block* block, size_t start, size_t old) noexcept {
+        FreeLinks links{ none, block->free_head };
+        if (old != none) {
+            links = block->links(old);
+        }
+        new (block->slots + start) FreeLinks(links);
+        if (links.prev != none) {
+            block->links(links.prev).next = static_cast<skip_type>(start);
+        }
+        else {
+            block->free_head = static_cast<skip_type>(start);
+        }
+        if (links.next != none) {
+            block->links(links.next).prev = static_cast<skip_type>(start);
+        }
+    }
+
+    void add_holes(Block* block) noexcept {
+        block->prev_free = nullptr;
+        block->next_free = with_holes;
+        if (with_holes != nullptr) {
+            with_holes->prev_free = block;
+        }
+        with_holes = block;
+    }
+
+    void remove_holes(Block* block) noexcept {
+        if (block->prev_free != nullptr) {
+            block->prev_free->next_free = block->next_free;
+        }
+        else {
+            with_holes = block->next_free;
+        }
+        if (block->next_free != nullptr) {
+            block->next_free->prev_free = block->prev_free;
+        }
+    }
+
+    Block* add_block() {
+        Block* block = new Block;
+        block->prev = last;
+        if (last != nullptr) {
+            last->next = block;
+        }
+        else {
+            first = block;
+        }
+        last = block;
+        _blocks++;
+        return block;
+    }
+
+    void remove_block(Block* block) noexcept {
+        (block->prev != nullptr ? block->prev->next : first) = block->next;
+        (block->next != nullptr ? block->next->prev : last) = block->prev;
+        delete block;
+        _blocks--;
+    }
+
+    // A slot for a new element: the first hole of a block with holes, or
+    // the next fresh slot at the end
+    iterator claim() {
+        if (with_holes != nullptr) {
+            Block* block = with_holes;
+            size_t start = block->free_head;
+            size_t length = block->skip[start];
+            if (length > 1) {
+                // the run now starts one slot later
+                relink_run(block, start + 1, start);
+                block->skip[start + 1] = block->skip[start + length - 1] = static_cast<skip_type>(length - 1);
+            }
+            else {
+                unlink_run(block, start);
+            }
+            block->skip[start] = 0;
+            if (block->free_head == none) {
+                remove_holes(block);
+            }
+            return iterator(block, start);
+        }
+        Block* block = last;
+        if (block == nullptr || block->top == BlockSize) {
+            block = add_block();
+        }
+        return iterator(block, block->top);
+    }
+
+    // Hands a claimed slot back if constructing the element threw
+    void unclaim(iterator where) noexcept {
+        Block* block = where.block;
+        if (where.pos == block->top) {
+            if (block->count == 0) {
+                remove_block(block);
+            }
+            return;
+        }
+        free_slot(block, where.pos);
+    }
+
+    // Marks a slot erased, merging it with the runs on either side
+    void free_slot(Block* block, size_t pos) noexcept {
+        size_t left = pos > 0 ? block->skip[pos - 1] : 0;
+        size_t right = block->skip[pos + 1];
+        size_t length = left + 1 + right;
+        size_t start = pos - left;
+
+        if (block->free_head == none) {
+            add_holes(block);
+        }
+        if (left == 0) {
+            // a new start: take the place of the run on the right, if any
+            relink_run(block, pos, right != 0 ? pos + 1 : none);
+        }
+        else if (right != 0) {
+            // the left run absorbs the right one
+            unlink_run(block, pos + 1);
+        }
+        block->skip[pos] = 1;
+        block->skip[start] = block->skip[start + length - 1] = static_cast<skip_type>(length);
+    }
+
+    template <class... Args>
+    iterator emplace_impl(Args&&... args) {
+        iterator where = claim();
+        try {
+            new (where.block->element(where.pos)) T(std::forward<Args>(args)...);
+        }
+        catch (...) {
+            unclaim(where);
+            throw;
+        }
+        Block* block = where.block;
+        if (where.pos == block->top) {
+            block->top++;
+        }
+        block->count++;
+        _size++;
+        return where;
+    }
+
+    void destroy_all() noexcept {
+        for (iterator it = begin(); it != end(); ++it) {
+            it->~T();
+        }
+        while (first != nullptr) {
+            Block* next = first->next;
+            delete first;
+            first = next;
+        }
+        last = with_holes = nullptr;
+        _size = _blocks = 0;
+    }
+
+    void steal(Colony& other) noexcept {
+        first = other.first;
+        last = other.last;
+        with_holes = other.with_holes;
+        _size = other._size;
+        _blocks = other._blocks;
+        other.first = other.last = other.with_holes = nullptr;
+        other._size = other._blocks = 0;
+    }
+
+public:
+    Colony() noexcept = default;
+
+    Colony(const Colony& other) {
+        try {
+            for (const T& value : other) {
+                insert(value);
+            }
+        }
+        catch (...) {
+            destroy_all();
+            throw;
+        }
+    }
+
+    Colony(Colony&& other) noexcept {
+        steal(other);
+    }
+
+    ~Colony() {
+        destroy_all();
+    }
+
+    Colony& operator=(const Colony& other) {
+        if (this != &other) {
+            Colony copy(other);
+            destroy_all();
+            steal(copy);
+        }
+        return *this;
+    }
+
+    Colony& operator=(Colony&& other) noexcept {
+        if (this != &other) {
+            destroy_all();
+            steal(other);
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return first != nullptr ? iterator(first, first->skip[0]) : iterator(); }
+    const_iterator begin() const noexcept { return const_cast<Colony*>(this)->begin(); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return last != nullptr ? iterator(last, last->top) : iterator(); }
+    const_iterator end() const noexcept { return const_cast<Colony*>(this)->end(); }
+    const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+
+    // Blocks allocated, each of block_size slots
+    size_type block_count() const noexcept { return _blocks; }
+
+    void clear() noexcept { destroy_all(); }
+
+    // Stores the element in the first hole, or after the last element if
+    // there is none; no other element moves. O(1)
+    iterator insert(const T& value) { return emplace_impl(value); }
+    iterator insert(T&& value) { return emplace_impl(std::move(value)); }
+
+    template <class... Args>
+    iterator emplace(Args&&... args) { return emplace_impl(std::forward<Args>(args)...); }
+
+    // Returns an iterator to the element after the erased one. O(1)
+    iterator erase(const_iterator where) noexcept {
+        Block* block = where.block;
+        size_t pos = where.pos;
+        iterator next(block, pos);
+        ++next;
+
+        block->element(pos)->~T();
+        _size--;
+        if (--block->count == 0) {
+            // the block goes; next is in the block after it, or is end()
+            if (block->free_head != none) {
+                remove_holes(block);
+            }
+            bool was_last = block == last;
+            remove_block(block);
+            return was_last ? end() : next;
+        }
+        free_slot(block, pos);
+        return next;
+    }
+};
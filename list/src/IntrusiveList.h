@@ -0,0 +1,321 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <stdexcept> // std::invalid_argument
+#include <type_traits> // std::is_same, std::enable_if_t
+#include <utility> // std::move
+
+/*
+    IntrusiveList
+    -------------
+
+    A doubly linked list of objects that carry their own links. Where
+    List<T> allocates a node per element and copies or moves the element
+    into it, an IntrusiveList links the objects themselves, wherever they
+    already live (a pool, a vector, the stack):
+
+    struct Request {
+        int id;
+        ListHook hook;
+    };
+
+    Request requests[100];
+    IntrusiveList<Request, &Request::hook> queue;
+    queue.push_back(requests[7]);     // no allocation, no copy
+    queue.remove(requests[7]);        // O(1), given only the object
+
+    The list does not own its elements. Erasing or clearing only unlinks
+    them, and an object must outlive its time in the list unless its hook
+    is an AutoUnlinkHook, which unlinks the object when it is destroyed.
+    An auto-unlinking object can leave the list without the list knowing,
+    so those lists do not keep a count: their size() walks the list.
+
+    Like List, the list has head and tail sentinels, so linking and
+    unlinking never test for an empty list. A hook that is not in a list
+    has null links; putting an object that is already in a list into
+    another one throws std::invalid_argument. Copying an object gives the
+    copy an unlinked hook.
+
+    An object can be in as many lists at once as it has hooks.
+*/
+
+template <bool AutoUnlink>
+class IntrusiveHook {
+    template <class T, auto Hook>
+    friend class IntrusiveList;
+
+    IntrusiveHook *next, *prev;
+
+    void unlink_links() noexcept {
+        prev->next = next;
+        next->prev = prev;
+        next = nullptr;
+        prev = nullptr;
+    }
+
+public:
+    static constexpr bool auto_unlink = AutoUnlink;
+
+    IntrusiveHook() noexcept : next(nullptr), prev(nullptr) {}
+
+    // a copy of an object is not in its lists
+    IntrusiveHook(const IntrusiveHook&) noexcept : IntrusiveHook() {}
+    IntrusiveHook& operator=(const IntrusiveHook&) noexcept { return *this; }
+
+    ~IntrusiveHook() {
+        if (AutoUnlink && is_linked()) {
+            unlink_links();
+        }
+    }
+
+    bool is_linked() const noexcept { return next != nullptr; }
+};
+
+using ListHook = IntrusiveHook<false>;
+using AutoUnlinkHook = IntrusiveHook<true>;
+
+namespace intrusive_detail {
+    template <class Member>
+    struct member_pointer;
+
+    template <class Class, class Member>
+    struct member_pointer<Member Class::*> {
+        using class_type = Class;
+        using member_type = Member;
+    };
+}
+
+// Hook is a pointer to the IntrusiveHook member of T that this list uses
+template <class T, auto Hook>
+class IntrusiveList {
+    using hook_type = typename intrusive_detail::member_pointer<decltype(Hook)>::member_type;
+    static_assert(std::is_same<typename intrusive_detail::member_pointer<decltype(Hook)>::class_type, T>::value,
+                  "Hook must be a member of T");
+    static_assert(std::is_same<hook_type, ListHook>::value || std::is_same<hook_type, AutoUnlinkHook>::value,
+                  "Hook must be a ListHook or an AutoUnlinkHook");
+
+    static constexpr bool counted = !hook_type::auto_unlink;
+
+    static hook_type* hook_of(T& value) noexcept { return &(value.*Hook); }
+
+    // The object a hook is a member of
+    static T* owner_of(hook_type* hook) noexcept {
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - hook_offset());
+    }
+
+    static ptrdiff_t hook_offset() noexcept {
+        alignas(T) static char probe[sizeof(T)];
+        T* object = reinterpret_cast<T*>(probe);
+        return reinterpret_cast<char*>(&(object->*Hook)) - probe;
+    }
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+
+    private:
+        friend class IntrusiveList;
+
+        hook_type* hook;
+
+        explicit basic_iterator(hook_type* hook) noexcept : hook(hook) {}
+
+    public:
+        basic_iterator() noexcept : hook(nullptr) {}
+
+        // iterator converts to const_iterator
+        template <typename P, typename R,
+                  typename = std::enable_if_t<!std::is_same<P, pointer_type>::value && std::is_same<pointer_type, const T*>::value>>
+        basic_iterator(const basic_iterator<P, R>& other) noexcept : hook(other.hook) {}
+
+        reference operator*() const { return *owner_of(hook); }
+        pointer operator->() const { return owner_of(hook); }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            hook = hook->next;
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator temp(*this);
+            hook = hook->next;
+            return temp;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            hook = hook->prev;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator temp(*this);
+            hook = hook->prev;
+            return temp;
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept {
+            return hook == other.hook;
+        }
+        bool operator!=(const basic_iterator& other) const noexcept {
+            return hook != other.hook;
+        }
+
+        template <typename, typename>
+        friend class basic_iterator;
+    };
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+private:
+    hook_type head, tail;
+    size_type _size;
+
+    void link_before(hook_type* pos, T& value) {
+        hook_type* hook = hook_of(value);
+        if (hook->is_linked()) {
+            throw std::invalid_argument("element is already in a list");
+        }
+        hook->next = pos;
+        hook->prev = pos->prev;
+        pos->prev->next = hook;
+        pos->prev = hook;
+        if (counted) {
+            _size++;
+        }
+    }
+
+    void unlink(hook_type* hook) noexcept {
+        hook->unlink_links();
+        if (counted) {
+            _size--;
+        }
+    }
+
+public:
+    IntrusiveList() noexcept : _size(0) {
+        head.next = &tail;
+        tail.prev = &head;
+    }
+
+    // The elements stay where they are; only one list can link them
+    IntrusiveList(const IntrusiveList&) = delete;
+    IntrusiveList& operator=(const IntrusiveList&) = delete;
+
+    IntrusiveList(IntrusiveList&& other) noexcept : IntrusiveList() {
+        *this = std::move(other);
+    }
+
+    IntrusiveList& operator=(IntrusiveList&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        clear();
+        if (other.head.next == &other.tail) {
+            return *this;
+        }
+
+        // the first and last elements point at the sentinels, the rest stay
+        head.next = other.head.next;
+        tail.prev = other.tail.prev;
+        head.next->prev = &head;
+        tail.prev->next = &tail;
+        _size = other._size;
+
+        other.head.next = &other.tail;
+        other.tail.prev = &other.head;
+        other._size = 0;
+        return *this;
+    }
+
+    // Unlinks every element
+    ~IntrusiveList() {
+        clear();
+        // the sentinels are hooks too, and must not unlink themselves
+        head.next = nullptr;
+        tail.prev = nullptr;
+    }
+
+    iterator begin() noexcept { return iterator(head.next); }
+    const_iterator begin() const noexcept { return const_iterator(head.next); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(&tail); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<hook_type*>(&tail)); }
+    const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return head.next == &tail; }
+
+    // O(1), or O(n) for AutoUnlinkHook lists
+    size_type size() const noexcept {
+        if (counted) {
+            return _size;
+        }
+        size_type count = 0;
+        for (const hook_type* hook = head.next; hook != &tail; hook = hook->next) {
+            count++;
+        }
+        return count;
+    }
+
+    reference front() { return *owner_of(head.next); }
+    const_reference front() const { return *owner_of(head.next); }
+    reference back() { return *owner_of(tail.prev); }
+    const_reference back() const { return *owner_of(tail.prev); }
+
+    void push_back(T& value) { link_before(&tail, value); }
+    void push_front(T& value) { link_before(head.next, value); }
+
+    void pop_back() { unlink(tail.prev); }
+    void pop_front() { unlink(head.next); }
+
+    // Links value in before pos and returns an iterator to it
+    iterator insert(const_iterator pos, T& value) {
+        link_before(pos.hook, value);
+        return iterator(hook_of(value));
+    }
+
+    // Unlinks the element at pos, returns an iterator to the one after it
+    iterator erase(const_iterator pos) noexcept {
+        hook_type* next = pos.hook->next;
+        unlink(pos.hook);
+        return iterator(next);
+    }
+
+    // Unlinks value, which must be in this list, O(1)
+    void remove(T& value) noexcept { unlink(hook_of(value)); }
+
+    // The iterator to value, which must be in this list, O(1)
+    iterator iterator_to(T& value) noexcept { return iterator(hook_of(value)); }
+    const_iterator iterator_to(const T& value) const noexcept {
+        return const_iterator(const_cast<hook_type*>(&(value.*Hook)));
+    }
+
+    void clear() noexcept {
+        hook_type* hook = head.next;
+        while (hook != &tail) {
+            hook_type* next = hook->next;
+            hook->next = nullptr;
+            hook->prev = nullptr;
+            hook = next;
+        }
+        head.next = &tail;
+        tail.prev = &head;
+        _size = 0;
+    }
+};
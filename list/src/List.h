@@ -1,10 +1,16 @@
 #pragma once
 
 #include <cstddef> // size_t
-#include <iterator> // std::bidirectional_iterator_tag
-#include <type_traits> // std::is_same, std::enable_if
+#include <functional> // std::less, std::equal_to
+#include <iterator> // std::bidirectional_iterator_tag, std::next
+#include <memory> // std::unique_ptr
+#include <type_traits> // std::is_same, std::enable_if, std::is_trivially_destructible
 
-template <class T>
+#include "NodePool.h"
+
+// NodeAlloc decides where the nodes live: HeapNodes (one new/delete per
+// node) or PooledNodes<> (slab pages owned by the list), see NodePool.h
+template <class T, class NodeAlloc = HeapNodes>
 class List {
     private:
     struct Node {
@@ -26,9 +32,10 @@ class List {
         using difference_type   = ptrdiff_t;
         using pointer           = pointer_type;
         using reference         = reference_type;
+        using list_type         = List;
     private:
-        friend class List<value_type>;
-        using Node = typename List<value_type>::Node;
+        friend class List;
+        using Node = typename List::Node;
 
         Node* node;
 
@@ -93,8 +100,24 @@ public:
     using const_iterator  = basic_iterator<const_pointer, const_reference>;
 
 private:
+    using node_pool = typename NodeAlloc::template pool<Node>;
+
     Node head, tail;
     size_type _size;
+    node_pool nodes;
+
+    // While compact_step is part way through the list: the pool of the
+    // nodes not moved yet, the next node to move, and the moved-from nodes
+    // (chained by next), which are freed when the compaction ends
+    struct Compaction {
+        node_pool retired;
+        Node* cursor = nullptr;
+        Node* graveyard = nullptr;
+    };
+
+    // Allocated by compact_step and freed when the compaction ends, so a
+    // list that is not being compacted carries only this pointer
+    std::unique_ptr<Compaction> compaction;
 
 public:
 
@@ -114,7 +137,7 @@ public:
 
         for (size_t i = 0; i < count; i++)
         {
-            Node *t= new Node(T(value));
+            Node *t= nodes.create(T(value));
             //set the current node's next to the new node
             curr->next = t;
             //will link the new node to the previous one
@@ -138,7 +161,7 @@ public:
         //loops through and adds each node use template T
         for (size_t i = 0; i < count; i++)
         {
-            Node *t= new Node(T());
+            Node *t= nodes.create(T());
 
             t->prev = curr;
             curr->next = t;
@@ -160,7 +183,7 @@ public:
     Node* other_curr = other.head.next;
     //loop through and set each node accordingly
     for (size_t i = 0; i < other._size; i++) {
-        Node* t = new Node(other_curr->data);
+        Node* t = nodes.create(other_curr->data);
 
         t->prev = curr;
         curr->next = t;
@@ -176,7 +199,7 @@ public:
 
     }
 
-    List( List&& other ) {
+    List( List&& other ) : nodes(take_nodes(other)) {
         //checks if empty, if it is then will return empty, else will steal the contents of other
         if (other.empty()) {
             head.next = &tail;
@@ -220,7 +243,7 @@ public:
         //loop through and set each node accordingly
         for (size_t i = 0; i < other._size; i++)
         {
-            Node *t = new Node(curr_other->data);
+            Node *t = nodes.create(curr_other->data);
             curr->next = t;
             t->prev = curr;
             curr = t;
@@ -245,6 +268,12 @@ public:
 
         //clear the current list
         clear();
+        //the nodes' memory comes along with them
+        nodes = take_nodes(other);
+
+        if (other.empty()) {
+            return *this;
+        }
 
         //set the first nodes
         head.next = other.head.next;
@@ -315,29 +344,35 @@ public:
     }
 
     void clear() noexcept {
-        //same as destructor
-        Node* prev = head.next;
-        Node* curr = head.next;
-
-        while (curr != &tail) {
-            curr = curr->next;
-            delete prev;
-            prev = curr;
+        stop_compaction();
+        if (node_pool::bulk_release && std::is_trivially_destructible<T>::value) {
+            //nothing to destroy, hand back the pool's pages at once
+            nodes.release();
+        }
+        else {
+            //same as destructor
+            Node* prev = head.next;
+            Node* curr = head.next;
+
+            while (curr != &tail) {
+                curr = curr->next;
+                nodes.destroy(prev);
+                prev = curr;
+            }
         }
 
         head.next = &tail;
         tail.prev = &head;
-        prev = nullptr;
-        curr = nullptr;
         _size = 0;
 
     }
 
     //point to node you just inserted
     iterator insert( const_iterator pos, const T& value ) {
+        stop_compaction();
 
         //new node created
-        Node* newNode = new Node(value, pos.node->prev, pos.node);
+        Node* newNode = nodes.create(value, pos.node->prev, pos.node);
 
         //current node
         Node* curr = pos.node;
@@ -355,8 +390,9 @@ public:
     }
 
     iterator insert( const_iterator pos, T&& value ) {
+        stop_compaction();
         //create a new node that is linked in the list
-        Node* newNode = new Node(std::move(value), pos.node->prev, pos.node);
+        Node* newNode = nodes.create(std::move(value), pos.node->prev, pos.node);
         
 
         //current node
@@ -375,6 +411,7 @@ public:
 
     //point to node after the one you just deleted
     iterator erase( const_iterator pos ) {
+        stop_compaction();
 
         Node* n = pos.node; //pointer to the node to be deleted
 
@@ -389,7 +426,7 @@ public:
         //break the links and delete node
         n->next = nullptr;
         n->prev = nullptr;
-        delete n;
+        nodes.destroy(n);
 
         _size--;
 
@@ -419,6 +456,383 @@ public:
         erase(iterator(head.next));
     }
 
+    /*
+    Relinking operations
+
+    These move nodes instead of copying elements: nothing is allocated or
+    freed, and iterators to the moved elements stay valid (they now refer
+    into this list).
+
+    With a policy that is not transferable (PooledNodes), a node can only
+    change lists together with its pool. Splicing a whole list and merge
+    adopt the other list's pool; splicing part of another list moves the
+    elements into new nodes of this list instead, which invalidates
+    iterators to them.
+    */
+
+    // Moves every element of other before pos, O(1)
+    void splice( const_iterator pos, List& other ) {
+        if (this == &other || other.empty()) {
+            return;
+        }
+        stop_compaction();
+        other.stop_compaction();
+        nodes.adopt(other.nodes);
+        link_before(pos.node, other.head.next, other.tail.prev);
+        _size += other._size;
+        other.unlink_all();
+    }
+    void splice( const_iterator pos, List&& other ) {
+        splice(pos, other);
+    }
+
+    // Moves the element at it, from this list or another, before pos
+    void splice( const_iterator pos, List& other, const_iterator it ) {
+        splice(pos, other, it, std::next(it));
+    }
+    void splice( const_iterator pos, List&& other, const_iterator it ) {
+        splice(pos, other, it);
+    }
+
+    // Moves [first, last), from this list or another, before pos. pos must
+    // not be inside the range. O(1) within one list, O(distance) from
+    // another, to keep both sizes.
+    void splice( const_iterator pos, List& other, const_iterator first, const_iterator last ) {
+        if (first == last || pos.node == first.node || pos.node == last.node) {
+            return;
+        }
+        stop_compaction();
+        other.stop_compaction();
+        if (this != &other) {
+            if (!node_pool::transferable) {
+                while (first != last) {
+                    insert(pos, std::move(first.node->data));
+                    first = const_iterator(other.erase(first).node);
+                }
+                return;
+            }
+            size_type count = 0;
+            for (const_iterator it = first; it != last; ++it) {
+                count++;
+            }
+            _size += count;
+            other._size -= count;
+        }
+        Node* back = last.node->prev;
+        unlink(first.node, back);
+        link_before(pos.node, first.node, back);
+    }
+    void splice( const_iterator pos, List&& other, const_iterator first, const_iterator last ) {
+        splice(pos, other, first, last);
+    }
+
+    // Merges the sorted other into this sorted list; equal elements from
+    // this list stay ahead of other's. other is left empty. O(n + m), no
+    // allocation.
+    void merge( List& other ) {
+        merge(other, std::less<T>());
+    }
+    void merge( List&& other ) {
+        merge(other, std::less<T>());
+    }
+
+    template <class Compare>
+    void merge( List& other, Compare comp ) {
+        if (this == &other || other.empty()) {
+            return;
+        }
+        stop_compaction();
+        other.stop_compaction();
+        nodes.adopt(other.nodes);
+
+        // unhook both chains from their sentinels and merge the next links
+        tail.prev->next = nullptr;
+        other.tail.prev->next = nullptr;
+        Node* merged = merge_chains(empty() ? nullptr : head.next, other.head.next, comp);
+        _size += other._size;
+        other.unlink_all();
+        relink(merged);
+    }
+    template <class Compare>
+    void merge( List&& other, Compare comp ) {
+        merge(other, comp);
+    }
+
+    // Stable sort that only relinks nodes: O(n log r) for r natural runs,
+    // so sorted and reverse sorted lists take one pass. No allocation.
+    void sort() {
+        sort(std::less<T>());
+    }
+
+    template <class Compare>
+    void sort( Compare comp ) {
+        if (_size < 2) {
+            return;
+        }
+        stop_compaction();
+        tail.prev->next = nullptr;
+        Node* rest = head.next;
+
+        // bins[i] holds the merge of 2^i runs, a binary counter of runs
+        constexpr size_t max_bins = 64;
+        Node* bins[max_bins] = {};
+        size_t used = 0;
+
+        while (rest != nullptr) {
+            Node* run = take_run(rest, comp);
+            size_t i = 0;
+            for (; i < used && bins[i] != nullptr; i++) {
+                run = merge_chains(bins[i], run, comp); // bins[i] holds the earlier elements
+                bins[i] = nullptr;
+            }
+            if (i == max_bins) {
+                i--;
+            }
+            bins[i] = run;
+            if (i == used) {
+                used++;
+            }
+        }
+
+        Node* sorted = nullptr;
+        for (size_t i = 0; i < used; i++) {
+            if (bins[i] != nullptr) {
+                sorted = sorted == nullptr ? bins[i] : merge_chains(bins[i], sorted, comp);
+            }
+        }
+        relink(sorted);
+    }
+
+    // Erases every element equal to the one before it, returns how many
+    size_type unique() {
+        return unique(std::equal_to<T>());
+    }
+
+    template <class BinaryPredicate>
+    size_type unique( BinaryPredicate same ) {
+        size_type removed = 0;
+        if (_size < 2) {
+            return removed;
+        }
+        Node* kept = head.next;
+        while (kept->next != &tail) {
+            if (same(kept->data, kept->next->data)) {
+                erase(const_iterator(kept->next));
+                removed++;
+            }
+            else {
+                kept = kept->next;
+            }
+        }
+        return removed;
+    }
+
+    /*
+    Compaction
+
+    Churn leaves the nodes of a long-lived list scattered over the heap,
+    and walking it then misses the cache on nearly every node. compact()
+    moves the elements, front to back, into newly allocated nodes, so that
+    a traversal reads memory in order again.
+
+    With PooledNodes the new nodes fill fresh pages one after another and
+    the old pages are freed at the end. With HeapNodes the new nodes are
+    as close together as the allocator places a run of fresh allocations;
+    the old nodes are only freed at the end, so it cannot hand them out
+    again for the new ones.
+
+    Moving an element invalidates iterators, pointers and references to
+    it. Until the old nodes are freed the list holds twice its nodes.
+    */
+
+    // Moves every element into new nodes in list order, O(n)
+    void compact() {
+        compact_step(static_cast<size_type>(-1));
+    }
+
+    // Moves up to budget more elements, continuing where the last call
+    // stopped, and returns true once the whole list is compact. Between
+    // steps the list can be read and iterated as usual; modifying it stops
+    // the compaction, keeping the elements moved so far where they are.
+    bool compact_step( size_type budget ) {
+        if (compaction == nullptr) {
+            if (_size == 0) {
+                return true;
+            }
+            compaction.reset(new Compaction);
+            compaction->retired = std::move(nodes);
+            compaction->cursor = head.next;
+        }
+
+        Compaction& c = *compaction;
+        for (; budget > 0 && c.cursor != &tail; budget--) {
+            Node* old = c.cursor;
+            Node* fresh = nodes.create(std::move(old->data), old->prev, old->next);
+            fresh->prev->next = fresh;
+            fresh->next->prev = fresh;
+            c.cursor = fresh->next;
+            old->next = c.graveyard;
+            c.graveyard = old;
+        }
+        if (c.cursor != &tail) {
+            return false;
+        }
+
+        if (!node_pool::bulk_release || !std::is_trivially_destructible<T>::value) {
+            bury_moved_nodes(); // otherwise they are freed with their pages
+        }
+        compaction.reset();
+        return true;
+    }
+
+private:
+    // Destroys the moved-from nodes left behind by compact_step
+    void bury_moved_nodes() noexcept {
+        Compaction& c = *compaction;
+        while (c.graveyard != nullptr) {
+            Node* next = c.graveyard->next;
+            c.retired.destroy(c.graveyard);
+            c.graveyard = next;
+        }
+    }
+
+    // Ends a compaction part way: the nodes not moved yet join the current pool
+    void stop_compaction() noexcept {
+        if (compaction == nullptr) {
+            return;
+        }
+        bury_moved_nodes();
+        nodes.adopt(compaction->retired);
+        compaction.reset();
+    }
+
+    // other's pool, with every node of other in it
+    static node_pool&& take_nodes( List& other ) noexcept {
+        other.stop_compaction();
+        return std::move(other.nodes);
+    }
+
+    // Links the chain first ... last (by next and prev) in before pos
+    static void link_before( Node* pos, Node* first, Node* last ) noexcept {
+        first->prev = pos->prev;
+        last->next = pos;
+        pos->prev->next = first;
+        pos->prev = last;
+    }
+
+    // Cuts first ... last out of the list it is in
+    static void unlink( Node* first, Node* last ) noexcept {
+        first->prev->next = last->next;
+        last->next->prev = first->prev;
+    }
+
+    // Forgets every node, for when they now belong to another list
+    void unlink_all() noexcept {
+        head.next = &tail;
+        tail.prev = &head;
+        _size = 0;
+    }
+
+    // Rebuilds the prev links and sentinels from a null terminated chain
+    // of next links holding every element
+    void relink( Node* first ) noexcept {
+        Node* prev = &head;
+        for (Node* curr = first; curr != nullptr; curr = curr->next) {
+            prev->next = curr;
+            curr->prev = prev;
+            prev = curr;
+        }
+        prev->next = &tail;
+        tail.prev = prev;
+    }
+
+    // Merges two sorted null terminated chains by their next links. On
+    // ties the node from a comes first.
+    template <class Compare>
+    static Node* merge_chains( Node* a, Node* b, Compare& comp ) {
+        if (a == nullptr) {
+            return b;
+        }
+        Node* merged = nullptr;
+        Node** link = &merged;
+        while (a != nullptr && b != nullptr) {
+            if (comp(b->data, a->data)) {
+                *link = b;
+                b = b->next;
+            }
+            else {
+                *link = a;
+                a = a->next;
+            }
+            link = &(*link)->next;
+        }
+        *link = a != nullptr ? a : b;
+        return merged;
+    }
+
+    // Runs shorter than this are extended by insertion, so random input
+    // needs fewer merge passes over its (scattered) nodes
+    static constexpr size_type min_run = 16;
+
+    // Detaches the natural run at the front of the chain rest: the longest
+    // non-decreasing prefix, or the longest strictly decreasing prefix,
+    // which is reversed (strictly, so equal elements keep their order).
+    // A short run then takes in the following nodes by insertion until it
+    // is min_run long.
+    template <class Compare>
+    static Node* take_run( Node*& rest, Compare& comp ) {
+        Node* first = rest;
+        Node* last = first;
+        size_type length = 1;
+        if (last->next != nullptr && comp(last->next->data, last->data)) {
+            Node* curr = first->next;
+            first->next = nullptr;
+            while (curr != nullptr && comp(curr->data, first->data)) {
+                Node* next = curr->next;
+                curr->next = first;
+                first = curr;
+                curr = next;
+                length++;
+            }
+            rest = curr;
+        }
+        else {
+            while (last->next != nullptr && !comp(last->next->data, last->data)) {
+                last = last->next;
+                length++;
+            }
+            rest = last->next;
+            last->next = nullptr;
+        }
+
+        while (length < min_run && rest != nullptr) {
+            Node* node = rest;
+            rest = rest->next;
+            if (!comp(node->data, last->data)) {
+                node->next = nullptr;
+                last->next = node;
+                last = node;
+            }
+            else if (comp(node->data, first->data)) {
+                node->next = first;
+                first = node;
+            }
+            else {
+                // after the last element not greater than it, to stay stable
+                Node* at = first;
+                while (!comp(node->data, at->next->data)) {
+                    at = at->next;
+                }
+                node->next = at->next;
+                at->next = node;
+            }
+            length++;
+        }
+        return first;
+    }
+
+public:
+
     /*
     You do not need to modify these methods!
     
@@ -437,6 +851,19 @@ public:
     iterator erase( iterator pos ) {
         return erase((const_iterator&)(pos));
     }
+
+    void splice( iterator pos, List& other ) {
+        splice((const_iterator&)(pos), other);
+    }
+    void splice( iterator pos, List&& other ) {
+        splice((const_iterator&)(pos), other);
+    }
+    void splice( iterator pos, List& other, iterator it ) {
+        splice((const_iterator&)(pos), other, (const_iterator&)(it));
+    }
+    void splice( iterator pos, List& other, iterator first, iterator last ) {
+        splice((const_iterator&)(pos), other, (const_iterator&)(first), (const_iterator&)(last));
+    }
 };
 
 
@@ -451,10 +878,10 @@ namespace {
     template<typename Iter, typename ConstIter, typename T>
     using enable_for_list_iters = typename std::enable_if<
         std::is_same<
-            typename List<typename std::iterator_traits<Iter>::value_type>::iterator, 
+            typename Iter::list_type::iterator, 
             Iter
         >{} && std::is_same<
-            typename List<typename std::iterator_traits<Iter>::value_type>::const_iterator,
+            typename Iter::list_type::const_iterator,
             ConstIter
         >{}, T>::type;
 }
@@ -0,0 +1,419 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <climits> // INT_MAX
+#include <cstddef> // size_t, ptrdiff_t
+#include <cstdint> // uint32_t
+#include <iterator> // std::distance
+#include <new> // placement new
+#include <utility> // std::move, std::forward
+
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+#else
+#include <condition_variable>
+#include <mutex>
+#endif
+
+/*
+    MpmcQueue
+    ---------
+
+    A bounded queue that any number of producer and consumer threads can
+    share, after Dmitry Vyukov's bounded MPMC queue. Each slot of the
+    power-of-two ring carries a sequence number that says whose turn it is:
+
+    sequence == pos        free, for the producer that claims position pos
+    sequence == pos + 1    full, for the consumer that claims position pos
+
+    A producer claims the next position with one compare-exchange on the
+    enqueue index, constructs the element and publishes it by bumping the
+    slot's sequence; a consumer does the same on the dequeue index. Threads
+    only contend on the index they move, and never wait on each other
+    except when the queue is full or empty.
+
+    push_range and pop_up_to claim a run of consecutive positions with a
+    single compare-exchange, so a batch pays for synchronization once.
+
+    try_push/try_pop never wait. push/pop block, and try_push_for/until
+    and try_pop_for/until block up to a timeout. A thread that has to wait
+    spins briefly, then parks: on Linux on a futex, elsewhere on a
+    condition variable. Producers and consumers only make the wake-up
+    system call when someone is parked, so a queue that never runs full
+    or empty makes no system calls at all.
+
+    The interface follows Queue where it can, but front() cannot be used
+    safely once other consumers exist, so pop hands the element out.
+    Constructing or assigning a T must not throw: a claimed slot that is
+    never published would stall every thread behind it.
+*/
+
+namespace mpmc_detail {
+
+    // Where threads sleep until the other side makes progress.
+    //
+    // A thread about to sleep reads the counter, raises parked and then
+    // retries its operation once more; the other side publishes its work,
+    // then checks parked. The fences between the two steps on each side
+    // guarantee that either the retry sees the work, or the publisher sees
+    // parked, bumps the counter and wakes the sleepers (a wait on a stale
+    // counter returns at once). The first publisher to see parked clears
+    // it, so a sleeping thread costs one wake-up call, not one per element.
+    class Parking {
+        std::atomic<uint32_t> word;
+        std::atomic<uint32_t> parked;
+#ifndef __linux__
+        std::mutex mutex;
+        std::condition_variable cv;
+#endif
+
+    public:
+        Parking() noexcept : word(0), parked(0) {}
+
+        // Announces a sleeper; returns the counter to pass to wait()
+        uint32_t prepare() noexcept {
+            uint32_t seen = word.load(std::memory_order_acquire);
+            parked.store(1, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            return seen;
+        }
+
+        // Sleeps while the counter still equals seen, until deadline; may wake spuriously
+        template <class Clock, class Duration>
+        void wait(uint32_t seen, const std::chrono::time_point<Clock, Duration>* deadline) {
+#ifdef __linux__
+            static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+            timespec timeout;
+            timespec* timeout_ptr = nullptr;
+            if (deadline) {
+                auto left = std::chrono::duration_cast<std::chrono::nanoseconds>(*deadline - Clock::now());
+                if (left.count() <= 0) {
+                    return;
+                }
+                timeout.tv_sec = static_cast<time_t>(left.count() / 1000000000);
+                timeout.tv_nsec = static_cast<long>(left.count() % 1000000000);
+                timeout_ptr = &timeout;
+            }
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAIT_PRIVATE, seen, timeout_ptr, nullptr, 0);
+#else
+            std::unique_lock<std::mutex> lock(mutex);
+            auto changed = [&] { return word.load(std::memory_order_acquire) != seen; };
+            if (deadline) {
+                cv.wait_until(lock, *deadline, changed);
+            }
+            else {
+                cv.wait(lock, changed);
+            }
+#endif
+        }
+
+        // Called after publishing work: wakes every sleeper, if there are any
+        void notify() {
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (parked.load(std::memory_order_relaxed) == 0 || parked.exchange(0, std::memory_order_relaxed) == 0) {
+                return;
+            }
+#ifdef __linux__
+            word.fetch_add(1, std::memory_order_release);
+            syscall(SYS_futex, reinterpret_cast<uint32_t*>(&word), FUTEX_WAKE_PRIVATE, INT_MAX, nullptr, nullptr, 0);
+#else
+            {
+                std::lock_guard<std::mutex> lock(mutex);
+                word.fetch_add(1, std::memory_order_release);
+            }
+            cv.notify_all();
+#endif
+        }
+    };
+}
+
+template <class T>
+class MpmcQueue {
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    static constexpr size_t cache_line = 64;
+    static constexpr int spin_limit = 64; // failed attempts before a thread parks
+
+    struct Cell {
+        std::atomic<size_type> sequence;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        T* element() noexcept { return reinterpret_cast<T*>(storage); }
+    };
+
+    // Read-only after construction
+    alignas(cache_line) Cell* cells;
+    size_type mask;
+
+    alignas(cache_line) std::atomic<size_type> enqueue_pos;
+    alignas(cache_line) std::atomic<size_type> dequeue_pos;
+
+    // Consumers park on items when the queue is empty, producers on space when it is full
+    alignas(cache_line) mpmc_detail::Parking items;
+    alignas(cache_line) mpmc_detail::Parking space;
+
+    static size_type round_up(size_type count) noexcept {
+        size_type capacity = 2;
+        while (capacity < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    static ptrdiff_t distance(size_type sequence, size_type pos) noexcept {
+        return static_cast<ptrdiff_t>(sequence - pos);
+    }
+
+    // Claims up to count free positions in a row, returns how many (0 if full)
+    size_type claim_push(size_type count, size_type& first) noexcept {
+        size_type pos = enqueue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            size_type n = 0;
+            bool taken = false; // another producer got to pos first
+            while (n < count && n <= mask) {
+                ptrdiff_t diff = distance(cells[(pos + n) & mask].sequence.load(std::memory_order_acquire), pos + n);
+                if (diff != 0) {
+                    taken = n == 0 && diff > 0;
+                    break;
+                }
+                n++;
+            }
+            if (taken) {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (n == 0) {
+                return 0;
+            }
+            if (enqueue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                first = pos;
+                return n;
+            }
+        }
+    }
+
+    // Claims up to count full positions in a row, returns how many (0 if empty)
+    size_type claim_pop(size_type count, size_type& first) noexcept {
+        size_type pos = dequeue_pos.load(std::memory_order_relaxed);
+        for (;;) {
+            size_type n = 0;
+            bool taken = false; // another consumer got to pos first
+            while (n < count && n <= mask) {
+                ptrdiff_t diff = distance(cells[(pos + n) & mask].sequence.load(std::memory_order_acquire), pos + n + 1);
+                if (diff != 0) {
+                    taken = n == 0 && diff > 0;
+                    break;
+                }
+                n++;
+            }
+            if (taken) {
+                pos = dequeue_pos.load(std::memory_order_relaxed);
+                continue;
+            }
+            if (n == 0) {
+                return 0;
+            }
+            if (dequeue_pos.compare_exchange_weak(pos, pos + n, std::memory_order_relaxed)) {
+                first = pos;
+                return n;
+            }
+        }
+    }
+
+    // Hands a constructed element to the consumers
+    void publish(size_type pos) noexcept {
+        cells[pos & mask].sequence.store(pos + 1, std::memory_order_release);
+    }
+
+    // Hands a slot back to the producers one lap later
+    void release(size_type pos) noexcept {
+        cells[pos & mask].sequence.store(pos + mask + 1, std::memory_order_release);
+    }
+
+    // Retries attempt() until it succeeds or deadline passes (nullptr: no deadline)
+    template <class Attempt, class Clock, class Duration>
+    bool wait_for(Attempt attempt, mpmc_detail::Parking& parking, const std::chrono::time_point<Clock, Duration>* deadline) {
+        for (int spin = 0; spin < spin_limit; spin++) {
+            if (attempt()) {
+                return true;
+            }
+        }
+        for (;;) {
+            uint32_t seen = parking.prepare();
+            if (attempt()) {
+                return true;
+            }
+            if (deadline && Clock::now() >= *deadline) {
+                return false;
+            }
+            parking.wait(seen, deadline);
+        }
+    }
+
+    template <class U>
+    bool push_one(U&& value) {
+        size_type pos;
+        if (claim_push(1, pos) == 0) {
+            return false;
+        }
+        new (cells[pos & mask].element()) T(std::forward<U>(value));
+        publish(pos);
+        items.notify();
+        return true;
+    }
+
+    bool pop_one(T& out) {
+        size_type pos;
+        if (claim_pop(1, pos) == 0) {
+            return false;
+        }
+        T* element = cells[pos & mask].element();
+        out = std::move(*element);
+        element->~T();
+        release(pos);
+        space.notify();
+        return true;
+    }
+
+    using no_deadline = std::chrono::steady_clock::time_point;
+
+public:
+    // capacity is rounded up to a power of two (at least 2)
+    explicit MpmcQueue(size_type capacity = 1024)
+    : cells(new Cell[round_up(capacity)]), mask(round_up(capacity) - 1),
+      enqueue_pos(0), dequeue_pos(0) {
+        for (size_type i = 0; i <= mask; i++) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    // Threads hold on to the queue, so it stays where it is
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator=(const MpmcQueue&) = delete;
+
+    // Only once no thread uses it any more
+    ~MpmcQueue() {
+        size_type end = enqueue_pos.load(std::memory_order_acquire);
+        for (size_type pos = dequeue_pos.load(std::memory_order_acquire); pos != end; pos++) {
+            cells[pos & mask].element()->~T();
+        }
+        delete[] cells;
+    }
+
+    size_type capacity() const noexcept { return mask + 1; }
+
+    // A snapshot that may be stale by the time it returns
+    size_type size() const noexcept {
+        size_type tail = enqueue_pos.load(std::memory_order_acquire);
+        size_type head = dequeue_pos.load(std::memory_order_acquire);
+        return tail > head ? tail - head : 0;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    // Return false instead of waiting when the queue is full
+    bool try_push(const T& value) { return push_one(value); }
+    bool try_push(T&& value) { return push_one(std::move(value)); }
+
+    // Wait while the queue is full
+    void push(const T& value) {
+        wait_for([&] { return push_one(value); }, space, static_cast<no_deadline*>(nullptr));
+    }
+    void push(T&& value) {
+        wait_for([&] { return push_one(std::move(value)); }, space, static_cast<no_deadline*>(nullptr));
+    }
+
+    // Wait up to the deadline, return false if the queue stayed full
+    template <class Clock, class Duration>
+    bool try_push_until(const T& value, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return wait_for([&] { return push_one(value); }, space, &deadline);
+    }
+    template <class Rep, class Period>
+    bool try_push_for(const T& value, const std::chrono::duration<Rep, Period>& timeout) {
+        return try_push_until(value, std::chrono::steady_clock::now() + timeout);
+    }
+
+    // Return false instead of waiting when the queue is empty
+    bool try_pop(T& out) { return pop_one(out); }
+
+    // Wait while the queue is empty
+    void pop(T& out) {
+        wait_for([&] { return pop_one(out); }, items, static_cast<no_deadline*>(nullptr));
+    }
+
+    // Wait up to the deadline, return false if the queue stayed empty
+    template <class Clock, class Duration>
+    bool try_pop_until(T& out, const std::chrono::time_point<Clock, Duration>& deadline) {
+        return wait_for([&] { return pop_one(out); }, items, &deadline);
+    }
+    template <class Rep, class Period>
+    bool try_pop_for(T& out, const std::chrono::duration<Rep, Period>& timeout) {
+        return try_pop_until(out, std::chrono::steady_clock::now() + timeout);
+    }
+
+    // Copies as many of [first, last) as fit without waiting, returns the first one left over
+    template <class ForwardIt>
+    ForwardIt try_push_range(ForwardIt first, ForwardIt last) {
+        size_type count = static_cast<size_type>(std::distance(first, last));
+        size_type pos;
+        size_type n = count == 0 ? 0 : claim_push(count, pos);
+        for (size_type i = 0; i < n; i++, ++first) {
+            new (cells[(pos + i) & mask].element()) T(*first);
+        }
+        for (size_type i = 0; i < n; i++) {
+            publish(pos + i);
+        }
+        if (n != 0) {
+            items.notify();
+        }
+        return first;
+    }
+
+    // Copies all of [first, last), waiting for room as needed
+    template <class ForwardIt>
+    void push_range(ForwardIt first, ForwardIt last) {
+        while (first != last) {
+            ForwardIt rest = try_push_range(first, last);
+            if (rest == first) {
+                wait_for([&] { return (rest = try_push_range(first, last)) != first; }, space, static_cast<no_deadline*>(nullptr));
+            }
+            first = rest;
+        }
+    }
+
+    // Moves up to count elements to out without waiting, returns how many
+    template <class OutputIt>
+    size_type try_pop_up_to(OutputIt out, size_type count) {
+        size_type pos;
+        size_type n = count == 0 ? 0 : claim_pop(count, pos);
+        for (size_type i = 0; i < n; i++, ++out) {
+            T* element = cells[(pos + i) & mask].element();
+            *out = std::move(*element);
+            element->~T();
+            release(pos + i);
+        }
+        if (n != 0) {
+            space.notify();
+        }
+        return n;
+    }
+
+    // Waits for at least one element, then moves up to count of them to out
+    template <class OutputIt>
+    size_type pop_up_to(OutputIt out, size_type count) {
+        size_type n = 0;
+        if (count != 0) {
+            wait_for([&] { return (n = try_pop_up_to(out, count)) != 0; }, items, static_cast<no_deadline*>(nullptr));
+        }
+        return n;
+    }
+};
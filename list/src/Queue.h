@@ -1,7 +1,13 @@
 #ifndef QUEUE_H
 #define QUEUE_H
+#include <algorithm> // std::equal
 #include "List.h"
+#include "RingBuffer.h"
 
+// The container is List<T> by default, which allocates a node on every
+// push and frees it on every pop. RingBuffer<T> is the recommended
+// container: it reuses one array, so a queue in steady use never
+// allocates (see RingQueue below).
 template <typename T, typename Container = List<T>>
 class Queue {
 
@@ -15,6 +21,8 @@ class Queue {
         using size_type       = typename Container::size_type;
         using reference       = typename Container::reference;
         using const_reference = typename Container::const_reference;
+        using iterator        = typename Container::iterator;
+        using const_iterator  = typename Container::const_iterator;
 
     private:
         Container c;
@@ -31,7 +39,7 @@ class Queue {
         reference front() { return c.front(); }
         const_reference front() const { return c.front(); }
         reference back() { return c.back(); }
-        const_reference back() const { c.back(); }
+        const_reference back() const { return c.back(); }
 
         bool empty() const { return c.empty(); }
         size_type size() const { return c.size(); }
@@ -39,30 +47,26 @@ class Queue {
         void push(const value_type& value) { c.push_back(value); }
         void push(value_type&& value) { c.push_back(std::move(value)); }
         void pop() { c.pop_front(); }
+
+        // Iterates from the front (the next element to pop) to the back
+        iterator begin() { return c.begin(); }
+        const_iterator begin() const { return c.begin(); }
+        iterator end() { return c.end(); }
+        const_iterator end() const { return c.end(); }
 };
 
+template <typename T>
+using RingQueue = Queue<T, RingBuffer<T>>;
+
 template <typename T, typename Container>
 inline bool operator==(const Queue<T, Container>& lhs, const Queue<T, Container>& rhs) {
     //if they aren't the same size then they can't be equal
     if (lhs.size() != rhs.size()) {
         return false;
     }
-    
-    Queue one = lhs;
-    Queue two = rhs;
-    
-    //iterate through the queue
-    for (size_t i = 0; i < rhs.size(); i++) {
-        //checks if the front elements match; if they don't then they are not equal
-        if (two.front() != one.front()) {
-            return false;
-        }
-        //remove the front element
-        two.pop();
-        one.pop();
-    }
-    //if it can pop all of the elements
-    return true;
+
+    //compare the elements in place, front to back
+    return std::equal(lhs.c.begin(), lhs.c.end(), rhs.c.begin());
 }
 
 #endif
\ No newline at end of file
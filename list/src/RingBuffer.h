@@ -0,0 +1,274 @@
+#pragma once
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <new> // placement new, ::operator new
+#include <stdexcept> // std::out_of_range
+#include <type_traits> // std::enable_if_t, std::is_same
+#include <utility> // std::move
+
+/*
+    RingBuffer
+    ----------
+
+    A FIFO buffer in one power-of-two sized array. The elements run from
+    first around the end of the array and back to its start:
+
+    [ e3 e4 .. .. .. e0 e1 e2 ]      capacity 8, size 5
+                     ^ first
+
+    Element i lives at slot (first + i) & (capacity - 1), so indexing is a
+    mask instead of a division, and push_back/pop_front neither allocate
+    nor free once the buffer is big enough. That makes it the container
+    to use for a Queue:
+
+    Queue<int, RingBuffer<int>> q;
+
+    Growth doubles the array when it is full (amortized O(1)). When pops
+    leave it a quarter full the array halves, but never below the
+    watermark (16 by default, see set_watermark), so a queue that keeps
+    refilling to about the same depth does not reallocate.
+
+    The unused slots are raw storage; elements are constructed when pushed
+    and destroyed when popped. Growing and shrinking move the elements, so
+    they invalidate iterators and references.
+*/
+
+template <class T>
+class RingBuffer {
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+
+private:
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+
+    private:
+        friend class RingBuffer;
+
+        const RingBuffer* buffer;
+        size_type index; // position from the front
+
+        basic_iterator(const RingBuffer* buffer, size_type index) noexcept : buffer(buffer), index(index) {}
+
+    public:
+        basic_iterator() noexcept : buffer(nullptr), index(0) {}
+
+        // iterator converts to const_iterator
+        template <typename P, typename R,
+                  typename = std::enable_if_t<!std::is_same<P, pointer_type>::value && std::is_same<pointer_type, const T*>::value>>
+        basic_iterator(const basic_iterator<P, R>& other) noexcept : buffer(other.buffer), index(other.index) {}
+
+        reference operator*() const { return buffer->array[buffer->slot(index)]; }
+        pointer operator->() const { return &buffer->array[buffer->slot(index)]; }
+        reference operator[](difference_type offset) const { return buffer->array[buffer->slot(index + offset)]; }
+
+        basic_iterator& operator++() noexcept { ++index; return *this; }
+        basic_iterator operator++(int) noexcept { basic_iterator temp(*this); ++index; return temp; }
+        basic_iterator& operator--() noexcept { --index; return *this; }
+        basic_iterator operator--(int) noexcept { basic_iterator temp(*this); --index; return temp; }
+
+        basic_iterator& operator+=(difference_type offset) noexcept { index += offset; return *this; }
+        basic_iterator& operator-=(difference_type offset) noexcept { index -= offset; return *this; }
+        basic_iterator operator+(difference_type offset) const noexcept { return basic_iterator(buffer, index + offset); }
+        basic_iterator operator-(difference_type offset) const noexcept { return basic_iterator(buffer, index - offset); }
+        difference_type operator-(const basic_iterator& rhs) const noexcept {
+            return static_cast<difference_type>(index) - static_cast<difference_type>(rhs.index);
+        }
+
+        bool operator==(const basic_iterator& rhs) const noexcept { return index == rhs.index; }
+        bool operator!=(const basic_iterator& rhs) const noexcept { return index != rhs.index; }
+        bool operator<(const basic_iterator& rhs) const noexcept { return index < rhs.index; }
+        bool operator>(const basic_iterator& rhs) const noexcept { return index > rhs.index; }
+        bool operator<=(const basic_iterator& rhs) const noexcept { return index <= rhs.index; }
+        bool operator>=(const basic_iterator& rhs) const noexcept { return index >= rhs.index; }
+
+        template <typename, typename>
+        friend class basic_iterator;
+    };
+
+public:
+    using iterator       = basic_iterator<pointer, reference>;
+    using const_iterator = basic_iterator<const_pointer, const_reference>;
+
+private:
+    static constexpr size_type default_watermark = 16;
+
+    T* array;
+    size_type _capacity;  // 0 or a power of two
+    size_type first;      // slot of the front element
+    size_type _size;
+    size_type _watermark; // the array does not shrink below this
+
+    size_type slot(size_type index) const noexcept { return (first + index) & (_capacity - 1); }
+
+    static size_type round_up(size_type count) noexcept {
+        size_type capacity = 1;
+        while (capacity < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    // Moves the elements, front first, into a new array of the given capacity
+    void reallocate(size_type capacity) {
+        T* bigger = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        for (size_type i = 0; i < _size; i++) {
+            T& element = array[slot(i)];
+            new (bigger + i) T(std::move(element));
+            element.~T();
+        }
+        ::operator delete(array);
+        array = bigger;
+        _capacity = capacity;
+        first = 0;
+    }
+
+    void destroy_all() noexcept {
+        for (size_type i = 0; i < _size; i++) {
+            array[slot(i)].~T();
+        }
+        _size = 0;
+        first = 0;
+    }
+
+public:
+    RingBuffer() noexcept : array(nullptr), _capacity(0), first(0), _size(0), _watermark(default_watermark) {}
+
+    RingBuffer(const RingBuffer& other) : RingBuffer() {
+        _watermark = other._watermark;
+        reserve(other._size);
+        for (size_type i = 0; i < other._size; i++) {
+            push_back(other[i]);
+        }
+    }
+
+    RingBuffer(RingBuffer&& other) noexcept
+    : array(other.array), _capacity(other._capacity), first(other.first), _size(other._size), _watermark(other._watermark) {
+        other.array = nullptr;
+        other._capacity = 0;
+        other.first = 0;
+        other._size = 0;
+    }
+
+    ~RingBuffer() {
+        destroy_all();
+        ::operator delete(array);
+    }
+
+    RingBuffer& operator=(const RingBuffer& other) {
+        if (this != &other) {
+            destroy_all();
+            _watermark = other._watermark;
+            reserve(other._size);
+            for (size_type i = 0; i < other._size; i++) {
+                push_back(other[i]);
+            }
+        }
+        return *this;
+    }
+
+    RingBuffer& operator=(RingBuffer&& other) noexcept {
+        if (this != &other) {
+            destroy_all();
+            ::operator delete(array);
+            array = other.array;
+            _capacity = other._capacity;
+            first = other.first;
+            _size = other._size;
+            _watermark = other._watermark;
+            other.array = nullptr;
+            other._capacity = 0;
+            other.first = 0;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    const_iterator begin() const noexcept { return const_iterator(this, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+    iterator end() noexcept { return iterator(this, _size); }
+    const_iterator end() const noexcept { return const_iterator(this, _size); }
+    const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+    size_type capacity() const noexcept { return _capacity; }
+
+    // Element i from the front
+    reference operator[](size_type pos) { return array[slot(pos)]; }
+    const_reference operator[](size_type pos) const { return array[slot(pos)]; }
+    reference at(size_type pos) {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return array[slot(pos)];
+    }
+    const_reference at(size_type pos) const {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return array[slot(pos)];
+    }
+
+    reference front() { return array[first]; }
+    const_reference front() const { return array[first]; }
+    reference back() { return array[slot(_size - 1)]; }
+    const_reference back() const { return array[slot(_size - 1)]; }
+
+    // Makes room for count elements without growing again
+    void reserve(size_type count) {
+        if (count > _capacity) {
+            reallocate(round_up(count));
+        }
+    }
+
+    // Smallest capacity that pops shrink the array to, rounded up to a power of two
+    void set_watermark(size_type watermark) noexcept { _watermark = round_up(watermark); }
+    size_type watermark() const noexcept { return _watermark; }
+
+    void push_back(const T& value) {
+        if (_size == _capacity) {
+            T copy = value; // value may be an element that reallocate() moves
+            reallocate(_capacity == 0 ? round_up(_watermark) : _capacity * 2);
+            new (array + slot(_size)) T(std::move(copy));
+        }
+        else {
+            new (array + slot(_size)) T(value);
+        }
+        _size++;
+    }
+
+    void push_back(T&& value) {
+        if (_size == _capacity) {
+            T moved = std::move(value);
+            reallocate(_capacity == 0 ? round_up(_watermark) : _capacity * 2);
+            new (array + slot(_size)) T(std::move(moved));
+        }
+        else {
+            new (array + slot(_size)) T(std::move(value));
+        }
+        _size++;
+    }
+
+    void pop_front() {
+        array[first].~T();
+        first = (first + 1) & (_capacity - 1);
+        _size--;
+        if (_size < _capacity / 4 && _capacity / 2 >= _watermark) {
+            reallocate(_capacity / 2);
+        }
+    }
+
+    // Destroys the elements but keeps the array
+    void clear() noexcept { destroy_all(); }
+};
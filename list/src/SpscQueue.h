@@ -0,0 +1,214 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef> // size_t
+#include <new> // placement new, ::operator new
+#include <thread> // std::this_thread::yield
+#include <utility> // std::move
+
+/*
+    SpscQueue
+    ---------
+
+    A bounded lock-free queue between exactly one producer thread and one
+    consumer thread. It is a power-of-two ring like RingBuffer, but it
+    never grows: push waits (try_push fails) while it is full.
+
+    The producer only writes tail and the consumer only writes head. Each
+    publishes its index with a release store and reads the other's with
+    an acquire load, so an element is fully constructed before the
+    consumer can see it, and fully destroyed before the producer can reuse
+    its slot.
+
+    Each side also keeps a private copy of the other side's index and only
+    reloads it when that copy says the queue is full (producer) or empty
+    (consumer). head and tail live on separate cache lines, each next to
+    the cached copy its own thread uses, so in steady flow the two cores
+    rarely touch each other's line.
+
+    Producer thread:  push, try_push, push_n
+    Consumer thread:  front, pop, try_pop, pop_n
+    Either thread:    empty, size (a snapshot that may already be stale)
+
+    The interface follows Queue: push, front, pop, empty. push_n and pop_n
+    move up to n elements with one index update, which amortizes the
+    synchronization over the batch.
+*/
+
+template <class T>
+class SpscQueue {
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+
+private:
+    static constexpr size_t cache_line = 64;
+
+    // Read-only after construction, shared by both threads
+    alignas(cache_line) T* array;
+    size_type mask;
+
+    // Consumer's line: the index it pops from and its copy of tail
+    alignas(cache_line) std::atomic<size_type> head;
+    size_type cached_tail;
+
+    // Producer's line: the index it pushes to and its copy of head
+    alignas(cache_line) std::atomic<size_type> tail;
+    size_type cached_head;
+
+    // Pads the producer's line from whatever follows the queue in memory
+    char padding[cache_line - sizeof(std::atomic<size_type>) - sizeof(size_type)];
+
+    static size_type round_up(size_type count) noexcept {
+        size_type capacity = 2;
+        while (capacity < count) {
+            capacity *= 2;
+        }
+        return capacity;
+    }
+
+    T* slot(size_type index) const noexcept { return array + (index & mask); }
+
+    // Free slots as the producer sees them, reloading head only when needed
+    size_type room(size_type t, size_type wanted) noexcept {
+        size_type free = capacity() - (t - cached_head);
+        if (free < wanted) {
+            cached_head = head.load(std::memory_order_acquire);
+            free = capacity() - (t - cached_head);
+        }
+        return free;
+    }
+
+    // Queued elements as the consumer sees them, reloading tail only when needed
+    size_type available(size_type h, size_type wanted) noexcept {
+        size_type count = cached_tail - h;
+        if (count < wanted) {
+            cached_tail = tail.load(std::memory_order_acquire);
+            count = cached_tail - h;
+        }
+        return count;
+    }
+
+public:
+    // capacity is rounded up to a power of two (at least 2)
+    explicit SpscQueue(size_type capacity = 1024)
+    : array(static_cast<T*>(::operator new(round_up(capacity) * sizeof(T)))), mask(round_up(capacity) - 1),
+      head(0), cached_tail(0), tail(0), cached_head(0) {}
+
+    // The threads hold on to the queue, so it stays where it is
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Only once both threads are done with it
+    ~SpscQueue() {
+        size_type t = tail.load(std::memory_order_acquire);
+        for (size_type h = head.load(std::memory_order_relaxed); h != t; h++) {
+            slot(h)->~T();
+        }
+        ::operator delete(array);
+    }
+
+    size_type capacity() const noexcept { return mask + 1; }
+
+    bool empty() const noexcept {
+        return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire);
+    }
+
+    size_type size() const noexcept {
+        size_type h = head.load(std::memory_order_acquire);
+        return tail.load(std::memory_order_acquire) - h;
+    }
+
+    // Producer: returns false (and leaves value alone) if the queue is full
+    bool try_push(const T& value) {
+        size_type t = tail.load(std::memory_order_relaxed);
+        if (room(t, 1) == 0) {
+            return false;
+        }
+        new (slot(t)) T(value);
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    bool try_push(T&& value) {
+        size_type t = tail.load(std::memory_order_relaxed);
+        if (room(t, 1) == 0) {
+            return false;
+        }
+        new (slot(t)) T(std::move(value));
+        tail.store(t + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Producer: waits for room while the queue is full
+    void push(const T& value) {
+        while (!try_push(value)) {
+            std::this_thread::yield();
+        }
+    }
+
+    void push(T&& value) {
+        while (!try_push(std::move(value))) {
+            std::this_thread::yield();
+        }
+    }
+
+    // Producer: copies as many of values[0, count) as fit, returns how many
+    size_type push_n(const T* values, size_type count) {
+        size_type t = tail.load(std::memory_order_relaxed);
+        size_type n = room(t, count);
+        if (n > count) {
+            n = count;
+        }
+        for (size_type i = 0; i < n; i++) {
+            new (slot(t + i)) T(values[i]);
+        }
+        tail.store(t + n, std::memory_order_release);
+        return n;
+    }
+
+    // Consumer: the oldest element; the queue must not be empty
+    reference front() {
+        size_type h = head.load(std::memory_order_relaxed);
+        available(h, 1);
+        return *slot(h);
+    }
+
+    // Consumer: removes the oldest element; the queue must not be empty
+    void pop() {
+        size_type h = head.load(std::memory_order_relaxed);
+        slot(h)->~T();
+        head.store(h + 1, std::memory_order_release);
+    }
+
+    // Consumer: moves the oldest element into out, or returns false if empty
+    bool try_pop(T& out) {
+        size_type h = head.load(std::memory_order_relaxed);
+        if (available(h, 1) == 0) {
+            return false;
+        }
+        T* element = slot(h);
+        out = std::move(*element);
+        element->~T();
+        head.store(h + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer: moves up to count elements into out, returns how many
+    size_type pop_n(T* out, size_type count) {
+        size_type h = head.load(std::memory_order_relaxed);
+        size_type n = available(h, count);
+        if (n > count) {
+            n = count;
+        }
+        for (size_type i = 0; i < n; i++) {
+            T* element = slot(h + i);
+            out[i] = std::move(*element);
+            element->~T();
+        }
+        head.store(h + n, std::memory_order_release);
+        return n;
+    }
+};
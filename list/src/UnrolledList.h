@@ -0,0 +1,392 @@
+#pragma once
+
+#include <algorithm> // std::move, std::move_backward
+#include <cstddef> // size_t
+#include <iterator> // std::bidirectional_iterator_tag
+#include <new> // placement new
+#include <type_traits> // std::enable_if_t, std::is_same
+#include <utility> // std::move, std::forward
+
+/*
+    UnrolledList
+    ------------
+
+    A doubly linked list whose nodes are blocks of several elements, sized
+    to CacheLines cache lines (2 by default, so 26 ints per block):
+
+    head <-> [ prev | next | count | e0 e1 ... e25 ] <-> [ ... ] <-> tail
+
+    Walking a List<int> follows one pointer per element, and each of those
+    is a likely cache miss; walking an UnrolledList follows one pointer per
+    block and reads the elements of a block from adjacent memory. The
+    blocks also take about a third of the memory of one node per element.
+
+    Inserting into a full block splits it into two half full blocks, and a
+    block that falls under half full after an erase takes elements from
+    (or merges with) the block after it, so apart from the last one every
+    block stays at least half full. insert and erase move at most one
+    block's worth of elements: O(1) in the size of the list.
+
+    Unlike List, insert and erase invalidate the iterators into the blocks
+    they touch (the elements shift within and between blocks). Iterators
+    into other blocks stay valid.
+*/
+
+template <class T, size_t CacheLines = 2>
+class UnrolledList {
+    static_assert(CacheLines > 0, "a block needs at least one cache line");
+
+    struct Links {
+        Links *prev, *next;
+    };
+
+    static constexpr size_t cache_line = 64;
+    static constexpr size_t header_bytes = sizeof(Links) + sizeof(size_t);
+    static constexpr size_t fitting = CacheLines * cache_line > header_bytes
+        ? (CacheLines * cache_line - header_bytes) / sizeof(T) : 0;
+
+public:
+    // Elements per block, never fewer than 4 so that splitting makes progress
+    static constexpr size_t block_capacity = fitting < 4 ? 4 : fitting;
+
+private:
+    struct Block : Links {
+        size_t count;
+        alignas(T) unsigned char storage[block_capacity * sizeof(T)];
+
+        Block() : Links{nullptr, nullptr}, count(0) {}
+
+        T* elements() noexcept { return reinterpret_cast<T*>(storage); }
+        T& operator[](size_t pos) noexcept { return elements()[pos]; }
+    };
+
+    template <typename pointer_type, typename reference_type>
+    class basic_iterator {
+    public:
+        using iterator_category = std::bidirectional_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = pointer_type;
+        using reference         = reference_type;
+
+    private:
+        friend class UnrolledList;
+
+        Links* links; // the block, or the tail sentinel for end()
+        size_t pos;   // index in the block
+
+        basic_iterator(Links* links, size_t pos) noexcept : links(links), pos(pos) {}
+
+        Block* block() const noexcept { return static_cast<Block*>(links); }
+
+    public:
+        basic_iterator() noexcept : links(nullptr), pos(0) {}
+
+        // iterator converts to const_iterator
+        template <typename P, typename R,
+                  typename = std::enable_if_t<!std::is_same<P, pointer_type>::value && std::is_same<pointer_type, const T*>::value>>
+        basic_iterator(const basic_iterator<P, R>& other) noexcept : links(other.links), pos(other.pos) {}
+
+        reference operator*() const { return (*block())[pos]; }
+        pointer operator->() const { return &(*block())[pos]; }
+
+        // Prefix Increment: ++a
+        basic_iterator& operator++() {
+            if (++pos == block()->count) {
+                links = links->next;
+                pos = 0;
+            }
+            return *this;
+        }
+        // Postfix Increment: a++
+        basic_iterator operator++(int) {
+            basic_iterator temp(*this);
+            ++*this;
+            return temp;
+        }
+        // Prefix Decrement: --a
+        basic_iterator& operator--() {
+            if (pos == 0) {
+                links = links->prev;
+                pos = block()->count;
+            }
+            pos--;
+            return *this;
+        }
+        // Postfix Decrement: a--
+        basic_iterator operator--(int) {
+            basic_iterator temp(*this);
+            --*this;
+            return temp;
+        }
+
+        bool operator==(const basic_iterator& other) const noexcept {
+            return links == other.links && pos == other.pos;
+        }
+        bool operator!=(const basic_iterator& other) const noexcept {
+            return !(*this == other);
+        }
+
+        template <typename, typename>
+        friend class basic_iterator;
+    };
+
+public:
+    using value_type      = T;
+    using size_type       = size_t;
+    using difference_type = ptrdiff_t;
+    using reference       = value_type&;
+    using const_reference = const value_type&;
+    using pointer         = value_type*;
+    using const_pointer   = const value_type*;
+    using iterator        = basic_iterator<pointer, reference>;
+    using const_iterator  = basic_iterator<const_pointer, const_reference>;
+
+private:
+    Links head, tail;
+    size_type _size;
+    size_type _blocks;
+
+    bool is_block(const Links* links) const noexcept { return links != &head && links != &tail; }
+
+    // A new empty block linked in after links
+    Block* add_block_after(Links* links) {
+        Block* block = new Block;
+        block->prev = links;
+        block->next = links->next;
+        links->next->prev = block;
+        links->next = block;
+        _blocks++;
+        return block;
+    }
+
+    void remove_block(Block* block) noexcept {
+        block->prev->next = block->next;
+        block->next->prev = block->prev;
+        delete block;
+        _blocks--;
+    }
+
+    // Moves the elements [from, count) of src to the end of dst, which has room
+    static void move_tail(Block* src, size_t from, Block* dst) {
+        for (size_t i = from; i < src->count; i++) {
+            new (dst->elements() + dst->count) T(std::move((*src)[i]));
+            dst->count++;
+            (*src)[i].~T();
+        }
+        src->count = from;
+    }
+
+    // Opens a hole at pos in a block that has room and constructs value there
+    template <class U>
+    static void put(Block* block, size_t pos, U&& value) {
+        size_t n = block->count;
+        if (pos == n) {
+            new (block->elements() + n) T(std::forward<U>(value));
+        }
+        else {
+            // the last element moves into raw storage, the rest shift over it
+            new (block->elements() + n) T(std::move((*block)[n - 1]));
+            std::move_backward(block->elements() + pos, block->elements() + n - 1, block->elements() + n);
+            (*block)[pos] = std::forward<U>(value);
+        }
+        block->count++;
+    }
+
+    template <class U>
+    iterator emplace_at(const_iterator where, U&& value) {
+        Links* links = where.links;
+        size_t pos = where.pos;
+
+        if (!is_block(links)) {
+            // end(): append to the last block, or to a new one
+            links = tail.prev;
+            if (!is_block(links) || static_cast<Block*>(links)->count == block_capacity) {
+                links = add_block_after(links);
+            }
+            pos = static_cast<Block*>(links)->count;
+        }
+
+        Block* block = static_cast<Block*>(links);
+        if (block->count == block_capacity) {
+            // split: the upper half goes to a new block after this one
+            const size_t half = block_capacity / 2;
+            Block* upper = add_block_after(block);
+            move_tail(block, half, upper);
+            if (pos > half) {
+                block = upper;
+                pos -= half;
+            }
+        }
+
+        put(block, pos, std::forward<U>(value));
+        _size++;
+        return iterator(block, pos);
+    }
+
+    void destroy_all() noexcept {
+        Links* links = head.next;
+        while (links != &tail) {
+            Block* block = static_cast<Block*>(links);
+            links = links->next;
+            for (size_t i = 0; i < block->count; i++) {
+                (*block)[i].~T();
+            }
+            delete block;
+        }
+        head.next = &tail;
+        tail.prev = &head;
+        _size = 0;
+        _blocks = 0;
+    }
+
+    template <class Iter>
+    void append(Iter first, Iter last) {
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+public:
+    UnrolledList() noexcept : _size(0), _blocks(0) {
+        head.prev = nullptr;
+        head.next = &tail;
+        tail.prev = &head;
+        tail.next = nullptr;
+    }
+
+    UnrolledList(size_type count, const T& value) : UnrolledList() {
+        for (size_type i = 0; i < count; i++) {
+            push_back(value);
+        }
+    }
+
+    UnrolledList(const UnrolledList& other) : UnrolledList() {
+        append(other.begin(), other.end());
+    }
+
+    UnrolledList(UnrolledList&& other) noexcept : UnrolledList() {
+        *this = std::move(other);
+    }
+
+    ~UnrolledList() {
+        destroy_all();
+    }
+
+    UnrolledList& operator=(const UnrolledList& other) {
+        if (this != &other) {
+            destroy_all();
+            append(other.begin(), other.end());
+        }
+        return *this;
+    }
+
+    UnrolledList& operator=(UnrolledList&& other) noexcept {
+        if (this == &other) {
+            return *this;
+        }
+        destroy_all();
+        if (other.empty()) {
+            return *this;
+        }
+
+        // the blocks move over; only the first and last point at the sentinels
+        head.next = other.head.next;
+        tail.prev = other.tail.prev;
+        head.next->prev = &head;
+        tail.prev->next = &tail;
+        _size = other._size;
+        _blocks = other._blocks;
+
+        other.head.next = &other.tail;
+        other.tail.prev = &other.head;
+        other._size = 0;
+        other._blocks = 0;
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(head.next, 0); }
+    const_iterator begin() const noexcept { return const_iterator(head.next, 0); }
+    const_iterator cbegin() const noexcept { return begin(); }
+
+    iterator end() noexcept { return iterator(&tail, 0); }
+    const_iterator end() const noexcept { return const_iterator(const_cast<Links*>(&tail), 0); }
+    const_iterator cend() const noexcept { return end(); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_type size() const noexcept { return _size; }
+
+    // Number of blocks in use, for measuring how full they are
+    size_type block_count() const noexcept { return _blocks; }
+
+    reference front() { return (*static_cast<Block*>(head.next))[0]; }
+    const_reference front() const { return (*static_cast<Block*>(head.next))[0]; }
+    reference back() {
+        Block* last = static_cast<Block*>(tail.prev);
+        return (*last)[last->count - 1];
+    }
+    const_reference back() const {
+        Block* last = static_cast<Block*>(tail.prev);
+        return (*last)[last->count - 1];
+    }
+
+    void clear() noexcept { destroy_all(); }
+
+    // value is copied first: it may be an element that the insert moves
+    iterator insert(const_iterator pos, const T& value) { return emplace_at(pos, T(value)); }
+    iterator insert(const_iterator pos, T&& value) { return emplace_at(pos, std::move(value)); }
+
+    // Returns an iterator to the element after the erased one
+    iterator erase(const_iterator where) {
+        Block* block = where.block();
+        size_t pos = where.pos;
+
+        std::move(block->elements() + pos + 1, block->elements() + block->count, block->elements() + pos);
+        (*block)[block->count - 1].~T();
+        block->count--;
+        _size--;
+
+        if (block->count == 0) {
+            Links* next = block->next;
+            remove_block(block);
+            return iterator(next, 0);
+        }
+
+        // keep the block at least half full, using the block after it
+        const size_t half = block_capacity / 2;
+        if (block->count < half && is_block(block->next)) {
+            Block* next = static_cast<Block*>(block->next);
+            if (block->count + next->count <= block_capacity) {
+                move_tail(next, 0, block);
+                remove_block(next);
+            }
+            else {
+                // borrow from the front of next until this block is half full
+                size_t borrow = half - block->count;
+                for (size_t i = 0; i < borrow; i++) {
+                    new (block->elements() + block->count) T(std::move((*next)[i]));
+                    block->count++;
+                }
+                std::move(next->elements() + borrow, next->elements() + next->count, next->elements());
+                for (size_t i = next->count - borrow; i < next->count; i++) {
+                    (*next)[i].~T();
+                }
+                next->count -= borrow;
+            }
+        }
+
+        if (pos == block->count) {
+            return iterator(block->next, 0);
+        }
+        return iterator(block, pos);
+    }
+
+    void push_back(const T& value) { emplace_at(end(), T(value)); }
+    void push_back(T&& value) { emplace_at(end(), std::move(value)); }
+
+    void push_front(const T& value) { emplace_at(begin(), T(value)); }
+    void push_front(T&& value) { emplace_at(begin(), std::move(value)); }
+
+    void pop_back() { erase(--end()); }
+    void pop_front() { erase(begin()); }
+};
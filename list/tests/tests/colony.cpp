@@ -0,0 +1,148 @@
+#include <algorithm>
+#include <iterator>
+#include <map>
+#include <set>
+#include <string>
+#include <vector>
+#include "executable.h"
+#include "Colony.h"
+
+namespace {
+    // The elements in iteration order, forwards and (reversed back) backwards
+    template<typename C>
+    bool iterates_both_ways(C const & colony, std::vector<typename C::value_type>& out) {
+        out.assign(colony.begin(), colony.end());
+        std::vector<typename C::value_type> backwards(std::make_reverse_iterator(colony.end()), std::make_reverse_iterator(colony.begin()));
+        std::reverse(backwards.begin(), backwards.end());
+        return out.size() == colony.size() && out == backwards;
+    }
+}
+
+TEST(colony_matches_multiset) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        // small blocks so that runs of holes span whole blocks
+        Colony<std::string, 4> colony;
+        std::vector<Colony<std::string, 4>::iterator> its;
+        std::multiset<std::string> gt;
+
+        for(size_t op = 0; op < 400; op++) {
+            if(t.range(5ULL) < 3 || its.empty()) {
+                std::string value = std::to_string(t.get<int>());
+                its.push_back(colony.insert(value));
+                gt.insert(value);
+                ASSERT_TRUE(*its.back() == value);
+            }
+            else {
+                size_t at = t.range(its.size());
+                gt.erase(gt.find(*its[at]));
+                colony.erase(its[at]);
+                its[at] = its.back();
+                its.pop_back();
+            }
+            ASSERT_EQ(gt.size(), colony.size());
+        }
+
+        std::vector<std::string> seen;
+        ASSERT_TRUE(iterates_both_ways(colony, seen));
+        std::sort(seen.begin(), seen.end());
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), seen.begin(), seen.end()));
+
+        // erase while iterating, through the returned iterator
+        for(auto it = colony.begin(); it != colony.end();) {
+            if(it->size() % 2 == 0) {
+                gt.erase(gt.find(*it));
+                it = colony.erase(it);
+            }
+            else {
+                ++it;
+            }
+        }
+        ASSERT_TRUE(iterates_both_ways(colony, seen));
+        std::sort(seen.begin(), seen.end());
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), seen.begin(), seen.end()));
+
+        const Colony<std::string, 4> copy = colony;
+        Colony<std::string, 4> moved = std::move(colony);
+        ASSERT_TRUE(colony.empty());
+        ASSERT_TRUE(colony.begin() == colony.end());
+        ASSERT_EQ(gt.size(), copy.size());
+        ASSERT_TRUE(std::is_permutation(gt.begin(), gt.end(), copy.begin(), copy.end()));
+        ASSERT_TRUE(std::is_permutation(gt.begin(), gt.end(), moved.begin(), moved.end()));
+    }
+}
+
+TEST(colony_pointers_are_stable) {
+    Typegen t;
+    Colony<int, 16> colony;
+    std::map<const int*, int> live;
+
+    for(int op = 0; op < 20000; op++) {
+        if(t.range(2ULL) == 0 || live.empty()) {
+            int value = t.get<int>();
+            auto it = colony.insert(value);
+            ASSERT_TRUE(live.count(&*it) == 0);
+            live[&*it] = value;
+        }
+        else {
+            // erase the element of a random live pointer; find it by walking
+            auto victim = std::next(live.begin(), t.range(live.size()));
+            auto it = colony.begin();
+            while(&*it != victim->first) {
+                ++it;
+            }
+            colony.erase(it);
+            live.erase(victim);
+        }
+        if(op % 1000 == 0) {
+            for(const auto& [ptr, value] : live) {
+                ASSERT_EQ(value, *ptr);
+            }
+        }
+    }
+    ASSERT_EQ(live.size(), colony.size());
+}
+
+TEST(colony_reuses_erased_slots) {
+    Memhook mh;
+    {
+        Colony<int, 64> colony;
+        std::vector<Colony<int, 64>::iterator> its;
+        for(int i = 0; i < 640; i++) {
+            its.push_back(colony.insert(i));
+        }
+        ASSERT_EQ(10ULL, colony.block_count());
+        size_t allocs = mh.n_allocs();
+
+        // erase every other element, then refill: the holes take them all
+        for(size_t i = 0; i < its.size(); i += 2) {
+            colony.erase(its[i]);
+        }
+        ASSERT_EQ(320ULL, colony.size());
+        for(int i = 0; i < 320; i++) {
+            colony.insert(-i);
+        }
+        ASSERT_EQ(640ULL, colony.size());
+        ASSERT_EQ(10ULL, colony.block_count());
+        ASSERT_EQ(allocs, mh.n_allocs());
+
+        // a block whose elements are all erased is freed
+        size_t frees = mh.n_frees();
+        for(auto it = colony.begin(); it != colony.end();) {
+            it = colony.erase(it);
+            if(colony.size() == 64 * 7) {
+                break;
+            }
+        }
+        ASSERT_EQ(7ULL, colony.block_count());
+        ASSERT_EQ(frees + 3, mh.n_frees());
+
+        colony.clear();
+        ASSERT_TRUE(colony.empty());
+        ASSERT_EQ(0ULL, colony.block_count());
+        colony.insert(5);
+        ASSERT_EQ(5, *colony.begin());
+    }
+    ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+}
@@ -0,0 +1,168 @@
+#include <list>
+#include <string>
+#include <vector>
+#include "executable.h"
+
+namespace {
+    // Shuffles a list's nodes around the heap with random inserts and erases
+    template <class ListType>
+    void churn(ListType& ll, std::list<std::string>& gt, Typegen& t, size_t ops) {
+        for(size_t op = 0; op < ops; op++) {
+            std::string value = std::to_string(t.get<int>());
+            size_t at = t.range(gt.size() + 1);
+            auto it = std::next(ll.begin(), at);
+            auto gt_it = std::next(gt.begin(), at);
+            if(t.range(3ULL) != 0 || gt.empty()) {
+                ll.insert(it, value);
+                gt.insert(gt_it, value);
+            }
+            else if(gt_it != gt.end()) {
+                ll.erase(it);
+                gt.erase(gt_it);
+            }
+        }
+    }
+
+    template <class ListType>
+    bool same(const ListType& ll, const std::list<std::string>& gt) {
+        if(ll.size() != gt.size()) {
+            return false;
+        }
+        // both directions, so the prev links are checked too
+        if(!std::equal(gt.begin(), gt.end(), ll.begin())) {
+            return false;
+        }
+        auto it = ll.end();
+        for(auto gt_it = gt.rbegin(); gt_it != gt.rend(); ++gt_it) {
+            if(*--it != *gt_it) {
+                return false;
+            }
+        }
+        return it == ll.begin();
+    }
+}
+
+TEST(compact_keeps_elements) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        List<std::string> heap;
+        List<std::string, PooledNodes<8>> pooled;
+        std::list<std::string> gt_heap, gt_pooled;
+
+        churn(heap, gt_heap, t, 150);
+        churn(pooled, gt_pooled, t, 150);
+        heap.compact();
+        pooled.compact();
+        ASSERT_TRUE(same(heap, gt_heap));
+        ASSERT_TRUE(same(pooled, gt_pooled));
+
+        // compacted lists keep working
+        churn(heap, gt_heap, t, 50);
+        churn(pooled, gt_pooled, t, 50);
+        ASSERT_TRUE(same(heap, gt_heap));
+        ASSERT_TRUE(same(pooled, gt_pooled));
+    }
+}
+
+TEST(compact_pooled_nodes_are_in_order) {
+    Typegen t;
+    List<int, PooledNodes<64>> ll;
+    std::vector<List<int, PooledNodes<64>>::iterator> its;
+    for(int i = 0; i < 4096; i++) {
+        its.push_back(ll.insert(ll.end(), i));
+    }
+    // erase and reinsert at random places until the order in memory is lost
+    for(int op = 0; op < 20000; op++) {
+        size_t a = t.range(its.size());
+        size_t b = t.range(its.size());
+        if(a == b) {
+            continue;
+        }
+        int value = *its[a];
+        ll.erase(its[a]);
+        its[a] = ll.insert(its[b], value);
+    }
+
+    ll.compact();
+
+    // walking the list now steps forward through memory, one node at a time
+    const int* prev = nullptr;
+    ptrdiff_t stride = 0;
+    size_t jumps = 0;
+    for(const int& value : ll) {
+        if(prev != nullptr) {
+            ptrdiff_t step = reinterpret_cast<const char*>(&value) - reinterpret_cast<const char*>(prev);
+            if(stride == 0) {
+                stride = step;
+            }
+            jumps += step != stride;
+        }
+        prev = &value;
+    }
+    ASSERT_TRUE(stride > 0);
+    // at most one jump from page to page
+    ASSERT_TRUE(jumps <= 4096 / 64);
+}
+
+TEST(compact_in_steps) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        List<std::string, PooledNodes<8>> ll;
+        std::list<std::string> gt;
+        churn(ll, gt, t, 100);
+
+        size_t steps = 0;
+        while(!ll.compact_step(7)) {
+            // readable between steps
+            ASSERT_TRUE(same(ll, gt));
+            steps++;
+        }
+        ASSERT_EQ(gt.size() / 7 - (gt.size() % 7 == 0 && !gt.empty() ? 1 : 0), steps);
+        ASSERT_TRUE(same(ll, gt));
+
+        // a modification in the middle of a compaction stops it
+        ll.compact_step(10);
+        churn(ll, gt, t, 20);
+        ASSERT_TRUE(same(ll, gt));
+        ll.compact_step(10);
+        ll.sort();
+        gt.sort();
+        ASSERT_TRUE(same(ll, gt));
+
+        // ... and so do moves, splices and clear
+        ll.compact_step(5);
+        List<std::string, PooledNodes<8>> moved = std::move(ll);
+        ASSERT_TRUE(same(moved, gt));
+        moved.compact_step(5);
+        ll.splice(ll.end(), moved);
+        ASSERT_TRUE(same(ll, gt));
+        ll.compact_step(5);
+        ll.clear();
+        ASSERT_TRUE(ll.empty());
+        ASSERT_TRUE(ll.compact_step(1));
+    }
+}
+
+TEST(compact_frees_old_nodes) {
+    Memhook mh;
+    {
+        List<std::string> heap;
+        List<std::string, PooledNodes<16>> pooled;
+        for(int i = 0; i < 200; i++) {
+            heap.push_back(std::string(40, 'a' + i % 26));
+            pooled.push_back(std::string(40, 'a' + i % 26));
+        }
+        size_t allocs = mh.n_allocs();
+        heap.compact();
+        pooled.compact();
+        // a node each for heap, pages of 16 for pooled, and the compaction
+        // state of each list, which is freed again; the strings are moved
+        ASSERT_EQ(allocs + 200 + 13 + 2, mh.n_allocs());
+        ASSERT_EQ(200ULL + 13 + 2, mh.n_frees());
+        ASSERT_TRUE(std::string(40, 'a') == heap.front());
+        ASSERT_TRUE(std::string(40, 'a' + 199 % 26) == pooled.back());
+    }
+    ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+}
@@ -0,0 +1,133 @@
+#include <iterator>
+#include <list>
+#include <vector>
+#include "executable.h"
+#include "IntrusiveList.h"
+
+namespace {
+    struct Item {
+        int value;
+        ListHook hook;
+        ListHook other_hook;
+    };
+
+    struct SelfUnlinking {
+        int value;
+        AutoUnlinkHook hook;
+    };
+
+    using ItemList = IntrusiveList<Item, &Item::hook>;
+}
+
+TEST(intrusive_list_matches_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::vector<Item> items(200);
+        for(size_t k = 0; k < items.size(); k++) {
+            items[k].value = static_cast<int>(k);
+        }
+
+        ItemList ll;
+        std::list<int> gt;
+        for(size_t op = 0; op < 300; op++) {
+            Item & item = items[t.range(items.size())];
+            switch(t.range(4ULL)) {
+                case 0:
+                    if(!item.hook.is_linked()) {
+                        ll.push_back(item);
+                        gt.push_back(item.value);
+                    }
+                    break;
+                case 1:
+                    if(!item.hook.is_linked()) {
+                        size_t at = t.range(gt.size() + 1);
+                        auto it = ll.insert(std::next(ll.begin(), at), item);
+                        gt.insert(std::next(gt.begin(), at), item.value);
+                        ASSERT_TRUE(&*it == &item);
+                    }
+                    break;
+                case 2:
+                    if(item.hook.is_linked()) {
+                        ll.remove(item);
+                        gt.remove(item.value);
+                        ASSERT_FALSE(item.hook.is_linked());
+                    }
+                    break;
+                case 3:
+                    if(!gt.empty()) {
+                        ASSERT_EQ(gt.front(), ll.front().value);
+                        ll.pop_front();
+                        gt.pop_front();
+                    }
+                    break;
+            }
+        }
+        ASSERT_EQ(gt.size(), ll.size());
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), ll.begin(), [](int v, Item const & item) { return v == item.value; }));
+        ASSERT_TRUE(std::equal(gt.rbegin(), gt.rend(), std::make_reverse_iterator(ll.end()),
+                               [](int v, Item const & item) { return v == item.value; }));
+
+        ItemList moved = std::move(ll);
+        ASSERT_TRUE(ll.empty());
+        ASSERT_EQ(gt.size(), moved.size());
+        moved.clear();
+        for(Item const & item : items) {
+            ASSERT_FALSE(item.hook.is_linked());
+        }
+    }
+}
+
+TEST(intrusive_list_hooks) {
+    Item a { 1, {}, {} }, b { 2, {}, {} }, c { 3, {}, {} };
+    ItemList first;
+    IntrusiveList<Item, &Item::other_hook> second;
+
+    // one object, one list per hook, and no allocation
+    {
+        Memhook mh;
+        first.push_back(a);
+        first.push_back(b);
+        second.push_back(b);
+        second.push_front(c);
+        ASSERT_EQ(0ULL, mh.n_allocs());
+    }
+    ASSERT_EQ(2ULL, first.size());
+    ASSERT_EQ(2ULL, second.size());
+    ASSERT_EQ(2, second.back().value);
+    ASSERT_EXCEPTION(first.push_back(b), std::invalid_argument);
+
+    // iterator_to and erase
+    auto it = first.erase(first.iterator_to(a));
+    ASSERT_TRUE(&*it == &b);
+    ASSERT_EQ(1ULL, first.size());
+
+    // a copy is not linked
+    Item copy = b;
+    ASSERT_FALSE(copy.hook.is_linked());
+    ASSERT_TRUE(b.hook.is_linked());
+
+    {
+        ItemList scoped;
+        scoped.push_back(a);
+    } // the list unlinks what it still holds
+    ASSERT_FALSE(a.hook.is_linked());
+}
+
+TEST(intrusive_list_auto_unlink) {
+    IntrusiveList<SelfUnlinking, &SelfUnlinking::hook> ll;
+    SelfUnlinking kept { 0, {} };
+    ll.push_back(kept);
+    {
+        SelfUnlinking temporary { 1, {} };
+        ll.push_back(temporary);
+        ll.push_front(*new SelfUnlinking { 2, {} });
+        ASSERT_EQ(3ULL, ll.size());
+    } // temporary leaves the list as it is destroyed
+    ASSERT_EQ(2ULL, ll.size());
+    ASSERT_EQ(0, ll.back().value);
+
+    delete &ll.front();
+    ASSERT_EQ(1ULL, ll.size());
+    ASSERT_TRUE(&ll.front() == &kept);
+}
@@ -0,0 +1,74 @@
+#include <list>
+#include <string>
+#include <utility>
+#include "executable.h"
+
+TEST(merge) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::list<int> gt_a(t.range(30ULL)), gt_b(t.range(30ULL));
+        for(int & v : gt_a) v = t.range(0, 20);
+        for(int & v : gt_b) v = t.range(0, 20);
+        gt_a.sort();
+        gt_b.sort();
+
+        List<int> a, b;
+        for(int v : gt_a) a.push_back(v);
+        for(int v : gt_b) b.push_back(v);
+        {
+            Memhook mh;
+            a.merge(b);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+        gt_a.merge(gt_b);
+
+        ASSERT_TRUE(b.empty());
+        ASSERT_EQ(gt_a.size(), a.size());
+        ASSERT_TRUE(std::equal(gt_a.begin(), gt_a.end(), a.begin()));
+        ASSERT_TRUE(std::equal(gt_a.rbegin(), gt_a.rend(), std::make_reverse_iterator(a.end())));
+    }
+}
+
+TEST(merge_is_stable) {
+    using Item = std::pair<int, int>; // (key, origin)
+    auto by_key = [](Item const & x, Item const & y) { return x.first < y.first; };
+
+    List<Item, PooledNodes<4>> a, b;
+    for(int k : { 1, 2, 2, 5 }) a.push_back({ k, 0 });
+    for(int k : { 0, 2, 5, 6, 6 }) b.push_back({ k, 1 });
+    a.merge(std::move(b), by_key);
+
+    std::list<Item> expected = { { 0, 1 }, { 1, 0 }, { 2, 0 }, { 2, 0 }, { 2, 1 }, { 5, 0 }, { 5, 1 }, { 6, 1 }, { 6, 1 } };
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(expected.size(), a.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), a.begin()));
+}
+
+TEST(unique) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::list<int> gt(t.range(40ULL));
+        for(int & v : gt) v = t.range(0, 4);
+
+        List<int> ll;
+        for(int v : gt) ll.push_back(v);
+
+        size_t before = gt.size();
+        gt.unique();
+        ASSERT_EQ(before - gt.size(), ll.unique());
+        ASSERT_EQ(gt.size(), ll.size());
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), ll.begin()));
+        ASSERT_TRUE(std::equal(gt.rbegin(), gt.rend(), std::make_reverse_iterator(ll.end())));
+    }
+
+    List<std::string> words;
+    for(const char* w : { "a", "A", "b", "bb", "B", "c" }) words.push_back(w);
+    size_t removed = words.unique([](std::string const & x, std::string const & y) { return tolower(x[0]) == tolower(y[0]); });
+    ASSERT_EQ(3ULL, removed);
+    ASSERT_TRUE(words.front() == "a");
+    ASSERT_TRUE(*std::next(words.begin()) == "b");
+    ASSERT_TRUE(words.back() == "c");
+}
@@ -0,0 +1,180 @@
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+#include "executable.h"
+#include "MpmcQueue.h"
+
+TEST(mpmc_queue_single_thread) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        MpmcQueue<std::string> q(t.range(1ULL, 64ULL));
+        std::deque<std::string> gt;
+        ASSERT_TRUE(q.empty());
+        ASSERT_EQ(0ULL, q.capacity() & (q.capacity() - 1));
+
+        for(size_t op = 0; op < 500; op++) {
+            if(t.range(100ULL) < 55) {
+                std::string value = std::to_string(t.get<int>());
+                bool pushed = q.try_push(value);
+                ASSERT_EQ(gt.size() < q.capacity(), pushed);
+                if(pushed) {
+                    gt.push_back(value);
+                }
+            }
+            else {
+                std::string out;
+                bool popped = q.try_pop(out);
+                ASSERT_EQ(!gt.empty(), popped);
+                if(popped) {
+                    ASSERT_TRUE(gt.front() == out);
+                    gt.pop_front();
+                }
+            }
+            ASSERT_EQ(gt.size(), q.size());
+        }
+        // the destructor destroys whatever is left
+    }
+}
+
+TEST(mpmc_queue_batches) {
+    MpmcQueue<int> q(16);
+    std::vector<int> in(40);
+    for(size_t i = 0; i < in.size(); i++) {
+        in[i] = static_cast<int>(i);
+    }
+
+    // only as many as fit
+    ASSERT_TRUE(q.try_push_range(in.begin(), in.end()) == in.begin() + 16);
+    ASSERT_TRUE(q.try_push_range(in.begin() + 16, in.end()) == in.begin() + 16);
+
+    std::vector<int> out;
+    ASSERT_EQ(10ULL, q.try_pop_up_to(std::back_inserter(out), 10));
+    for(int k = 0; k < 10; k++) {
+        ASSERT_EQ(k, out[k]);
+    }
+
+    // wraps around the end of the ring
+    ASSERT_TRUE(q.try_push_range(in.begin() + 16, in.end()) == in.begin() + 26);
+    ASSERT_EQ(16ULL, q.size());
+    ASSERT_EQ(16ULL, q.pop_up_to(std::back_inserter(out), 40));
+    for(int k = 0; k < 26; k++) {
+        ASSERT_EQ(k, out[k]);
+    }
+    ASSERT_EQ(0ULL, q.try_pop_up_to(std::back_inserter(out), 40));
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(mpmc_queue_timeouts) {
+    MpmcQueue<int> q(2);
+    int out = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_FALSE(q.try_pop_for(out, std::chrono::milliseconds(20)));
+    ASSERT_TRUE(std::chrono::steady_clock::now() - start >= std::chrono::milliseconds(20));
+
+    ASSERT_TRUE(q.try_push_for(1, std::chrono::milliseconds(20)));
+    ASSERT_TRUE(q.try_push_for(2, std::chrono::milliseconds(20)));
+    ASSERT_FALSE(q.try_push_for(3, std::chrono::milliseconds(20)));
+
+    // a consumer that frees a slot while the producer is parked
+    std::thread consumer([&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        int value;
+        q.pop(value);
+    });
+    ASSERT_TRUE(q.try_push_for(3, std::chrono::seconds(10)));
+    consumer.join();
+
+    ASSERT_TRUE(q.try_pop_for(out, std::chrono::milliseconds(20)));
+    ASSERT_EQ(2, out);
+    ASSERT_TRUE(q.try_pop_until(out, std::chrono::steady_clock::now() + std::chrono::milliseconds(20)));
+    ASSERT_EQ(3, out);
+}
+
+TEST(mpmc_queue_many_threads) {
+    const size_t producers = 4;
+    const size_t consumers = 4;
+    const size_t per_producer = 50000;
+
+    // small, so producers and consumers keep parking on each other
+    MpmcQueue<size_t> q(8);
+    std::vector<std::vector<size_t>> received(consumers);
+    std::atomic<size_t> remaining{producers * per_producer};
+
+    std::vector<std::thread> threads;
+    for(size_t c = 0; c < consumers; c++) {
+        threads.emplace_back([&, c] {
+            size_t batch[4];
+            while(remaining.load() > 0) {
+                size_t n = 0;
+                if(c % 2 == 0) {
+                    size_t value;
+                    if(q.try_pop_for(value, std::chrono::milliseconds(1))) {
+                        batch[n++] = value;
+                    }
+                }
+                else {
+                    n = q.try_pop_up_to(batch, 4);
+                    if(n == 0) {
+                        size_t value;
+                        if(q.try_pop_for(value, std::chrono::milliseconds(1))) {
+                            batch[n++] = value;
+                        }
+                    }
+                }
+                for(size_t k = 0; k < n; k++) {
+                    received[c].push_back(batch[k]);
+                }
+                remaining -= n;
+            }
+        });
+    }
+    for(size_t p = 0; p < producers; p++) {
+        threads.emplace_back([&, p] {
+            size_t first = p * per_producer;
+            for(size_t i = 0; i < per_producer; i++) {
+                if(i % 7 == 0 && i + 3 <= per_producer) {
+                    size_t batch[3] = { first + i, first + i + 1, first + i + 2 };
+                    q.push_range(batch, batch + 3);
+                    i += 2;
+                }
+                else {
+                    q.push(first + i);
+                }
+            }
+        });
+    }
+    for(std::thread& thread : threads) {
+        thread.join();
+    }
+
+    // every value arrived exactly once, and each producer's values in order per consumer
+    std::vector<char> seen(producers * per_producer, 0);
+    size_t duplicates = 0;
+    size_t out_of_order = 0;
+    for(const std::vector<size_t>& values : received) {
+        std::vector<size_t> last(producers, 0);
+        std::vector<bool> any(producers, false);
+        for(size_t value : values) {
+            duplicates += seen[value]++;
+            size_t p = value / per_producer;
+            if(any[p] && value < last[p]) {
+                out_of_order++;
+            }
+            any[p] = true;
+            last[p] = value;
+        }
+    }
+    size_t missing = 0;
+    for(char s : seen) {
+        missing += s == 0;
+    }
+    ASSERT_EQ(0ULL, duplicates);
+    ASSERT_EQ(0ULL, missing);
+    ASSERT_EQ(0ULL, out_of_order);
+    ASSERT_TRUE(q.empty());
+}
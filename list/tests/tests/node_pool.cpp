@@ -0,0 +1,160 @@
+#include <fstream>
+#include <list>
+#include <sstream>
+#include <string>
+#include "executable.h"
+
+using PooledList = List<int, PooledNodes<16>>;
+
+TEST(node_pool_matches_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        PooledList ll;
+        std::list<int> gt_ll;
+
+        for(size_t op = 0; op < 200; op++) {
+            int value = t.get<int>();
+            switch(t.range(4ULL)) {
+                case 0: ll.push_back(value); gt_ll.push_back(value); break;
+                case 1: ll.push_front(value); gt_ll.push_front(value); break;
+                case 2: if(!gt_ll.empty()) { ll.pop_back(); gt_ll.pop_back(); } break;
+                case 3: if(!gt_ll.empty()) { ll.pop_front(); gt_ll.pop_front(); } break;
+            }
+        }
+
+        ASSERT_EQ(gt_ll.size(), ll.size());
+        ASSERT_TRUE(std::equal(gt_ll.begin(), gt_ll.end(), ll.begin()));
+
+        PooledList copy = ll;
+        PooledList moved = std::move(ll);
+        ASSERT_TRUE(ll.empty());
+        ASSERT_TRUE(std::equal(gt_ll.begin(), gt_ll.end(), copy.begin()));
+        ASSERT_TRUE(std::equal(gt_ll.begin(), gt_ll.end(), moved.begin()));
+
+        // iterator and const_iterator still compare across types
+        PooledList::const_iterator cend = moved.cend();
+        ASSERT_TRUE(moved.end() == cend);
+    }
+}
+
+TEST(node_pool_allocates_pages) {
+    {
+        Memhook mh;
+        PooledList ll;
+        for(int i = 0; i < 40; i++) {
+            ll.push_back(i);
+        }
+        // 40 nodes on pages of 16
+        ASSERT_EQ(3ULL, mh.n_allocs());
+
+        // churn reuses freed slots
+        for(int i = 0; i < 1000; i++) {
+            ll.pop_front();
+            ll.push_back(i);
+        }
+        ASSERT_EQ(3ULL, mh.n_allocs());
+        ASSERT_EQ(0ULL, mh.n_frees());
+
+        // the pool moves with the list
+        PooledList moved = std::move(ll);
+        moved.push_back(-1);
+        ASSERT_EQ(3ULL, mh.n_allocs());
+
+        // clear() of trivially destructible elements frees whole pages
+        moved.clear();
+        ASSERT_EQ(3ULL, mh.n_frees());
+        ASSERT_TRUE(moved.empty());
+        moved.push_back(1);
+        ASSERT_EQ(1, moved.front());
+    }
+    {
+        // non trivial elements are destroyed one by one and their slots reused
+        List<std::string, PooledNodes<4>> strings;
+        std::string long_string(100, 'x');
+        for(int i = 0; i < 10; i++) {
+            strings.push_back(long_string);
+        }
+        strings.erase(++strings.begin());
+        strings.push_front("front");
+        ASSERT_EQ(10ULL, strings.size());
+        ASSERT_TRUE(strings.front() == "front");
+        strings.clear();
+        ASSERT_TRUE(strings.empty());
+    }
+}
+
+TEST(node_pool_thread_cache) {
+    using CachedList = List<int, PooledNodes<16, true>>;
+    {
+        CachedList warm;
+        for(int i = 0; i < 32; i++) {
+            warm.push_back(i);
+        }
+    } // the two pages go to this thread's cache
+
+    Memhook mh;
+    CachedList ll;
+    for(int i = 0; i < 32; i++) {
+        ll.push_back(i);
+    }
+    ASSERT_EQ(0ULL, mh.n_allocs());
+    ll.clear();
+    ASSERT_EQ(0ULL, mh.n_frees());
+}
+
+TEST(node_pool_adopt_splices_pages_and_free_slots) {
+    Memhook mh;
+    {
+        PooledList ll;
+        size_t pages = 0;
+        for(int round = 0; round < 20; round++) {
+            // each donor has a partly used newest page and a few freed slots
+            PooledList donor;
+            for(int i = 0; i < 40; i++) {
+                donor.push_back(i);
+            }
+            for(int i = 0; i < 5; i++) {
+                donor.pop_front();
+            }
+            pages += 3;
+            if(round % 2 == 1) {
+                ll.pop_back(); // and ll sometimes has freed slots of its own
+            }
+            ll.splice(ll.end(), donor);
+            ASSERT_TRUE(donor.empty());
+            ASSERT_EQ(pages, mh.n_allocs());
+        }
+
+        // every slot the donors freed or never used is handed out before a new page
+        size_t live = ll.size();
+        for(size_t i = live; i < pages * 16; i++) {
+            ll.push_back(0);
+        }
+        ASSERT_EQ(pages, mh.n_allocs());
+        ll.push_back(0);
+        ASSERT_EQ(pages + 1, mh.n_allocs());
+    }
+    // and every adopted page is still on the page list
+    ASSERT_EQ(mh.n_allocs(), mh.n_frees());
+}
+
+namespace {
+    // The contents of a file, empty if it can't be read
+    std::string read_file(const char* path) {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+}
+
+// NodePool.h is copied into list, binary_search_tree and unordered_map, so
+// a fix to one copy has to reach the others. Paths are relative to tests/.
+TEST(node_pool_header_matches_other_modules) {
+    const std::string mine = read_file("../src/NodePool.h");
+    ASSERT_FALSE(mine.empty());
+    for(const char* other : { "../../binary_search_tree/src/NodePool.h", "../../unordered_map/src/NodePool.h" }) {
+        ASSERT_TRUE(read_file(other) == mine);
+    }
+}
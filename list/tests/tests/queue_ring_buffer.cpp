@@ -0,0 +1,77 @@
+#include "executable.h"
+#include "Queue.h"
+
+#include <vector>
+
+TEST(queue_ring_buffer) {
+    Typegen t;
+
+    for (size_t i = 0; i < TEST_ITER; i++) {
+        // Generate a reference vector
+        const size_t n = t.range(1ULL, 0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+        RingQueue<int> q;
+
+        for (size_t j = 0; j < n; j++) {
+            q.push(gt[j]);
+            ASSERT_EQ(gt[j], q.back());
+        }
+        ASSERT_EQ(n, q.size());
+
+        // Iteration goes from the front to the back
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), q.begin()));
+
+        {
+            // Steady push and pop does not allocate
+            Memhook mh;
+            for (size_t j = 0; j < n; j++) {
+                ASSERT_EQ(gt[j], q.front());
+                q.pop();
+                q.push(gt[j]);
+            }
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), q.begin()));
+    }
+}
+
+TEST(queue_equality_does_not_copy) {
+    Typegen t;
+
+    for (size_t i = 0; i < TEST_ITER; i++) {
+        const size_t n = t.range(1ULL, 0x999ULL);
+        std::vector<int> gt(n);
+        t.fill(gt.begin(), gt.end());
+
+        Queue<int> q1, q2;
+        RingQueue<int> r1, r2;
+        for (size_t j = 0; j < n; j++) {
+            q1.push(gt[j]);
+            q2.push(gt[j]);
+            r1.push(gt[j]);
+            r2.push(gt[j]);
+        }
+
+        {
+            Memhook mh;
+            ASSERT_EQ(true, q1 == q2);
+            ASSERT_EQ(true, r1 == r2);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+        }
+
+        // Differ in the last element only
+        q2.push(1);
+        q1.push(2);
+        r2.push(1);
+        r1.push(2);
+        ASSERT_EQ(false, q1 == q2);
+        ASSERT_EQ(false, r1 == r2);
+
+        // The const back returns the last element
+        const RingQueue<int>& cr = r1;
+        const Queue<int>& cq = q1;
+        ASSERT_EQ(2, cr.back());
+        ASSERT_EQ(2, cq.back());
+    }
+}
@@ -0,0 +1,99 @@
+#include <deque>
+#include <string>
+#include "executable.h"
+#include "RingBuffer.h"
+
+TEST(ring_buffer_matches_deque) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        RingBuffer<int> rb;
+        std::deque<int> gt;
+
+        for(size_t op = 0; op < 1000; op++) {
+            // bursts of pushes and pops so the buffer wraps, grows and shrinks
+            if(t.range(100ULL) < (op % 200 < 100 ? 70ULL : 30ULL)) {
+                int value = t.get<int>();
+                rb.push_back(value);
+                gt.push_back(value);
+                ASSERT_EQ(value, rb.back());
+            }
+            else if(!gt.empty()) {
+                ASSERT_EQ(gt.front(), rb.front());
+                rb.pop_front();
+                gt.pop_front();
+            }
+            ASSERT_EQ(gt.size(), rb.size());
+            // the capacity stays a power of two
+            ASSERT_EQ(0ULL, rb.capacity() & (rb.capacity() - 1));
+            ASSERT_TRUE(rb.capacity() == 0 || rb.capacity() >= rb.watermark());
+        }
+
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), rb.begin()));
+        for(size_t k = 0; k < gt.size(); k++) {
+            ASSERT_EQ(gt[k], rb[k]);
+        }
+        ASSERT_EQ(static_cast<std::ptrdiff_t>(gt.size()), rb.end() - rb.begin());
+
+        RingBuffer<int> copy = rb;
+        RingBuffer<int> moved = std::move(rb);
+        ASSERT_TRUE(rb.empty());
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), copy.cbegin()));
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), moved.cbegin()));
+    }
+}
+
+TEST(ring_buffer_allocations) {
+    Memhook mh;
+    RingBuffer<int> rb;
+    rb.set_watermark(32);
+
+    // fill to 100 once: 32 -> 64 -> 128
+    for(int i = 0; i < 100; i++) {
+        rb.push_back(i);
+    }
+    ASSERT_EQ(128ULL, rb.capacity());
+    ASSERT_EQ(3ULL, mh.n_allocs());
+
+    // steady churn reuses the array
+    for(int i = 0; i < 10000; i++) {
+        rb.pop_front();
+        rb.push_back(i);
+    }
+    ASSERT_EQ(3ULL, mh.n_allocs());
+    ASSERT_EQ(2ULL, mh.n_frees());
+
+    // draining shrinks it, but not below the watermark
+    while(!rb.empty()) {
+        rb.pop_front();
+    }
+    ASSERT_EQ(32ULL, rb.capacity());
+
+    ASSERT_EXCEPTION(rb.at(0), std::out_of_range);
+}
+
+TEST(ring_buffer_non_trivial) {
+    RingBuffer<std::string> rb;
+    std::deque<std::string> gt;
+    std::string long_string(100, 'x');
+    for(int i = 0; i < 500; i++) {
+        rb.push_back(long_string + std::to_string(i));
+        gt.push_back(long_string + std::to_string(i));
+        if(i % 3 == 0) {
+            rb.pop_front();
+            gt.pop_front();
+        }
+    }
+    // pushing one of its own elements while it grows
+    while(rb.size() != rb.capacity()) {
+        rb.push_back(rb.front());
+        gt.push_back(gt.front());
+    }
+    rb.push_back(rb.front());
+    gt.push_back(gt.front());
+
+    ASSERT_EQ(gt.size(), rb.size());
+    ASSERT_TRUE(std::equal(gt.begin(), gt.end(), rb.begin()));
+    rb.clear();
+    ASSERT_TRUE(rb.empty());
+}
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <functional>
+#include <list>
+#include <utility>
+#include "executable.h"
+
+namespace {
+    template<typename L>
+    bool same(std::list<int> const & gt, L const & ll) {
+        return gt.size() == ll.size()
+            && std::equal(gt.begin(), gt.end(), ll.begin())
+            && std::equal(gt.rbegin(), gt.rend(), std::make_reverse_iterator(ll.end()));
+    }
+}
+
+TEST(sort_random) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::list<int> gt(t.range(300ULL));
+        for(int & v : gt) v = t.range(0, 50);
+
+        List<int> ll;
+        for(int v : gt) ll.push_back(v);
+        List<int>::iterator first = ll.begin();
+        int first_value = ll.empty() ? 0 : *first;
+        {
+            Memhook mh;
+            ll.sort();
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+        gt.sort();
+        ASSERT_TRUE(same(gt, ll));
+
+        // nodes were relinked, not copied
+        if(!gt.empty()) {
+            ASSERT_EQ(first_value, *first);
+        }
+
+        ll.sort(std::greater<int>());
+        gt.sort(std::greater<int>());
+        ASSERT_TRUE(same(gt, ll));
+    }
+}
+
+TEST(sort_runs) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        // ascending, descending and constant stretches
+        std::list<int> gt;
+        size_t runs = t.range(1ULL, 10ULL);
+        for(size_t r = 0; r < runs; r++) {
+            int start = t.range(-100, 100);
+            int step = t.range(-2, 3);
+            size_t length = t.range(1ULL, 50ULL);
+            for(size_t k = 0; k < length; k++) {
+                gt.push_back(start + step * static_cast<int>(k));
+            }
+        }
+
+        List<int, PooledNodes<>> ll;
+        for(int v : gt) ll.push_back(v);
+        ll.sort();
+        gt.sort();
+        ASSERT_TRUE(same(gt, ll));
+    }
+
+    List<int> ordered, reversed;
+    for(int k = 0; k < 1000; k++) {
+        ordered.push_back(k);
+        reversed.push_front(k);
+    }
+    ordered.sort();
+    reversed.sort();
+    ASSERT_TRUE(std::equal(ordered.begin(), ordered.end(), reversed.begin()));
+    ASSERT_TRUE(std::is_sorted(reversed.begin(), reversed.end()));
+}
+
+TEST(sort_is_stable) {
+    Typegen t;
+    using Item = std::pair<int, int>; // (key, original position)
+    auto by_key = [](Item const & x, Item const & y) { return x.first < y.first; };
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        List<Item> ll;
+        std::list<Item> gt;
+        size_t n = t.range(200ULL);
+        for(size_t k = 0; k < n; k++) {
+            // long descending stretches of equal keys must not be reversed
+            Item item = { t.range(0, 3) == 0 ? 7 : t.range(0, 10), static_cast<int>(k) };
+            ll.push_back(item);
+            gt.push_back(item);
+        }
+        ll.sort(by_key);
+        gt.sort(by_key);
+        ASSERT_EQ(gt.size(), ll.size());
+        ASSERT_TRUE(std::equal(gt.begin(), gt.end(), ll.begin()));
+    }
+}
@@ -0,0 +1,121 @@
+#include <iterator>
+#include <list>
+#include "executable.h"
+
+namespace {
+    template<typename L>
+    L from_list(std::list<int> const & values) {
+        L ll;
+        for(int v : values) {
+            ll.push_back(v);
+        }
+        return ll;
+    }
+}
+
+TEST(splice_whole_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::list<int> gt_a(t.range(20ULL)), gt_b(t.range(20ULL));
+        t.fill(gt_a.begin(), gt_a.end());
+        t.fill(gt_b.begin(), gt_b.end());
+        List<int> a = from_list<List<int>>(gt_a);
+        List<int> b = from_list<List<int>>(gt_b);
+
+        size_t offset = t.range(gt_a.size() + 1);
+        List<int>::iterator b_first = b.begin();
+        bool b_had_nodes = !gt_b.empty();
+        int b_front = b_had_nodes ? gt_b.front() : 0;
+        {
+            Memhook mh;
+            a.splice(std::next(a.begin(), offset), b);
+            ASSERT_EQ(0ULL, mh.n_allocs());
+            ASSERT_EQ(0ULL, mh.n_frees());
+        }
+        gt_a.splice(std::next(gt_a.begin(), offset), gt_b);
+
+        ASSERT_TRUE(b.empty());
+        ASSERT_TRUE(b.begin() == b.end());
+        ASSERT_EQ(gt_a.size(), a.size());
+        ASSERT_TRUE(std::equal(gt_a.begin(), gt_a.end(), a.begin()));
+        ASSERT_TRUE(std::equal(gt_a.rbegin(), gt_a.rend(), std::make_reverse_iterator(a.end())));
+
+        // iterators into b now refer into a
+        if(b_had_nodes) {
+            ASSERT_EQ(b_front, *b_first);
+        }
+    }
+}
+
+TEST(splice_element_and_range) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        std::list<int> gt_a(t.range(1ULL, 20ULL)), gt_b(t.range(1ULL, 20ULL));
+        t.fill(gt_a.begin(), gt_a.end());
+        t.fill(gt_b.begin(), gt_b.end());
+        List<int> a = from_list<List<int>>(gt_a);
+        List<int> b = from_list<List<int>>(gt_b);
+
+        // one element from b
+        size_t from = t.range(gt_b.size());
+        size_t to = t.range(gt_a.size() + 1);
+        List<int>::iterator moved = std::next(b.begin(), from);
+        a.splice(std::next(a.begin(), to), b, moved);
+        gt_a.splice(std::next(gt_a.begin(), to), gt_b, std::next(gt_b.begin(), from));
+        ASSERT_EQ(gt_b.size(), b.size());
+        ASSERT_TRUE(std::equal(gt_b.begin(), gt_b.end(), b.begin()));
+        ASSERT_TRUE(std::equal(gt_a.begin(), gt_a.end(), a.begin()));
+        ASSERT_EQ(*std::next(gt_a.begin(), to), *moved);
+
+        // a range from b
+        size_t first = t.range(gt_b.size() + 1);
+        size_t last = first + t.range(gt_b.size() - first + 1);
+        to = t.range(gt_a.size() + 1);
+        a.splice(std::next(a.begin(), to), b, std::next(b.begin(), first), std::next(b.begin(), last));
+        gt_a.splice(std::next(gt_a.begin(), to), gt_b, std::next(gt_b.begin(), first), std::next(gt_b.begin(), last));
+        ASSERT_EQ(gt_a.size(), a.size());
+        ASSERT_EQ(gt_b.size(), b.size());
+        ASSERT_TRUE(std::equal(gt_a.begin(), gt_a.end(), a.begin()));
+        ASSERT_TRUE(std::equal(gt_b.begin(), gt_b.end(), b.begin()));
+
+        // a range within a, moved to the front
+        if(gt_a.size() > 2) {
+            first = 1 + t.range(gt_a.size() - 1);
+            last = first + t.range(gt_a.size() - first + 1);
+            a.splice(a.begin(), a, std::next(a.begin(), first), std::next(a.begin(), last));
+            gt_a.splice(gt_a.begin(), gt_a, std::next(gt_a.begin(), first), std::next(gt_a.begin(), last));
+            ASSERT_EQ(gt_a.size(), a.size());
+            ASSERT_TRUE(std::equal(gt_a.begin(), gt_a.end(), a.begin()));
+            ASSERT_TRUE(std::equal(gt_a.rbegin(), gt_a.rend(), std::make_reverse_iterator(a.end())));
+        }
+    }
+}
+
+TEST(splice_pooled) {
+    using PooledList = List<int, PooledNodes<4>>;
+    PooledList a = from_list<PooledList>({ 1, 2, 3 });
+    PooledList b = from_list<PooledList>({ 4, 5, 6, 7, 8, 9 });
+    {
+        // the whole list comes with its pool, so nothing is allocated
+        Memhook mh;
+        a.splice(a.end(), b);
+        ASSERT_EQ(0ULL, mh.n_allocs());
+    }
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(9ULL, a.size());
+    b.push_back(10);
+
+    // part of a pooled list moves into new nodes
+    a.splice(a.begin(), b, b.begin());
+    a.splice(a.end(), a, a.begin(), std::next(a.begin(), 2));
+    std::list<int> expected = { 2, 3, 4, 5, 6, 7, 8, 9, 10, 1 };
+    ASSERT_TRUE(b.empty());
+    ASSERT_EQ(expected.size(), a.size());
+    ASSERT_TRUE(std::equal(expected.begin(), expected.end(), a.begin()));
+
+    a.clear();
+    b = from_list<PooledList>({ 1 });
+    ASSERT_EQ(1, b.front());
+}
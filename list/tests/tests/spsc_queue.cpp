@@ -0,0 +1,141 @@
+#include <atomic>
+#include <deque>
+#include <string>
+#include <thread>
+#include <vector>
+#include "executable.h"
+#include "SpscQueue.h"
+
+TEST(spsc_queue_single_thread) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        SpscQueue<std::string> q(t.range(1ULL, 64ULL));
+        std::deque<std::string> gt;
+        ASSERT_TRUE(q.empty());
+        // rounded up to a power of two
+        ASSERT_EQ(0ULL, q.capacity() & (q.capacity() - 1));
+
+        for(size_t op = 0; op < 500; op++) {
+            if(t.range(100ULL) < 55) {
+                std::string value = std::to_string(t.get<int>());
+                bool pushed = q.try_push(value);
+                ASSERT_EQ(gt.size() < q.capacity(), pushed);
+                if(pushed) {
+                    gt.push_back(value);
+                }
+            }
+            else if(!gt.empty()) {
+                ASSERT_TRUE(gt.front() == q.front());
+                q.pop();
+                gt.pop_front();
+            }
+            else {
+                std::string out;
+                ASSERT_FALSE(q.try_pop(out));
+            }
+            ASSERT_EQ(gt.size(), q.size());
+            ASSERT_EQ(gt.empty(), q.empty());
+        }
+        // the destructor destroys whatever is left
+    }
+}
+
+TEST(spsc_queue_batches) {
+    SpscQueue<int> q(16);
+    std::vector<int> in(40);
+    for(size_t i = 0; i < in.size(); i++) {
+        in[i] = static_cast<int>(i);
+    }
+
+    // only as many as fit
+    ASSERT_EQ(16ULL, q.push_n(in.data(), in.size()));
+    ASSERT_EQ(0ULL, q.push_n(in.data() + 16, 24));
+
+    int out[40];
+    ASSERT_EQ(10ULL, q.pop_n(out, 10));
+    for(int k = 0; k < 10; k++) {
+        ASSERT_EQ(k, out[k]);
+    }
+
+    // wraps around the end of the ring
+    ASSERT_EQ(10ULL, q.push_n(in.data() + 16, 24));
+    ASSERT_EQ(16ULL, q.size());
+    ASSERT_EQ(16ULL, q.pop_n(out, 40));
+    for(int k = 0; k < 16; k++) {
+        ASSERT_EQ(k + 10, out[k]);
+    }
+    ASSERT_EQ(0ULL, q.pop_n(out, 40));
+    ASSERT_TRUE(q.empty());
+}
+
+TEST(spsc_queue_allocations) {
+    Memhook mh;
+    {
+        SpscQueue<int> q(1000);
+        for(int k = 0; k < 100000; k++) {
+            q.push(k);
+            q.pop();
+        }
+    }
+    // one array for the whole life of the queue
+    ASSERT_EQ(1ULL, mh.n_allocs());
+    ASSERT_EQ(1ULL, mh.n_frees());
+}
+
+TEST(spsc_queue_two_threads) {
+    const size_t count = 200000;
+    SpscQueue<size_t> q(64);
+    std::atomic<size_t> out_of_order{0};
+
+    std::thread consumer([&] {
+        size_t expected = 0;
+        size_t batch[32];
+        while(expected < count) {
+            if(expected % 3 == 0) {
+                size_t n = q.pop_n(batch, 32);
+                for(size_t k = 0; k < n; k++) {
+                    if(batch[k] != expected++) {
+                        out_of_order++;
+                    }
+                }
+                if(n == 0) {
+                    std::this_thread::yield();
+                }
+            }
+            else if(!q.empty()) {
+                if(q.front() != expected++) {
+                    out_of_order++;
+                }
+                q.pop();
+            }
+            else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    size_t next = 0;
+    size_t batch[16];
+    while(next < count) {
+        if(next % 5 == 0) {
+            size_t n = 0;
+            while(n < 16 && next + n < count) {
+                batch[n] = next + n;
+                n++;
+            }
+            size_t pushed = q.push_n(batch, n);
+            next += pushed;
+            if(pushed == 0) {
+                std::this_thread::yield();
+            }
+        }
+        else {
+            q.push(next++);
+        }
+    }
+    consumer.join();
+
+    ASSERT_EQ(0ULL, out_of_order.load());
+    ASSERT_TRUE(q.empty());
+}
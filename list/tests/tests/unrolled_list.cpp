@@ -0,0 +1,128 @@
+#include <iterator>
+#include <list>
+#include <string>
+#include "executable.h"
+#include "UnrolledList.h"
+
+namespace {
+    template<typename L, typename GT>
+    bool same(GT const & gt, L const & ll) {
+        return gt.size() == ll.size()
+            && std::equal(gt.begin(), gt.end(), ll.begin())
+            && std::equal(gt.rbegin(), gt.rend(), std::make_reverse_iterator(ll.end()));
+    }
+}
+
+TEST(unrolled_list_matches_list) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        // small blocks so that splits and merges happen often
+        UnrolledList<int, 1> ll;
+        std::list<int> gt;
+
+        for(size_t op = 0; op < 500; op++) {
+            int value = t.get<int>();
+            size_t choice = t.range(6ULL);
+            if(choice < 3) {
+                size_t at = t.range(gt.size() + 1);
+                auto it = ll.insert(std::next(ll.cbegin(), at), value);
+                gt.insert(std::next(gt.begin(), at), value);
+                ASSERT_EQ(value, *it);
+            }
+            else if(choice == 3) {
+                ll.push_front(value);
+                gt.push_front(value);
+            }
+            else if(!gt.empty()) {
+                size_t at = t.range(gt.size());
+                auto it = ll.erase(std::next(ll.cbegin(), at));
+                auto gt_it = gt.erase(std::next(gt.begin(), at));
+                ASSERT_TRUE((gt_it == gt.end()) == (it == ll.end()));
+                if(gt_it != gt.end()) {
+                    ASSERT_EQ(*gt_it, *it);
+                }
+            }
+        }
+        ASSERT_TRUE(same(gt, ll));
+
+        // apart from the last one, every block is at least half full
+        if(!gt.empty()) {
+            size_t half = UnrolledList<int, 1>::block_capacity / 2;
+            ASSERT_TRUE(ll.block_count() <= gt.size() / half + 1);
+        }
+
+        UnrolledList<int, 1> copy = ll;
+        UnrolledList<int, 1> moved = std::move(ll);
+        ASSERT_TRUE(ll.empty());
+        ASSERT_TRUE(ll.begin() == ll.end());
+        ASSERT_TRUE(same(gt, copy));
+        ASSERT_TRUE(same(gt, moved));
+
+        while(!gt.empty()) {
+            if(t.range(2ULL) == 0) {
+                ASSERT_EQ(gt.back(), moved.back());
+                moved.pop_back();
+                gt.pop_back();
+            }
+            else {
+                ASSERT_EQ(gt.front(), moved.front());
+                moved.pop_front();
+                gt.pop_front();
+            }
+        }
+        ASSERT_TRUE(moved.empty());
+        ASSERT_EQ(0ULL, moved.block_count());
+    }
+}
+
+TEST(unrolled_list_blocks) {
+    using IntList = UnrolledList<int>;
+    // two cache lines less the header
+    ASSERT_EQ(26ULL, IntList::block_capacity);
+
+    Memhook mh;
+    IntList ll;
+    for(int i = 0; i < 260; i++) {
+        ll.push_back(i);
+    }
+    // appending fills every block
+    ASSERT_EQ(10ULL, ll.block_count());
+    ASSERT_EQ(10ULL, mh.n_allocs());
+
+    int expected = 0;
+    for(IntList::const_iterator it = ll.cbegin(); it != ll.cend(); ++it) {
+        ASSERT_EQ(expected++, *it);
+    }
+
+    ll.clear();
+    ASSERT_EQ(10ULL, mh.n_frees());
+    ASSERT_TRUE(ll.empty());
+}
+
+TEST(unrolled_list_non_trivial) {
+    Typegen t;
+    UnrolledList<std::string, 1> ll;
+    std::list<std::string> gt;
+    for(size_t op = 0; op < 2000; op++) {
+        std::string value(t.range(0ULL, 40ULL), static_cast<char>('a' + op % 26));
+        if(t.range(3ULL) != 0 || gt.empty()) {
+            size_t at = t.range(gt.size() + 1);
+            ll.insert(std::next(ll.begin(), at), value);
+            gt.insert(std::next(gt.begin(), at), value);
+        }
+        else {
+            size_t at = t.range(gt.size());
+            ll.erase(std::next(ll.begin(), at));
+            gt.erase(std::next(gt.begin(), at));
+        }
+    }
+    ASSERT_TRUE(same(gt, ll));
+
+    // inserting an element of the list itself
+    ll.push_back(ll.front());
+    gt.push_back(gt.front());
+    ll.insert(ll.begin(), ll.back());
+    gt.insert(gt.begin(), gt.back());
+    ASSERT_TRUE(same(gt, ll));
+}
@@ -0,0 +1,78 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "sorting.h"
+#include "bench.h"
+
+/*
+    sort::insertion on the assignment's input files, with the memmove path
+    for contiguous plain data against the original swap-based loop
+    (sort::detail::insertion_by_swaps), which every other range still uses.
+
+    USAGE: ./build/insertion [input-files directory]
+        the directory defaults to ../input-files
+
+    Both versions make the same comparisons; the counts are printed to
+    show it.
+*/
+
+namespace {
+
+    std::vector<int> read_file(const std::string& path) {
+        std::ifstream file(path);
+        std::vector<int> data;
+        int value;
+        while (file >> value) {
+            data.push_back(value);
+        }
+        return data;
+    }
+
+    struct Counting {
+        size_t* comparisons;
+        bool operator()(int a, int b) const {
+            (*comparisons)++;
+            return a < b;
+        }
+    };
+}
+
+int main(int argc, char** argv) {
+    std::string dir = argc > 1 ? argv[1] : "../input-files";
+    const char* names[] = { "rand10k", "randdup10k", "reverse10k", "ordered10k", "rand1k", "reverse1k" };
+
+    bench::header("insertion sort, swaps vs memmove shifts");
+    for (const char* name : names) {
+        std::vector<int> input = read_file(dir + "/" + name + ".dat");
+        if (input.empty()) {
+            std::cerr << "could not read " << dir << "/" << name << ".dat" << std::endl;
+            return 1;
+        }
+
+        size_t swap_comparisons = 0, shift_comparisons = 0;
+        std::vector<int> work;
+        double t_swaps = bench::seconds_per_run([&] {
+            work = input;
+            swap_comparisons = 0;
+            sort::detail::insertion_by_swaps(work.begin(), work.end(), Counting{ &swap_comparisons });
+        });
+        double t_shifts = bench::seconds_per_run([&] {
+            work = input;
+            shift_comparisons = 0;
+            sort::insertion(work.begin(), work.end(), Counting{ &shift_comparisons });
+        });
+
+        std::cout << name << " (" << input.size() << " ints, " << shift_comparisons << " comparisons"
+                  << (shift_comparisons == swap_comparisons ? "" : ", MISMATCH") << ")" << std::endl;
+        bench::report("  swaps", t_swaps * 1e3, "ms");
+        bench::report("  memmove", t_shifts * 1e3, "ms");
+        bench::report("  speedup", t_swaps / t_shifts, "x");
+        if (shift_comparisons != swap_comparisons) {
+            return 1;
+        }
+    }
+    return 0;
+}
@@ -1,7 +1,12 @@
 #pragma once
 
+#include <cstddef> // size_t
+#include <cstring> // std::memmove
 #include <functional> // std::less
 #include <iterator> // std::iterator_traits
+#include <string>
+#include <type_traits> // std::is_trivially_copyable, std::void_t
+#include <vector>
 
 namespace sort {
 
@@ -27,6 +32,75 @@ namespace sort {
 
 	}
 
+	namespace detail {
+		template<typename Iter, typename T = typename std::iterator_traits<Iter>::value_type>
+		constexpr bool is_std_contiguous_iterator = !std::is_same<T, bool>::value &&
+			(std::is_same<Iter, typename std::vector<T>::iterator>::value ||
+			 std::is_same<Iter, typename std::vector<T>::const_iterator>::value ||
+			 std::is_same<Iter, std::string::iterator>::value ||
+			 std::is_same<Iter, std::string::const_iterator>::value);
+	}
+
+	// True when the elements an iterator walks are adjacent in memory, so
+	// a block of them can be moved with one memmove. Pointers and the
+	// iterators of std::vector and std::string are contiguous. Other
+	// iterators opt in with a member alias (Vector and Vector_Basic do):
+	//     using is_contiguous = std::true_type;
+	template<typename Iter, typename = void>
+	struct is_contiguous_iterator
+		: std::integral_constant<bool, std::is_pointer<Iter>::value || detail::is_std_contiguous_iterator<Iter>> {};
+
+	template<typename Iter>
+	struct is_contiguous_iterator<Iter, std::void_t<typename Iter::is_contiguous>> : Iter::is_contiguous {};
+
+	namespace detail {
+		// Insertion sort by adjacent swaps, for any random access iterator
+		template<typename RandomIter, typename Comparator>
+		void insertion_by_swaps(RandomIter begin, RandomIter end, Comparator comp) {
+			//if the list isn't empty
+			if (begin != end) {
+				//loops through the entire array
+				for (RandomIter i = begin + 1; i != end; i++) {
+					//iterator one behind the outer loop
+					for (RandomIter r = i; r > begin; r--) {
+						if (comp(*r, *(r - 1))) {
+							swap(*r, *(r - 1));
+						}
+						else {
+							break;
+						}
+					}
+				}
+			}
+		}
+
+		// Insertion sort over contiguous, trivially copyable elements. It makes
+		// exactly the comparisons insertion_by_swaps makes, but holds the
+		// element being inserted aside and moves the larger ones up one slot
+		// with a single memmove instead of swapping it down one step at a time.
+		template<typename RandomIter, typename Comparator>
+		void insertion_by_shifts(RandomIter begin, RandomIter end, Comparator comp) {
+			using T = typename std::iterator_traits<RandomIter>::value_type;
+
+			if (begin == end) {
+				return;
+			}
+			T* base = &*begin;
+			const size_t n = end - begin;
+			for (size_t i = 1; i < n; i++) {
+				T value = base[i];
+				size_t pos = i;
+				while (pos > 0 && comp(value, base[pos - 1])) {
+					pos--;
+				}
+				if (pos != i) {
+					std::memmove(static_cast<void*>(base + pos + 1), static_cast<const void*>(base + pos), (i - pos) * sizeof(T));
+					base[pos] = value;
+				}
+			}
+		}
+	}
+
 	template<typename RandomIter, typename Comparator = less_for_iter<RandomIter>>
 	void bubble(RandomIter begin, RandomIter end, Comparator comp = Comparator{}) {
 		// Random access iterators have the same traits you defined in the Vector class
@@ -60,32 +134,16 @@ namespace sort {
 	}
 
 	template<typename RandomIter, typename Comparator = less_for_iter<RandomIter>>
-	
 	void insertion(RandomIter begin, RandomIter end, Comparator comp = Comparator{}) {
-		//if the list isn't empty
-		if (begin != end) {
-			//loops through the entire array
-			for (RandomIter i = begin + 1; i != end; i++) {
-				//iterator one behind the outer loop
-				for (RandomIter r = i; r > begin; r--) {
-					if (comp(*r, *(r - 1))) {
-						swap(*r, *(r - 1));
-					}
-					else {
-						break;
-					}
-				}
-				/*
-				//loops through and swaps as long as the temp variaible is less than the item in the vector
-				while (r >= begin && comp(temp, *r)) {
-					swap(*(r + 1), *r);
-					r--;
-				}
-				//finally sets the new index value
-				*/
-			}
-		}
+		using value_type = typename std::iterator_traits<RandomIter>::value_type;
 
+		// Contiguous plain data is shifted with memmove, everything else is swapped
+		if constexpr (is_contiguous_iterator<RandomIter>::value && std::is_trivially_copyable<value_type>::value) {
+			detail::insertion_by_shifts(begin, end, comp);
+		}
+		else {
+			detail::insertion_by_swaps(begin, end, comp);
+		}
 	}
 
 	template<typename RandomIter, typename Comparator = less_for_iter<RandomIter>>
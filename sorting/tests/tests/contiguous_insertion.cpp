@@ -0,0 +1,52 @@
+#include "executable.h"
+#include "../../../vector/src/Vector.h"
+#include "../../../iterators/src/Vector_Basic.h"
+
+#include <algorithm>
+#include <array>
+#include <list>
+#include <vector>
+
+TEST(contiguous_iterator_traits) {
+    ASSERT_TRUE(sort::is_contiguous_iterator<int*>::value);
+    ASSERT_TRUE(sort::is_contiguous_iterator<std::vector<double>::iterator>::value);
+    ASSERT_TRUE((sort::is_contiguous_iterator<std::array<int, 4>::iterator>::value));
+    ASSERT_TRUE(sort::is_contiguous_iterator<Vector<int>::iterator>::value);
+    ASSERT_TRUE(sort::is_contiguous_iterator<Vector_Basic<int>::iterator>::value);
+
+    ASSERT_FALSE(sort::is_contiguous_iterator<std::vector<bool>::iterator>::value);
+    ASSERT_FALSE(sort::is_contiguous_iterator<std::list<int>::iterator>::value);
+}
+
+TEST(contiguous_insertion_same_comparisons) {
+    Typegen t;
+
+    for (size_t sz = 0; sz < 300; sz++) {
+        std::vector<int> gt(sz);
+        t.fill(gt.begin(), gt.end());
+
+        Vector<int> shifted;
+        for (int x : gt) {
+            shifted.push_back(x);
+        }
+        std::vector<int> swapped = gt;
+
+        size_t shift_comparisons = 0, swap_comparisons = 0;
+        // Vector's iterators take the memmove path
+        sort::insertion(shifted.begin(), shifted.end(), [&](int a, int b) {
+            shift_comparisons++;
+            return a < b;
+        });
+        sort::detail::insertion_by_swaps(swapped.begin(), swapped.end(), [&](int a, int b) {
+            swap_comparisons++;
+            return a < b;
+        });
+
+        std::sort(gt.begin(), gt.end());
+        ASSERT_EQ(swap_comparisons, shift_comparisons);
+        for (size_t i = 0; i < sz; i++) {
+            ASSERT_EQ(gt[i], shifted[i]);
+            ASSERT_EQ(gt[i], swapped[i]);
+        }
+    }
+}
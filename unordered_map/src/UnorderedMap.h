@@ -1,14 +1,19 @@
 #include <cstddef>    // size_t
 #include <functional> // std::hash
 #include <ios>
+#include <type_traits> // std::is_trivially_destructible
 #include <utility>    // std::pair
 #include <iostream>
 
 #include "primes.h"
+#include "NodePool.h"
 
 
 
-template <typename Key, typename T, typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>>
+// NodeAlloc decides where the nodes live: HeapNodes (one new/delete per
+// node) or PooledNodes<> (slab pages owned by the map), see NodePool.h
+template <typename Key, typename T, typename Hash = std::hash<Key>, typename Pred = std::equal_to<Key>,
+          typename NodeAlloc = HeapNodes>
 class UnorderedMap {
     public:
 
@@ -36,6 +41,8 @@ class UnorderedMap {
         HashNode(value_type && val, HashNode * next = nullptr) : next { next }, val { std::move(val) } { }
     };
 
+    using node_pool = typename NodeAlloc::template pool<HashNode>;
+
     size_type _bucket_count;
     HashNode **_buckets;
 
@@ -45,6 +52,8 @@ class UnorderedMap {
     Hash _hash;
     key_equal _equal;
 
+    node_pool _nodes;
+
     static size_type _range_hash(size_type hash_code, size_type bucket_count) {
         return hash_code % bucket_count;
     }
@@ -61,8 +70,8 @@ class UnorderedMap {
         using reference = value_type &;
 
     private:
-        friend class UnorderedMap<Key, T, Hash, key_equal>;
-        using HashNode = typename UnorderedMap<Key, T, Hash, key_equal>::HashNode;
+        friend class UnorderedMap;
+        using HashNode = typename UnorderedMap::HashNode;
 
         const UnorderedMap * _map;
         HashNode * _ptr;
@@ -154,8 +163,8 @@ class UnorderedMap {
             using reference = value_type &;
 
         private:
-            friend class UnorderedMap<Key, T, Hash, key_equal>;
-            using HashNode = typename UnorderedMap<Key, T, Hash, key_equal>::HashNode;
+            friend class UnorderedMap;
+            using HashNode = typename UnorderedMap::HashNode;
 
             HashNode * _node;
 
@@ -241,7 +250,7 @@ private:
     HashNode * _insert_into_bucket(size_type bucket, value_type && value) {
         //will insert item into the bucket
         
-        HashNode* n = new HashNode(std::move(value), _buckets[bucket]);
+        HashNode* n = _nodes.create(std::move(value), _buckets[bucket]);
 
         //checks if it is valid
         //if there is not a head or the bucket is less than or equal to the head val in bucket set the head to the new node
@@ -299,7 +308,7 @@ public:
         }
     }
 
-    UnorderedMap(UnorderedMap && other) {
+    UnorderedMap(UnorderedMap && other) : _nodes(std::move(other._nodes)) {
         //set the new attributes (steal it)
         _bucket_count = other._bucket_count;
         _equal = other._equal;
@@ -354,7 +363,8 @@ public:
         clear();
         delete[] _buckets;
 
-        //set the new attributes
+        //set the new attributes, the nodes' memory comes along with them
+        _nodes = std::move(other._nodes);
         _bucket_count = other._bucket_count;
         _equal = other._equal;
         _buckets = other._buckets;
@@ -374,6 +384,17 @@ public:
 
     void clear() noexcept {
 
+        if (node_pool::bulk_release && std::is_trivially_destructible<value_type>::value) {
+            //nothing to destroy, empty the buckets and hand back the pool's pages at once
+            for (size_type b = 0; b < _bucket_count; b++) {
+                _buckets[b] = nullptr;
+            }
+            _nodes.release();
+            _head = nullptr;
+            _size = 0;
+            return;
+        }
+
         //loop through to delete every value
         while (_size > 0) {
             //std::cout << begin()._ptr->val.first << std::endl;
@@ -493,7 +514,7 @@ public:
         temp = temp->next;
         _size--;
         iterator it = ++iterator(this, dnode);
-        delete dnode;
+        _nodes.destroy(dnode);
         return it;
     }
 
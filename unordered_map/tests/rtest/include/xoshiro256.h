@@ -1,3 +1,5 @@
+#pragma once
+
 /*
 	Xoshiro PRNG - modern, fast, not cryptographically sound
 	
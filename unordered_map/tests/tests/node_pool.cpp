@@ -0,0 +1,106 @@
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include "executable.h"
+
+using PooledMap = UnorderedMap<int, int, std::hash<int>, std::equal_to<int>, PooledNodes<16>>;
+
+TEST(node_pool_matches_map) {
+    Typegen t;
+
+    for(size_t i = 0; i < TEST_ITER; i++) {
+        PooledMap map(t.range<size_t>(1, 50));
+        std::unordered_map<int, int> gt;
+
+        for(size_t op = 0; op < 300; op++) {
+            int key = t.range<int>(0, 100);
+            if(t.range<int>(0, 3) == 0) {
+                ASSERT_EQ(gt.erase(key), map.erase(key));
+            }
+            else {
+                int value = t.get<int>();
+                map[key] = value;
+                gt[key] = value;
+            }
+        }
+
+        ASSERT_EQ(gt.size(), map.size());
+        for(auto const & kv : gt) {
+            ASSERT_TRUE(map.find(kv.first) != map.end());
+            ASSERT_EQ(kv.second, map[kv.first]);
+        }
+
+        PooledMap copy = map;
+        PooledMap moved = std::move(map);
+        ASSERT_TRUE(map.empty());
+        ASSERT_EQ(gt.size(), copy.size());
+        ASSERT_EQ(gt.size(), moved.size());
+        for(auto const & kv : gt) {
+            ASSERT_EQ(kv.second, moved[kv.first]);
+        }
+    }
+}
+
+TEST(node_pool_allocates_pages) {
+    PooledMap map(101);
+    Memhook mh;
+    for(int i = 0; i < 40; i++) {
+        map.insert({i, i});
+    }
+    // 40 nodes on pages of 16
+    ASSERT_EQ(3ULL, mh.n_allocs());
+
+    // churn reuses freed slots
+    for(int i = 0; i < 1000; i++) {
+        map.erase(i % 40);
+        map.insert({i % 40, i});
+    }
+    ASSERT_EQ(3ULL, mh.n_allocs());
+    ASSERT_EQ(0ULL, mh.n_frees());
+
+    // clear() of trivially destructible pairs frees whole pages
+    map.clear();
+    ASSERT_EQ(3ULL, mh.n_frees());
+    ASSERT_TRUE(map.empty());
+    ASSERT_TRUE(map.begin() == map.end());
+
+    map.insert({7, 70});
+    ASSERT_EQ(1ULL, map.size());
+    ASSERT_EQ(70, map[7]);
+}
+
+TEST(node_pool_non_trivial_pairs) {
+    UnorderedMap<std::string, std::string, std::hash<std::string>, std::equal_to<std::string>, PooledNodes<4>> map(11);
+    std::string long_string(100, 'x');
+    for(int i = 0; i < 20; i++) {
+        map.insert({std::to_string(i), long_string});
+    }
+    map.erase("5");
+    map.erase("10");
+    ASSERT_EQ(18ULL, map.size());
+    ASSERT_TRUE(map.find("5") == map.end());
+    ASSERT_TRUE(map["7"] == long_string);
+    map.clear();
+    ASSERT_TRUE(map.empty());
+}
+
+namespace {
+    // The contents of a file, empty if it can't be read
+    std::string read_file(const char* path) {
+        std::ifstream in(path, std::ios::binary);
+        std::ostringstream contents;
+        contents << in.rdbuf();
+        return contents.str();
+    }
+}
+
+// NodePool.h is copied into list, binary_search_tree and unordered_map, so
+// a fix to one copy has to reach the others. Paths are relative to tests/.
+TEST(node_pool_header_matches_other_modules) {
+    const std::string mine = read_file("../src/NodePool.h");
+    ASSERT_FALSE(mine.empty());
+    for(const char* other : { "../../list/src/NodePool.h", "../../binary_search_tree/src/NodePool.h" }) {
+        ASSERT_TRUE(read_file(other) == mine);
+    }
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <algorithm> // std::sort, std::min
+#include <chrono>
+#include <cstddef> // size_t
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <vector>
+
+/*
+    Small helpers shared by the benchmark programs.
+
+    Example:
+
+    double secs = bench::seconds_per_run([&] { simd::sum(v.begin(), v.end()); });
+    bench::report("sum", bytes / secs / 1e9, "GB/s");
+*/
+
+namespace bench {
+
+    using clock = std::chrono::high_resolution_clock;
+
+    // Keeps the compiler from discarding a result that is otherwise unused
+    template <typename T>
+    inline void keep(T const& value) {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    // Seconds elapsed while running fn once
+    template <typename Fn>
+    double seconds(Fn&& fn) {
+        auto t_start = clock::now();
+        fn();
+        auto t_end = clock::now();
+        return std::chrono::duration<double>(t_end - t_start).count();
+    }
+
+    // Runs fn in batches until min_seconds have passed and returns the
+    // fastest batch's time per run. The fastest batch is the one least
+    // disturbed by the rest of the machine.
+    template <typename Fn>
+    double seconds_per_run(Fn&& fn, double min_seconds = 0.25) {
+        size_t batch = 1;
+        double best = 0, total = 0;
+        while (total < min_seconds) {
+            double t = seconds([&] {
+                for (size_t i = 0; i < batch; i++) {
+                    fn();
+                }
+            });
+            total += t;
+            if (best == 0 || t / batch < best) {
+                best = t / batch;
+            }
+            if (t < min_seconds / 10) {
+                batch *= 2;
+            }
+        }
+        return best;
+    }
+
+    // Value below which the given fraction of samples fall (e.g. 0.999 for p99.9)
+    inline double percentile(std::vector<double> samples, double fraction) {
+        if (samples.empty()) {
+            return 0;
+        }
+        std::sort(samples.begin(), samples.end());
+        size_t idx = static_cast<size_t>(fraction * (samples.size() - 1));
+        return samples[idx];
+    }
+
+    inline void header(const std::string& title) {
+        std::cout << "\n== " << title << " ==" << std::endl;
+    }
+
+    // One aligned result line: "<label>  <value> <unit>"
+    inline void report(const std::string& label, double value, const std::string& unit) {
+        std::cout << "  " << std::left << std::setw(40) << label
+                  << std::right << std::setw(12) << std::fixed << std::setprecision(3) << value
+                  << " " << unit << std::endl;
+    }
+}
@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "Vector.h"
+#include "BitVector.h"
+#include "bench.h"
+
+/*
+    BitVector against Vector<bool> (one byte per flag) for the operations
+    flag sets are used for.
+
+    USAGE: ./build/bit_vector [flags]
+        flags defaults to 100M, about 1% of them set
+*/
+
+namespace {
+
+    size_t count_bytes(Vector<bool>& v) {
+        size_t total = 0;
+        for (size_t i = 0; i < v.size(); i++) {
+            total += v[i];
+        }
+        return total;
+    }
+
+    size_t walk_bytes(Vector<bool>& v) {
+        size_t sum = 0;
+        for (size_t i = 0; i < v.size(); i++) {
+            if (v[i]) {
+                sum += i;
+            }
+        }
+        return sum;
+    }
+
+    size_t walk_bits(const BitVector& b) {
+        size_t sum = 0;
+        for (size_t i = b.find_first(); i < b.size(); i = b.find_next(i)) {
+            sum += i;
+        }
+        return sum;
+    }
+
+    void and_bytes(Vector<bool>& a, Vector<bool>& b) {
+        for (size_t i = 0; i < a.size(); i++) {
+            a[i] = a[i] && b[i];
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 100000000;
+
+    Vector<bool> bytes(n, false), bytes_other(n, true);
+    BitVector bits(n), bits_other(n, true);
+    uint64_t x = 88172645463325252ULL;
+    for (size_t i = 0; i < n / 100; i++) {
+        x ^= x << 13;
+        x ^= x >> 7;
+        x ^= x << 17;
+        bytes[x % n] = true;
+        bits.set(x % n);
+    }
+    std::cout << n << " flags, " << bits.count() << " set; Vector<bool> uses " << n / 1e6
+              << " MB, BitVector " << bits.words() * 8 / 1e6 << " MB" << std::endl;
+
+    size_t r1 = 0, r2 = 0;
+
+    bench::header("count");
+    double t_bytes = bench::seconds_per_run([&] { r1 = count_bytes(bytes); bench::keep(r1); });
+    double t_bits = bench::seconds_per_run([&] { r2 = bits.count(); bench::keep(r2); });
+    bench::report("Vector<bool>", t_bytes * 1e3, "ms");
+    bench::report("BitVector (popcount)", t_bits * 1e3, "ms");
+    bench::report("speedup", t_bytes / t_bits, "x");
+    if (r1 != r2) std::cerr << "Warning: counts disagree!" << std::endl;
+
+    bench::header("walk the set flags");
+    t_bytes = bench::seconds_per_run([&] { r1 = walk_bytes(bytes); bench::keep(r1); });
+    t_bits = bench::seconds_per_run([&] { r2 = walk_bits(bits); bench::keep(r2); });
+    bench::report("Vector<bool>", t_bytes * 1e3, "ms");
+    bench::report("BitVector (find_next)", t_bits * 1e3, "ms");
+    bench::report("speedup", t_bytes / t_bits, "x");
+    if (r1 != r2) std::cerr << "Warning: walks disagree!" << std::endl;
+
+    bench::header("a &= b");
+    t_bytes = bench::seconds_per_run([&] { and_bytes(bytes, bytes_other); bench::keep(bytes[0]); });
+    t_bits = bench::seconds_per_run([&] { bits &= bits_other; bench::keep(bits.data()[0]); });
+    bench::report("Vector<bool>", t_bytes * 1e3, "ms");
+    bench::report("BitVector", t_bits * 1e3, "ms");
+    bench::report("speedup", t_bytes / t_bits, "x");
+
+    bench::header("prefix counts");
+    const size_t queries = 1000000;
+    double t_rank = bench::seconds_per_run([&] {
+        size_t total = 0;
+        for (size_t q = 0; q < queries; q++) {
+            total += bits.rank((q * 2654435761ULL) % n);
+        }
+        bench::keep(total);
+    });
+    bench::report("BitVector::rank", t_rank / queries * 1e9, "ns/query");
+    double t_select = bench::seconds_per_run([&] {
+        size_t total = 0, ones = bits.count();
+        for (size_t q = 0; q < queries; q++) {
+            total += bits.select((q * 2654435761ULL) % ones);
+        }
+        bench::keep(total);
+    });
+    bench::report("BitVector::select", t_select / queries * 1e9, "ns/query");
+
+    return 0;
+}
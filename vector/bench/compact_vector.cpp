@@ -0,0 +1,115 @@
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef __GLIBC__
+#include <malloc.h> // malloc_trim
+#endif
+
+#include "Vector.h"
+#include "CompactVector.h"
+#include "bench.h"
+
+/*
+    Memory and iteration cost of tens of millions of small vectors, as in
+    an adjacency list: Vector<uint32_t> (24 byte handle) against
+    CompactVector<uint32_t> (8 byte handle, counts in the heap block).
+
+    USAGE: ./build/compact_vector [instances]
+        instances defaults to 50M
+
+    80% of the vectors stay empty and the rest hold 1 to 4 elements. Memory
+    is the growth of the resident set while the vectors are built (handles,
+    element blocks and allocator overhead); iteration sums every element
+    of every vector.
+*/
+
+namespace {
+
+    // Resident set size in bytes (Linux), 0 where /proc is not available
+    size_t resident_bytes() {
+        std::ifstream statm("/proc/self/statm");
+        size_t pages = 0, resident = 0;
+        statm >> pages >> resident;
+        return resident * 4096;
+    }
+
+    void give_back_memory() {
+#ifdef __GLIBC__
+        malloc_trim(0);
+#endif
+    }
+
+    // Element counts, drawn once so both containers hold the same data
+    std::vector<uint8_t> make_lengths(size_t n) {
+        std::mt19937_64 rng(7);
+        std::uniform_int_distribution<int> roll(0, 99);
+        std::vector<uint8_t> lengths(n);
+        for (size_t i = 0; i < n; i++) {
+            int r = roll(rng);
+            lengths[i] = r < 80 ? 0 : static_cast<uint8_t>(1 + r % 4);
+        }
+        return lengths;
+    }
+
+    template <typename Small>
+    void run(const std::string& label, const std::vector<uint8_t>& lengths) {
+        const size_t n = lengths.size();
+        give_back_memory();
+        const size_t before = resident_bytes();
+
+        double t_build = 0, t_iterate = 0;
+        uint64_t sum = 0;
+        size_t used = 0;
+        {
+            std::vector<Small> all;
+            t_build = bench::seconds([&] {
+                all.resize(n);
+                for (size_t i = 0; i < n; i++) {
+                    for (uint32_t k = 0; k < lengths[i]; k++) {
+                        all[i].push_back(static_cast<uint32_t>(i + k));
+                    }
+                }
+            });
+            used = resident_bytes() - before;
+
+            t_iterate = bench::seconds_per_run([&] {
+                uint64_t s = 0;
+                for (Small& v : all) {
+                    for (auto it = v.begin(); it != v.end(); ++it) {
+                        s += *it;
+                    }
+                }
+                sum = s;
+                bench::keep(sum);
+            }, 1.0);
+        }
+
+        bench::header(label);
+        bench::report("handle size", sizeof(Small), "B");
+        bench::report("memory", used / 1e6, "MB");
+        bench::report("memory per instance", static_cast<double>(used) / n, "B");
+        bench::report("build", t_build * 1e3, "ms");
+        bench::report("iterate all elements", t_iterate * 1e3, "ms");
+        bench::report("checksum", static_cast<double>(sum), "");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000000;
+
+    std::vector<uint8_t> lengths = make_lengths(n);
+    size_t elements = 0;
+    for (uint8_t l : lengths) {
+        elements += l;
+    }
+    std::cout << n << " vectors holding " << elements << " uint32_t in total" << std::endl;
+
+    run<Vector<uint32_t>>("Vector<uint32_t>", lengths);
+    run<CompactVector<uint32_t>>("CompactVector<uint32_t>", lengths);
+    return 0;
+}
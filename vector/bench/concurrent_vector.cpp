@@ -0,0 +1,87 @@
+#include <cstdlib>
+#include <iostream>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "Vector.h"
+#include "ConcurrentVector.h"
+#include "bench.h"
+
+/*
+    Multi-producer append throughput: ConcurrentVector against a Vector
+    guarded by a mutex.
+
+    USAGE: ./build/concurrent_vector [appends] [max_threads]
+        appends defaults to 10M in total, split over the producers
+        max_threads defaults to std::thread::hardware_concurrency()
+
+    Each thread count also runs grow_by in batches of 64, which claims a
+    whole run of indices with one atomic add.
+*/
+
+namespace {
+
+    template <typename Fn>
+    double run_producers(size_t threads, Fn&& produce) {
+        return bench::seconds([&] {
+            std::vector<std::thread> producers;
+            for (size_t t = 0; t < threads; t++) {
+                producers.emplace_back([&, t] { produce(t); });
+            }
+            for (std::thread& p : producers) {
+                p.join();
+            }
+        });
+    }
+
+    void run(size_t appends, size_t threads) {
+        const size_t per_thread = appends / threads;
+        bench::header(std::to_string(threads) + " producer(s)");
+
+        {
+            Vector<size_t> v;
+            std::mutex m;
+            double t = run_producers(threads, [&](size_t id) {
+                for (size_t i = 0; i < per_thread; i++) {
+                    std::lock_guard<std::mutex> lock(m);
+                    v.push_back(id * per_thread + i);
+                }
+            });
+            bench::report("mutex + Vector::push_back", per_thread * threads / t / 1e6, "M/s");
+        }
+        {
+            ConcurrentVector<size_t> v;
+            double t = run_producers(threads, [&](size_t id) {
+                for (size_t i = 0; i < per_thread; i++) {
+                    v.push_back(id * per_thread + i);
+                }
+            });
+            bench::report("ConcurrentVector::push_back", per_thread * threads / t / 1e6, "M/s");
+        }
+        {
+            ConcurrentVector<size_t> v;
+            double t = run_producers(threads, [&](size_t id) {
+                for (size_t i = 0; i + 64 <= per_thread; i += 64) {
+                    v.grow_by(64, id);
+                }
+            });
+            bench::report("ConcurrentVector::grow_by(64)", per_thread / 64 * 64 * threads / t / 1e6, "M/s");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t appends = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+    std::cout << appends << " appends, hardware threads: " << std::thread::hardware_concurrency() << std::endl;
+
+    for (size_t threads = 1; threads <= max_threads; threads *= 2) {
+        run(appends, threads);
+    }
+    return 0;
+}
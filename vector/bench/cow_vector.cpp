@@ -0,0 +1,56 @@
+#include <cstdlib>
+#include <iostream>
+
+#include "Vector.h"
+#include "CowVector.h"
+#include "bench.h"
+
+/*
+    Cost of handing a read-only copy of a large vector to a worker:
+    CowVector::snapshot() against Vector's deep copy.
+
+    USAGE: ./build/cow_vector [elements]
+        elements defaults to 4M doubles (32 MB)
+
+    Also reports what the first write to a shared CowVector costs, since
+    that is where the deferred copy is paid.
+*/
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 4000000;
+
+    Vector<double> vec;
+    for (size_t i = 0; i < n; i++) {
+        vec.push_back(i * 0.5);
+    }
+    CowVector<double> cow(vec);
+    std::cout << n << " doubles (" << n * sizeof(double) / 1e6 << " MB)" << std::endl;
+
+    bench::header("hand off a read-only copy");
+    double t_deep = bench::seconds_per_run([&] {
+        Vector<double> copy(vec);
+        bench::keep(copy[n / 2]);
+    });
+    double t_snap = bench::seconds_per_run([&] {
+        const CowVector<double> copy = cow.snapshot();
+        bench::keep(copy[n / 2]);
+    });
+    bench::report("Vector copy constructor", t_deep * 1e6, "us");
+    bench::report("CowVector::snapshot", t_snap * 1e6, "us");
+    bench::report("speedup", t_deep / t_snap, "x");
+
+    bench::header("first write after sharing");
+    double t_detach = bench::seconds_per_run([&] {
+        CowVector<double> copy = cow.share();
+        copy[0] = 1.0; // copies the elements
+        bench::keep(copy[0]);
+    });
+    double t_private = bench::seconds_per_run([&] {
+        cow[0] = 1.0; // already private, no copy
+        bench::keep(cow[0]);
+    });
+    bench::report("write to a shared CowVector", t_detach * 1e6, "us");
+    bench::report("write to a private CowVector", t_private * 1e6, "us");
+
+    return 0;
+}
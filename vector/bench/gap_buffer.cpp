@@ -0,0 +1,117 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include "Vector.h"
+#include "GapBuffer.h"
+#include "bench.h"
+
+/*
+    Replays an editor-like trace on GapBuffer<char> and Vector<char>: the
+    cursor mostly types and backspaces where it is, sometimes steps a few
+    characters, and now and then jumps somewhere else in the document.
+
+    USAGE: ./build/gap_buffer [document bytes] [edits]
+        defaults: a 1 MB document and 20k edits
+
+    Vector pays for every edit with a shift of everything after the
+    cursor; GapBuffer only shifts when the cursor moves, by the distance
+    moved.
+*/
+
+struct Edit {
+    enum Kind : uint8_t { TYPE, BACKSPACE, MOVE } kind;
+    char c;
+    int64_t offset;
+};
+
+std::vector<Edit> make_trace(size_t edits) {
+    std::mt19937_64 rng(42);
+    std::uniform_int_distribution<int> op(0, 99);
+    std::uniform_int_distribution<int> step(-20, 20);
+    std::uniform_int_distribution<int64_t> jump(-100000, 100000);
+    std::vector<Edit> trace;
+    for (size_t i = 0; i < edits; i++) {
+        int roll = op(rng);
+        if (roll < 70) {
+            trace.push_back({ Edit::TYPE, static_cast<char>('a' + roll % 26), 0 });
+        }
+        else if (roll < 85) {
+            trace.push_back({ Edit::BACKSPACE, 0, 0 });
+        }
+        else if (roll < 99) {
+            trace.push_back({ Edit::MOVE, 0, step(rng) });
+        }
+        else {
+            trace.push_back({ Edit::MOVE, 0, jump(rng) });
+        }
+    }
+    return trace;
+}
+
+template <class Buffer>
+Buffer make_document(size_t bytes) {
+    Buffer doc;
+    for (size_t i = 0; i < bytes; i++) {
+        doc.push_back(static_cast<char>('a' + i % 26));
+    }
+    return doc;
+}
+
+// Applies the trace with the cursor starting in the middle of the document
+template <class Buffer>
+void replay(Buffer& doc, const std::vector<Edit>& trace) {
+    int64_t cursor = static_cast<int64_t>(doc.size() / 2);
+    for (const Edit& e : trace) {
+        switch (e.kind) {
+            case Edit::TYPE:
+                doc.insert(doc.begin() + cursor, e.c);
+                cursor++;
+                break;
+            case Edit::BACKSPACE:
+                if (cursor > 0) {
+                    doc.erase(doc.begin() + (cursor - 1));
+                    cursor--;
+                }
+                break;
+            case Edit::MOVE:
+                cursor += e.offset;
+                if (cursor < 0) cursor = 0;
+                if (cursor > static_cast<int64_t>(doc.size())) cursor = static_cast<int64_t>(doc.size());
+                break;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t bytes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    size_t edits = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 20000;
+
+    std::vector<Edit> trace = make_trace(edits);
+    std::cout << edits << " edits on a " << bytes / 1e6 << " MB document" << std::endl;
+
+    Vector<char> vec = make_document<Vector<char>>(bytes);
+    GapBuffer<char> gap = make_document<GapBuffer<char>>(bytes);
+
+    bench::header("replay the edit trace");
+    double t_vec = bench::seconds([&] { replay(vec, trace); });
+    double t_gap = bench::seconds([&] { replay(gap, trace); });
+    bench::report("Vector::insert/erase", t_vec * 1e3, "ms");
+    bench::report("GapBuffer::insert/erase", t_gap * 1e3, "ms");
+    bench::report("Vector per edit", t_vec / edits * 1e9, "ns");
+    bench::report("GapBuffer per edit", t_gap / edits * 1e9, "ns");
+    bench::report("speedup", t_vec / t_gap, "x");
+
+    // Both must end up with the same text
+    bool same = vec.size() == gap.size();
+    for (size_t i = 0; same && i < vec.size(); i++) {
+        same = vec[i] == gap[i];
+    }
+    if (!same) {
+        std::cerr << "GapBuffer and Vector disagree after the trace" << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,123 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include "Vector.h"
+#include "MappedVector.h"
+#include "bench.h"
+
+/*
+    Cold open + first scan of a MappedVector file against loading the same
+    records with an ifstream into a Vector.
+
+    USAGE: ./build/mapped_vector [records] [path]
+        records defaults to 10M (16 byte records, 160 MB)
+        path defaults to /tmp/mapped_vector_bench.dat and is removed afterwards
+
+    "Cold" means the file's pages were dropped from the page cache with
+    posix_fadvise(DONTNEED) first. That is best effort: it only works for
+    clean pages and is a no-op on systems without posix_fadvise.
+*/
+
+namespace {
+
+    struct Record {
+        uint64_t id;
+        double value;
+    };
+
+    void drop_cache(const std::string& path) {
+#ifdef POSIX_FADV_DONTNEED
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd >= 0) {
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+        }
+#else
+        (void) path;
+#endif
+    }
+
+    template <typename Container>
+    double scan(Container& records) {
+        double total = 0;
+        for (auto it = records.begin(); it != records.end(); ++it) {
+            total += it->value;
+        }
+        return total;
+    }
+
+    // The deserialize-on-start path: read every record into a heap Vector
+    Vector<Record> load_with_ifstream(const std::string& path, size_t header_bytes) {
+        std::ifstream in(path, std::ios::binary);
+        in.seekg(static_cast<std::streamoff>(header_bytes));
+        Vector<Record> records;
+        Record r;
+        while (in.read(reinterpret_cast<char*>(&r), sizeof(r))) {
+            records.push_back(r);
+        }
+        return records;
+    }
+
+    void run(const std::string& path, bool cold) {
+        bench::header(cold ? "cold page cache" : "warm page cache");
+
+        if (cold) {
+            drop_cache(path);
+        }
+        MappedVector<Record>* mv = nullptr;
+        double t_open = bench::seconds([&] { mv = new MappedVector<Record>(path, MappedVector<Record>::READ_ONLY); });
+        double sum_mapped = 0;
+        double t_scan = bench::seconds([&] { sum_mapped = scan(*mv); });
+        delete mv;
+
+        bench::report("MappedVector open", t_open * 1e3, "ms");
+        bench::report("MappedVector first scan", t_scan * 1e3, "ms");
+        bench::report("MappedVector open + scan", (t_open + t_scan) * 1e3, "ms");
+
+        if (cold) {
+            drop_cache(path);
+        }
+        Vector<Record> vec;
+        double t_load = bench::seconds([&] { vec = load_with_ifstream(path, 64); });
+        double sum_loaded = 0;
+        double t_vscan = bench::seconds([&] { sum_loaded = scan(vec); });
+
+        bench::report("ifstream -> Vector load", t_load * 1e3, "ms");
+        bench::report("Vector scan", t_vscan * 1e3, "ms");
+        bench::report("ifstream -> Vector load + scan", (t_load + t_vscan) * 1e3, "ms");
+
+        if (sum_mapped != sum_loaded) {
+            std::cerr << "Warning: the two scans disagree!" << std::endl;
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+    std::string path = argc > 2 ? argv[2] : "/tmp/mapped_vector_bench.dat";
+
+    std::remove(path.c_str());
+    {
+        MappedVector<Record> mv(path);
+        mv.reserve(n);
+        for (size_t i = 0; i < n; i++) {
+            mv.push_back(Record{ i, static_cast<double>(i % 1000) });
+        }
+        mv.flush();
+    }
+    std::cout << n << " records of " << sizeof(Record) << " bytes in " << path << std::endl;
+
+    run(path, true);
+    run(path, false);
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "Vector.h"
+#include "parallel.h"
+#include "bench.h"
+
+/*
+    Strong scaling of the parallel algorithms: a fixed problem size run on
+    pools of 1 to N threads. Speedup is relative to the 1 thread pool.
+
+    USAGE: ./build/parallel_scaling [elements] [max threads]
+        elements defaults to 16M doubles, max threads to hardware_concurrency
+*/
+
+namespace {
+
+    // Work that grows with the index, so equal sized static blocks are unbalanced
+    double skewed_work(size_t i, size_t n) {
+        double x = static_cast<double>(i);
+        size_t rounds = 1 + 64 * i / n;
+        for (size_t r = 0; r < rounds; r++) {
+            x = std::sqrt(x + 1.0);
+        }
+        return x;
+    }
+
+    void scaling(const std::string& name, size_t max_threads, const std::function<void(const ParallelOptions&)>& fn,
+        Schedule schedule = Schedule::STATIC) {
+        bench::header(name);
+        double base = 0;
+        for (size_t threads = 1; threads <= max_threads; threads++) {
+            ThreadPool pool(threads);
+            ParallelOptions opts{ schedule, 0, &pool };
+            double t = bench::seconds_per_run([&] { fn(opts); }, 0.5);
+            if (threads == 1) {
+                base = t;
+            }
+            bench::report(std::to_string(threads) + " thread(s)", t * 1e3, "ms  (speedup x" + std::to_string(base / t).substr(0, 4) + ")");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1 << 24);
+    size_t max_threads = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : std::thread::hardware_concurrency();
+    if (max_threads == 0) {
+        max_threads = 1;
+    }
+
+    Vector<double> in(n), out(n);
+    for (size_t i = 0; i < n; i++) {
+        in[i] = static_cast<double>(i % 1000);
+    }
+
+    std::cout << n << " elements, up to " << max_threads << " threads" << std::endl;
+
+    scaling("parallel_for_each (sqrt, uniform)", max_threads, [&](const ParallelOptions& opts) {
+        parallel_for_each(out.begin(), out.end(), [](double& x) { x = std::sqrt(x + 2.0); }, opts);
+    });
+
+    scaling("parallel_transform (sqrt, uniform)", max_threads, [&](const ParallelOptions& opts) {
+        parallel_transform(in.begin(), in.end(), out.begin(), [](double x) { return std::sqrt(x); }, opts);
+    });
+
+    scaling("parallel_reduce (sum)", max_threads, [&](const ParallelOptions& opts) {
+        bench::keep(parallel_reduce(in.begin(), in.end(), 0.0, std::plus<double>{}, opts));
+    });
+
+    scaling("parallel_inclusive_scan (sum)", max_threads, [&](const ParallelOptions& opts) {
+        parallel_inclusive_scan(in.begin(), in.end(), out.begin(), std::plus<double>{}, opts);
+    });
+
+    scaling("parallel_copy_if (x < 500)", max_threads, [&](const ParallelOptions& opts) {
+        parallel_copy_if(in.begin(), in.end(), out.begin(), [](double x) { return x < 500; }, opts);
+    });
+
+    Vector<size_t> small_idx(n / 16);
+    for (size_t i = 0; i < small_idx.size(); i++) {
+        small_idx[i] = i;
+    }
+    const size_t m = small_idx.size();
+    auto skewed = [&](const ParallelOptions& opts) {
+        parallel_transform(small_idx.begin(), small_idx.end(), out.begin(),
+            [m](size_t i) { return skewed_work(i, m); }, opts);
+    };
+    scaling("skewed transform, STATIC", max_threads, skewed, Schedule::STATIC);
+    scaling("skewed transform, DYNAMIC", max_threads, skewed, Schedule::DYNAMIC);
+
+    return 0;
+}
@@ -0,0 +1,67 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "Vector.h"
+#include "SegmentedVector.h"
+#include "bench.h"
+
+/*
+    Per-call push_back latency of SegmentedVector against Vector.
+
+    USAGE: ./build/segmented_vector [pushes]
+        pushes defaults to 20M
+
+    Every push_back is timed on its own, so the numbers include the clock's
+    own overhead (tens of ns). Vector's occasional grow() copies the whole
+    array and shows up in the tail; SegmentedVector only allocates a block.
+*/
+
+namespace {
+
+    struct Payload {
+        double values[4];
+    };
+
+    template <typename Container, typename T>
+    void run(const std::string& label, size_t pushes, const T& value) {
+        std::vector<double> samples(pushes);
+        Container c;
+
+        for (size_t i = 0; i < pushes; i++) {
+            auto t_start = bench::clock::now();
+            c.push_back(value);
+            auto t_end = bench::clock::now();
+            samples[i] = std::chrono::duration<double, std::nano>(t_end - t_start).count();
+        }
+        bench::keep(c[pushes / 2]);
+
+        double max = 0, total = 0;
+        for (double s : samples) {
+            total += s;
+            max = s > max ? s : max;
+        }
+
+        bench::report(label + " mean", total / pushes, "ns");
+        bench::report(label + " p50", bench::percentile(samples, 0.5), "ns");
+        bench::report(label + " p99.9", bench::percentile(samples, 0.999), "ns");
+        bench::report(label + " p99.999", bench::percentile(samples, 0.99999), "ns");
+        bench::report(label + " max", max / 1e6, "ms");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t pushes = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 20000000;
+    std::cout << pushes << " push_back calls" << std::endl;
+
+    bench::header("int");
+    run<Vector<int>>("Vector", pushes, 7);
+    run<SegmentedVector<int>>("SegmentedVector", pushes, 7);
+
+    bench::header("32 byte struct");
+    run<Vector<Payload>>("Vector", pushes / 4, Payload{});
+    run<SegmentedVector<Payload>>("SegmentedVector", pushes / 4, Payload{});
+
+    return 0;
+}
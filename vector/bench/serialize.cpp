@@ -0,0 +1,113 @@
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "Vector.h"
+#include "serialize.h"
+#include "bench.h"
+
+/*
+    Throughput of the binary format against element-by-element text
+    streaming, through a file in the page cache.
+
+    USAGE: ./build/serialize [megabytes] [path]
+        megabytes defaults to 1024 (a 1 GB payload of uint64_t)
+        path defaults to /tmp/serialize_bench.bin and is removed afterwards
+
+    The text baseline only streams a 64 MB slice and is scaled to GB/s,
+    since it is orders of magnitude slower.
+*/
+
+namespace {
+
+    double gbps(size_t bytes, double seconds) { return bytes / seconds / 1e9; }
+
+    void text_baseline(Vector<uint64_t>& v, const std::string& path) {
+        const size_t n = v.size() < (64u << 20) / sizeof(uint64_t) ? v.size() : (64u << 20) / sizeof(uint64_t);
+        const size_t bytes = n * sizeof(uint64_t);
+
+        double t_write = bench::seconds([&] {
+            std::ofstream out(path);
+            for (size_t i = 0; i < n; i++) {
+                out << v[i] << '\n';
+            }
+        });
+        Vector<uint64_t> back;
+        double t_read = bench::seconds([&] {
+            std::ifstream in(path);
+            uint64_t x;
+            while (in >> x) {
+                back.push_back(x);
+            }
+        });
+        bench::report("text write (operator<<)", gbps(bytes, t_write), "GB/s");
+        bench::report("text read (operator>>)", gbps(bytes, t_read), "GB/s");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t mb = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1024;
+    std::string path = argc > 2 ? argv[2] : "/tmp/serialize_bench.bin";
+
+    const size_t n = (mb << 20) / sizeof(uint64_t);
+    const size_t bytes = n * sizeof(uint64_t);
+    Vector<uint64_t> v(n);
+    for (size_t i = 0; i < n; i++) {
+        v[i] = i * 0x9E3779B97F4A7C15ULL;
+    }
+    std::cout << bytes / 1e9 << " GB payload" << std::endl;
+
+    bench::header("binary format");
+    double t_sum = bench::seconds([&] { bench::keep(serial::checksum(v.data(), bytes)); });
+    bench::report("checksum alone", gbps(bytes, t_sum), "GB/s");
+
+    double t_write = bench::seconds([&] {
+        std::ofstream out(path, std::ios::binary);
+        serial::write(out, v.begin(), v.end());
+    });
+    bench::report("serial::write", gbps(bytes, t_write), "GB/s");
+
+    for (bool verify : { true, false }) {
+        double t_read = bench::seconds([&] {
+            std::ifstream in(path, std::ios::binary);
+            Vector<uint64_t> back = serial::read<uint64_t>(in, verify);
+            bench::keep(back[n / 2]);
+        });
+        bench::report(verify ? "serial::read (checksummed)" : "serial::read (unchecked)", gbps(bytes, t_read), "GB/s");
+    }
+
+    // Zero copy: map the file and adopt the mapping
+    int fd = open(path.c_str(), O_RDONLY);
+    struct stat st;
+    fstat(fd, &st);
+    for (bool verify : { true, false }) {
+        double t_view = bench::seconds([&] {
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            serial::View<uint64_t> view = serial::view<uint64_t>(map, st.st_size, verify);
+            bench::keep(view[n / 2]);
+            munmap(map, st.st_size);
+        });
+        if (verify) {
+            bench::report("mmap + serial::view (checksummed)", gbps(bytes, t_view), "GB/s");
+        }
+        else {
+            // O(1): nothing but the header is touched
+            bench::report("mmap + serial::view (unchecked)", t_view * 1e6, "us");
+        }
+    }
+    close(fd);
+
+    bench::header("text streaming (64 MB slice)");
+    text_baseline(v, path);
+
+    std::remove(path.c_str());
+    return 0;
+}
@@ -0,0 +1,77 @@
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "Vector.h"
+#include "simd.h"
+#include "bench.h"
+
+/*
+    Throughput of every simd:: kernel at every ISA level the CPU supports.
+
+    USAGE: ./build/simd_kernels [elements]   (default 4M, 16 MB of int / float)
+*/
+
+namespace {
+
+    template <typename T>
+    void run_type(const std::string& type_name, size_t n) {
+        Vector<T> a(n), b(n), out(n);
+        for (size_t i = 0; i < n; i++) {
+            a[i] = static_cast<T>(i % 97);
+            b[i] = static_cast<T>(i % 89);
+        }
+        // only found at the very end so find reads the whole range
+        a[n - 1] = static_cast<T>(1000);
+
+        const double bytes = static_cast<double>(n * sizeof(T));
+
+        for (simd::Isa isa : { simd::Isa::SCALAR, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 }) {
+            if (!simd::supported(isa)) {
+                continue;
+            }
+
+            std::ostringstream title;
+            title << "Vector<" << type_name << ">, " << n << " elements, " << isa;
+            bench::header(title.str());
+
+            double t = bench::seconds_per_run([&] { bench::keep(simd::find(a.begin(), a.end(), T(1000), isa)); });
+            bench::report("find", bytes / t / 1e9, "GB/s");
+
+            t = bench::seconds_per_run([&] { bench::keep(simd::count(a.begin(), a.end(), T(3), isa)); });
+            bench::report("count", bytes / t / 1e9, "GB/s");
+
+            t = bench::seconds_per_run([&] { bench::keep(simd::min_element(a.begin(), a.end(), isa)); });
+            bench::report("min_element", bytes / t / 1e9, "GB/s");
+
+            t = bench::seconds_per_run([&] { bench::keep(simd::max_element(a.begin(), a.end(), isa)); });
+            bench::report("max_element", bytes / t / 1e9, "GB/s");
+
+            t = bench::seconds_per_run([&] { bench::keep(simd::sum(a.begin(), a.end(), isa)); });
+            bench::report("sum", bytes / t / 1e9, "GB/s");
+
+            t = bench::seconds_per_run([&] { bench::keep(simd::dot(a.begin(), a.end(), b.begin(), isa)); });
+            bench::report("dot (both inputs)", 2 * bytes / t / 1e9, "GB/s");
+
+            t = bench::seconds_per_run([&] { simd::inclusive_scan(a.begin(), a.end(), out.begin(), isa); });
+            bench::report("inclusive_scan (read + write)", 2 * bytes / t / 1e9, "GB/s");
+        }
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : (1 << 22);
+    if (n == 0) {
+        std::cerr << "USAGE: " << argv[0] << " [elements > 0]" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Best supported level: " << simd::detected() << std::endl;
+
+    run_type<int>("int", n);
+    run_type<float>("float", n);
+    run_type<double>("double", n);
+
+    return 0;
+}
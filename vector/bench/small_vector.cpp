@@ -0,0 +1,70 @@
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "Vector.h"
+#include "SmallVector.h"
+#include "memhook.h"
+#include "bench.h"
+
+/*
+    Allocation counts and build time for many short vectors, SmallVector
+    against Vector.
+
+    USAGE: ./build/small_vector [vectors]
+        vectors defaults to 1M; each holds 0-8 ints
+
+    Allocations are counted with the test framework's Memhook over the
+    first 2000 vectors only, since a live Memhook scans every block it has
+    seen on each new/delete. The timed runs have no Memhook attached, but
+    Memhook's replacement new/delete still adds a little to every call.
+*/
+
+namespace {
+
+    template <typename Container>
+    void build(size_t vectors, size_t max_len) {
+        long long total = 0;
+        for (size_t i = 0; i < vectors; i++) {
+            Container c;
+            size_t len = i % (max_len + 1);
+            for (size_t j = 0; j < len; j++) {
+                c.push_back(static_cast<int>(i + j));
+            }
+            for (auto it = c.begin(); it != c.end(); ++it) {
+                total += *it;
+            }
+        }
+        bench::keep(total);
+    }
+
+    template <typename Container>
+    void run(const std::string& label, size_t vectors, size_t max_len) {
+        const size_t sample = vectors < 2000 ? vectors : 2000;
+        size_t allocs;
+        {
+            Memhook mh;
+            build<Container>(sample, max_len);
+            allocs = mh.n_allocs();
+        }
+        double secs = bench::seconds([&] { build<Container>(vectors, max_len); });
+
+        bench::report(label + " allocs per vector", static_cast<double>(allocs) / sample, "");
+        bench::report(label + " time", secs * 1e3, "ms");
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t vectors = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    std::cout << vectors << " vectors" << std::endl;
+
+    bench::header("lengths 0-8 (all fit inline)");
+    run<Vector<int>>("Vector<int>", vectors, 8);
+    run<SmallVector<int, 8>>("SmallVector<int, 8>", vectors, 8);
+
+    bench::header("lengths 0-16 (half spill to the heap)");
+    run<Vector<int>>("Vector<int>", vectors, 16);
+    run<SmallVector<int, 8>>("SmallVector<int, 8>", vectors, 16);
+
+    return 0;
+}
@@ -0,0 +1,100 @@
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+
+#include "Vector.h"
+#include "SoAVector.h"
+#include "bench.h"
+
+/*
+    Single-field filter + sum over a 48 byte record, stored as an
+    array of structs (Vector<Order>) and as a structure of arrays
+    (SoAVector with one column per field).
+
+    USAGE: ./build/soa_vector [records]
+        records defaults to 10M
+
+    The query is "sum of price over orders with quantity > 50". The AoS scan
+    pulls all 48 bytes of every record through the cache; the SoA scan only
+    touches the quantity and price columns, 12 bytes per record.
+*/
+
+namespace {
+
+    struct Order {
+        uint64_t id;
+        double price;
+        double discount;
+        int32_t quantity;
+        int32_t customer;
+        int64_t timestamp;
+        double weight;
+    };
+
+    using Orders = SoAVector<uint64_t, double, double, int32_t, int32_t, int64_t, double>;
+    enum { ID, PRICE, DISCOUNT, QUANTITY, CUSTOMER, TIMESTAMP, WEIGHT };
+
+    double aos_query(Vector<Order>& orders) {
+        double total = 0;
+        for (auto it = orders.begin(); it != orders.end(); ++it) {
+            if (it->quantity > 50) {
+                total += it->price;
+            }
+        }
+        return total;
+    }
+
+    double soa_query(Orders& orders) {
+        auto quantity = orders.column<QUANTITY>();
+        auto price = orders.column<PRICE>();
+        double total = 0;
+        for (size_t i = 0; i < quantity.size(); i++) {
+            if (quantity[i] > 50) {
+                total += price[i];
+            }
+        }
+        return total;
+    }
+
+    // Same query through the proxy iterator, i.e. without the column spans
+    double soa_iterator_query(Orders& orders) {
+        double total = 0;
+        for (auto it = orders.begin(); it != orders.end(); ++it) {
+            auto record = *it;
+            if (record.get<QUANTITY>() > 50) {
+                total += record.get<PRICE>();
+            }
+        }
+        return total;
+    }
+}
+
+int main(int argc, char** argv) {
+    size_t n = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 10000000;
+
+    Vector<Order> aos;
+    Orders soa;
+    for (size_t i = 0; i < n; i++) {
+        Order o{ i, (i % 977) * 0.25, 0.1, static_cast<int32_t>(i * 7919 % 100),
+                 static_cast<int32_t>(i % 5000), static_cast<int64_t>(i), 1.0 };
+        aos.push_back(o);
+        soa.push_back(o.id, o.price, o.discount, o.quantity, o.customer, o.timestamp, o.weight);
+    }
+    std::cout << n << " orders of " << sizeof(Order) << " bytes" << std::endl;
+
+    double r_aos = 0, r_soa = 0, r_iter = 0;
+    double t_aos = bench::seconds_per_run([&] { r_aos = aos_query(aos); bench::keep(r_aos); });
+    double t_soa = bench::seconds_per_run([&] { r_soa = soa_query(soa); bench::keep(r_soa); });
+    double t_iter = bench::seconds_per_run([&] { r_iter = soa_iterator_query(soa); bench::keep(r_iter); });
+
+    bench::header("sum(price) where quantity > 50");
+    bench::report("Vector<Order> (AoS)", t_aos * 1e3, "ms");
+    bench::report("SoAVector columns", t_soa * 1e3, "ms");
+    bench::report("SoAVector proxy iterator", t_iter * 1e3, "ms");
+    bench::report("speedup (AoS / SoA columns)", t_aos / t_soa, "x");
+
+    if (r_aos != r_soa || r_aos != r_iter) {
+        std::cerr << "Warning: the queries disagree!" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,483 @@
+#ifndef BIT_VECTOR_H
+#define BIT_VECTOR_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstring> // std::memcpy, std::memset
+#include <stdexcept> // std::out_of_range, std::invalid_argument
+#include <utility> // std::move
+
+/*
+    BitVector
+    ---------
+
+    A vector of flags packed 64 to a word. Besides single flag access it
+    works a word at a time:
+
+    - count() is one popcount per word
+    - find_first()/find_next(i) skip empty words and use count-trailing-zeros
+      (tzcnt) inside a word; both return size() when there is no set flag
+    - &=, |=, ^= and and_not() combine whole words of equally sized vectors
+    - rank(i) counts the set flags before i and select(k) finds the k-th set
+      flag, both through a small index of per-512-bit prefix counts that is
+      rebuilt on the first query after a change
+
+    Iterating over the set flags:
+
+    for (size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i)) { ... }
+
+    Flags past size() in the last word are always kept clear, so the word
+    operations never have to mask them.
+
+    BitVisitedSet below wraps two BitVectors with the interface of the graph
+    module's VisitedSet, so it can replace it in bfs/dfs.
+*/
+
+class BitVector {
+public:
+    using word_type = uint64_t;
+    static constexpr size_t word_bits = 64;
+
+private:
+    word_type* bits;
+    size_t _size, _words_capacity;
+
+    // Prefix counts for rank/select: ranks[s] = set flags before superblock s
+    static constexpr size_t superblock_words = 8;
+    mutable size_t* ranks;
+    mutable size_t _ranks_capacity;
+    mutable bool ranks_valid;
+
+    static size_t words_for(size_t count) noexcept { return (count + word_bits - 1) / word_bits; }
+    static word_type mask(size_t pos) noexcept { return word_type(1) << (pos % word_bits); }
+
+    // Same doubling policy as Vector, counted in words
+    void grow_words(size_t min_words) {
+        size_t capacity = _words_capacity == 0 ? 1 : _words_capacity * 2;
+        if (capacity < min_words) {
+            capacity = min_words;
+        }
+        word_type* bigger = new word_type[capacity];
+        if (bits != nullptr) {
+            std::memcpy(bigger, bits, words() * sizeof(word_type));
+        }
+        delete[] bits;
+        bits = bigger;
+        _words_capacity = capacity;
+    }
+
+    // Clears the unused flags past size() in the last word
+    void trim() noexcept {
+        if (_size % word_bits != 0) {
+            bits[_size / word_bits] &= mask(_size) - 1;
+        }
+    }
+
+    void check_same_size(const BitVector& other) const {
+        if (other._size != _size) throw (std::invalid_argument("bit vectors differ in size"));
+    }
+
+    void build_ranks() const {
+        const size_t n = words();
+        const size_t blocks = n / superblock_words + 1;
+        if (blocks > _ranks_capacity) {
+            delete[] ranks;
+            ranks = new size_t[blocks];
+            _ranks_capacity = blocks;
+        }
+        size_t total = 0;
+        for (size_t w = 0; w < n; w++) {
+            if (w % superblock_words == 0) {
+                ranks[w / superblock_words] = total;
+            }
+            total += __builtin_popcountll(bits[w]);
+        }
+        if (n % superblock_words == 0) {
+            ranks[n / superblock_words] = total;
+        }
+        ranks_valid = true;
+    }
+
+    // Position of the k-th (0-based) set flag of a word
+    static size_t select_in_word(word_type word, size_t k) noexcept {
+        for (size_t i = 0; i < k; i++) {
+            word &= word - 1; // drop the lowest set flag
+        }
+        return __builtin_ctzll(word);
+    }
+
+public:
+    BitVector() noexcept
+        : bits(nullptr), _size(0), _words_capacity(0), ranks(nullptr), _ranks_capacity(0), ranks_valid(false) {}
+
+    explicit BitVector(size_t count, bool value = false) : BitVector() {
+        resize(count, value);
+    }
+
+    BitVector(const BitVector& other) : BitVector() {
+        *this = other;
+    }
+
+    BitVector(BitVector&& other) noexcept : BitVector() {
+        *this = std::move(other);
+    }
+
+    ~BitVector() {
+        delete[] bits;
+        delete[] ranks;
+    }
+
+    BitVector& operator=(const BitVector& other) {
+        if (this != &other) {
+            if (other.words() > _words_capacity) {
+                delete[] bits;
+                bits = new word_type[other.words()];
+                _words_capacity = other.words();
+            }
+            if (other.words() > 0) {
+                std::memcpy(bits, other.bits, other.words() * sizeof(word_type));
+            }
+            _size = other._size;
+            ranks_valid = false;
+        }
+        return *this;
+    }
+
+    BitVector& operator=(BitVector&& other) noexcept {
+        if (this != &other) {
+            delete[] bits;
+            delete[] ranks;
+            bits = other.bits;
+            _size = other._size;
+            _words_capacity = other._words_capacity;
+            ranks = other.ranks;
+            _ranks_capacity = other._ranks_capacity;
+            ranks_valid = other.ranks_valid;
+
+            other.bits = nullptr;
+            other._size = 0;
+            other._words_capacity = 0;
+            other.ranks = nullptr;
+            other._ranks_capacity = 0;
+            other.ranks_valid = false;
+        }
+        return *this;
+    }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return _words_capacity * word_bits; }
+
+    // The packed words; flag i is bit i % 64 of word i / 64
+    size_t words() const noexcept { return words_for(_size); }
+    const word_type* data() const noexcept { return bits; }
+
+    bool test(size_t pos) const noexcept { return (bits[pos / word_bits] & mask(pos)) != 0; }
+    bool operator[](size_t pos) const noexcept { return test(pos); }
+
+    bool at(size_t pos) const {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return test(pos);
+    }
+
+    void set(size_t pos) noexcept {
+        bits[pos / word_bits] |= mask(pos);
+        ranks_valid = false;
+    }
+    void set(size_t pos, bool value) noexcept {
+        if (value) {
+            set(pos);
+        }
+        else {
+            reset(pos);
+        }
+    }
+    void reset(size_t pos) noexcept {
+        bits[pos / word_bits] &= ~mask(pos);
+        ranks_valid = false;
+    }
+    void flip(size_t pos) noexcept {
+        bits[pos / word_bits] ^= mask(pos);
+        ranks_valid = false;
+    }
+
+    // Sets the flag and returns whether it was already set
+    bool test_and_set(size_t pos) noexcept {
+        word_type& word = bits[pos / word_bits];
+        bool was_set = (word & mask(pos)) != 0;
+        word |= mask(pos);
+        ranks_valid = false;
+        return was_set;
+    }
+
+    void set_all() noexcept {
+        if (_size > 0) {
+            std::memset(bits, 0xFF, words() * sizeof(word_type));
+            trim();
+        }
+        ranks_valid = false;
+    }
+
+    void reset_all() noexcept {
+        if (_size > 0) {
+            std::memset(bits, 0, words() * sizeof(word_type));
+        }
+        ranks_valid = false;
+    }
+
+    void resize(size_t count, bool value = false) {
+        const size_t old_size = _size;
+        const size_t old_words = words();
+        const size_t new_words = words_for(count);
+        if (new_words > _words_capacity) {
+            grow_words(new_words);
+        }
+        if (new_words > old_words) {
+            std::memset(bits + old_words, value ? 0xFF : 0, (new_words - old_words) * sizeof(word_type));
+        }
+        // flags added to the old last word
+        if (value && count > old_size) {
+            size_t stop = old_words * word_bits < count ? old_words * word_bits : count;
+            for (size_t i = old_size; i < stop; i++) {
+                bits[i / word_bits] |= mask(i);
+            }
+        }
+        _size = count;
+        if (_size > 0) {
+            trim();
+        }
+        ranks_valid = false;
+    }
+
+    void push_back(bool value) {
+        if (_size % word_bits == 0) {
+            if (words_for(_size + 1) > _words_capacity) {
+                grow_words(words_for(_size + 1));
+            }
+            bits[_size / word_bits] = 0;
+        }
+        if (value) {
+            bits[_size / word_bits] |= mask(_size);
+        }
+        _size++;
+        ranks_valid = false;
+    }
+
+    void pop_back() {
+        if (_size > 0) {
+            _size--;
+            bits[_size / word_bits] &= ~mask(_size);
+            ranks_valid = false;
+        }
+    }
+
+    void clear() noexcept {
+        _size = 0;
+        ranks_valid = false;
+    }
+
+    // Number of set flags
+    size_t count() const noexcept {
+        size_t total = 0;
+        for (size_t w = 0, n = words(); w < n; w++) {
+            total += __builtin_popcountll(bits[w]);
+        }
+        return total;
+    }
+
+    bool any() const noexcept {
+        for (size_t w = 0, n = words(); w < n; w++) {
+            if (bits[w] != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+    bool none() const noexcept { return !any(); }
+    bool all() const noexcept { return count() == _size; }
+
+    // Index of the first set flag at or after pos, or size()
+    size_t find_from(size_t pos) const noexcept {
+        if (pos >= _size) {
+            return _size;
+        }
+        size_t w = pos / word_bits;
+        word_type word = bits[w] & ~(mask(pos) - 1);
+        const size_t n = words();
+        while (word == 0) {
+            if (++w == n) {
+                return _size;
+            }
+            word = bits[w];
+        }
+        return w * word_bits + __builtin_ctzll(word);
+    }
+
+    // Index of the first set flag, or size()
+    size_t find_first() const noexcept { return find_from(0); }
+    // Index of the first set flag after pos, or size()
+    size_t find_next(size_t pos) const noexcept { return find_from(pos + 1); }
+
+    BitVector& operator&=(const BitVector& other) {
+        check_same_size(other);
+        for (size_t w = 0, n = words(); w < n; w++) {
+            bits[w] &= other.bits[w];
+        }
+        ranks_valid = false;
+        return *this;
+    }
+
+    BitVector& operator|=(const BitVector& other) {
+        check_same_size(other);
+        for (size_t w = 0, n = words(); w < n; w++) {
+            bits[w] |= other.bits[w];
+        }
+        ranks_valid = false;
+        return *this;
+    }
+
+    BitVector& operator^=(const BitVector& other) {
+        check_same_size(other);
+        for (size_t w = 0, n = words(); w < n; w++) {
+            bits[w] ^= other.bits[w];
+        }
+        ranks_valid = false;
+        return *this;
+    }
+
+    // Clears every flag that is set in other (this &= ~other)
+    BitVector& and_not(const BitVector& other) {
+        check_same_size(other);
+        for (size_t w = 0, n = words(); w < n; w++) {
+            bits[w] &= ~other.bits[w];
+        }
+        ranks_valid = false;
+        return *this;
+    }
+
+    // Flips every flag
+    BitVector& flip() noexcept {
+        for (size_t w = 0, n = words(); w < n; w++) {
+            bits[w] = ~bits[w];
+        }
+        if (_size > 0) {
+            trim();
+        }
+        ranks_valid = false;
+        return *this;
+    }
+
+    // Number of set flags in [0, pos); pos may equal size()
+    size_t rank(size_t pos) const {
+        if (pos > _size) throw (std::out_of_range("index is out of range"));
+        if (!ranks_valid) {
+            build_ranks();
+        }
+        const size_t w = pos / word_bits;
+        size_t total = ranks[w / superblock_words];
+        for (size_t i = w - w % superblock_words; i < w; i++) {
+            total += __builtin_popcountll(bits[i]);
+        }
+        if (pos % word_bits != 0) {
+            total += __builtin_popcountll(bits[w] & (mask(pos) - 1));
+        }
+        return total;
+    }
+
+    // Index of the k-th (0-based) set flag, or size() if there are k or fewer
+    size_t select(size_t k) const {
+        if (!ranks_valid) {
+            build_ranks();
+        }
+        const size_t n = words();
+        const size_t blocks = (n + superblock_words - 1) / superblock_words;
+
+        // last superblock with fewer than k + 1 flags before it
+        size_t lo = 0, hi = blocks;
+        while (hi - lo > 1) {
+            size_t mid = (lo + hi) / 2;
+            if (ranks[mid] <= k) {
+                lo = mid;
+            }
+            else {
+                hi = mid;
+            }
+        }
+
+        size_t remaining = k - (blocks > 0 ? ranks[lo] : 0);
+        for (size_t w = lo * superblock_words; w < n; w++) {
+            size_t ones = __builtin_popcountll(bits[w]);
+            if (remaining < ones) {
+                return w * word_bits + select_in_word(bits[w], remaining);
+            }
+            remaining -= ones;
+        }
+        return _size;
+    }
+
+    friend bool operator==(const BitVector& a, const BitVector& b) noexcept {
+        if (a._size != b._size) {
+            return false;
+        }
+        for (size_t w = 0, n = a.words(); w < n; w++) {
+            if (a.bits[w] != b.bits[w]) {
+                return false;
+            }
+        }
+        return true;
+    }
+    friend bool operator!=(const BitVector& a, const BitVector& b) noexcept { return !(a == b); }
+
+    friend BitVector operator&(BitVector a, const BitVector& b) { return a &= b; }
+    friend BitVector operator|(BitVector a, const BitVector& b) { return a |= b; }
+    friend BitVector operator^(BitVector a, const BitVector& b) { return a ^= b; }
+};
+
+/*
+    Dense visited set for graph traversals, with the same interface as
+    VisitedSet in graph/Graph.h: a vertex is unvisited, visited, or
+    processed (which implies visited). Two flags per vertex instead of a
+    size_t, so the whole set of a million vertex graph fits in 256 KB.
+*/
+class BitVisitedSet {
+    BitVector visited, processed;
+
+    void check(size_t vertex) const {
+        if (vertex >= visited.size()) {
+            throw std::invalid_argument("Vertex not in graph");
+        }
+    }
+
+public:
+    explicit BitVisitedSet(size_t size) : visited(size), processed(size) {}
+
+    void visit(size_t vertex) {
+        check(vertex);
+        visited.set(vertex);
+    }
+    void process(size_t vertex) {
+        check(vertex);
+        visited.set(vertex);
+        processed.set(vertex);
+    }
+    bool has_visited(size_t vertex) const {
+        check(vertex);
+        return visited.test(vertex);
+    }
+    bool has_processed(size_t vertex) const {
+        check(vertex);
+        return processed.test(vertex);
+    }
+
+    size_t size() const noexcept { return visited.size(); }
+    void clear() noexcept {
+        visited.clear();
+        processed.clear();
+    }
+
+    // The visited flags, e.g. to count or walk the visited vertices
+    const BitVector& visited_flags() const noexcept { return visited; }
+    const BitVector& processed_flags() const noexcept { return processed; }
+};
+
+#endif
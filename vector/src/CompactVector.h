@@ -0,0 +1,304 @@
+#ifndef COMPACT_VECTOR_H
+#define COMPACT_VECTOR_H
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, UINT32_MAX
+#include <new> // placement new, ::operator new
+#include <stdexcept> // std::out_of_range, std::length_error
+#include <utility> // std::move
+
+#include "Vector.h"
+#include "raw_storage.h"
+
+/*
+    CompactVector
+    -------------
+
+    A Vector whose object is a single pointer (8 bytes instead of Vector's
+    24). The size and capacity live as 32 bit counts at the front of the
+    heap block, and an empty CompactVector that never allocated is just a
+    null pointer:
+
+    block -> [ size | capacity | e0 e1 e2 ... ]
+               4 B     4 B
+
+    It is meant for huge numbers of mostly empty or tiny vectors (adjacency
+    lists, per-node attributes), where Vector's headers alone would cost
+    more than the elements:
+
+    Vector<CompactVector<uint32_t>> edges(50000000); // 400 MB of handles, not 1.2 GB
+
+    The API and iterator type are the same as Vector<T>. Differences:
+    - at most UINT32_MAX elements; growing past that throws std::length_error
+    - size() and capacity() read the heap block, so they cost a (usually
+      cached) load instead of being in the object
+    - the unused capacity is raw storage, as in SmallVector: elements are
+      constructed when added and destroyed when removed
+    - shrink_to_fit() gives the block back when the vector is empty
+*/
+
+template <class T>
+class CompactVector {
+    static_assert(alignof(T) <= __STDCPP_DEFAULT_NEW_ALIGNMENT__, "over-aligned element types are not supported");
+
+public:
+    using iterator = typename Vector<T>::iterator;
+
+private:
+    struct Header {
+        uint32_t size;
+        uint32_t capacity;
+    };
+
+    // The elements start at the first multiple of alignof(T) after the header
+    static constexpr size_t offset = (sizeof(Header) + alignof(T) - 1) / alignof(T) * alignof(T);
+
+    Header* block;
+
+    T* elements() const noexcept {
+        return block != nullptr ? reinterpret_cast<T*>(reinterpret_cast<char*>(block) + offset) : nullptr;
+    }
+
+    static Header* allocate(size_t capacity) {
+        Header* fresh = static_cast<Header*>(::operator new(offset + capacity * sizeof(T)));
+        fresh->size = 0;
+        fresh->capacity = static_cast<uint32_t>(capacity);
+        return fresh;
+    }
+
+    void destroy_all() noexcept {
+        if (block == nullptr) {
+            return;
+        }
+        raw_storage::destroy(elements(), block->size);
+        block->size = 0;
+    }
+
+    void release() noexcept {
+        destroy_all();
+        ::operator delete(block);
+        block = nullptr;
+    }
+
+    // Same doubling policy as Vector (0 -> 1 -> 2 -> 4 ...), capped at 32 bit counts
+    void grow(size_t min_capacity) {
+        size_t capacity = this->capacity() == 0 ? 1 : this->capacity() * 2;
+        if (capacity < min_capacity) {
+            capacity = min_capacity;
+        }
+        if (capacity > UINT32_MAX) {
+            if (min_capacity > UINT32_MAX) {
+                throw std::length_error("CompactVector holds at most 2^32 - 1 elements");
+            }
+            capacity = UINT32_MAX;
+        }
+
+        Header* bigger = allocate(capacity);
+        if (block != nullptr) {
+            raw_storage::relocate(elements(), block->size, reinterpret_cast<T*>(reinterpret_cast<char*>(bigger) + offset));
+            bigger->size = block->size;
+            ::operator delete(block);
+        }
+        block = bigger;
+    }
+
+    void set_size(size_t count) noexcept { block->size = static_cast<uint32_t>(count); }
+
+public:
+    CompactVector() noexcept : block(nullptr) {}
+
+    CompactVector(size_t count, const T& value) : CompactVector() {
+        reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            new (elements() + i) T(value);
+        }
+        if (count > 0) {
+            set_size(count);
+        }
+    }
+
+    explicit CompactVector(size_t count) : CompactVector() {
+        reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            new (elements() + i) T();
+        }
+        if (count > 0) {
+            set_size(count);
+        }
+    }
+
+    CompactVector(const CompactVector& other) : CompactVector() {
+        const size_t count = other.size();
+        reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            new (elements() + i) T(other.elements()[i]);
+        }
+        if (count > 0) {
+            set_size(count);
+        }
+    }
+
+    CompactVector(CompactVector&& other) noexcept : block(other.block) {
+        other.block = nullptr;
+    }
+
+    ~CompactVector() {
+        release();
+    }
+
+    CompactVector& operator=(const CompactVector& other) {
+        if (this != &other) {
+            destroy_all();
+            const size_t count = other.size();
+            reserve(count);
+            for (size_t i = 0; i < count; i++) {
+                new (elements() + i) T(other.elements()[i]);
+            }
+            if (count > 0) {
+                set_size(count);
+            }
+        }
+        return *this;
+    }
+
+    CompactVector& operator=(CompactVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            block = other.block;
+            other.block = nullptr;
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(elements()); }
+    iterator end() noexcept { return iterator(elements()) + size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    size_t size() const noexcept { return block != nullptr ? block->size : 0; }
+    size_t capacity() const noexcept { return block != nullptr ? block->capacity : 0; }
+
+    // Direct access to the elements (nullptr when nothing has been allocated)
+    T* data() noexcept { return elements(); }
+    const T* data() const noexcept { return elements(); }
+
+    T& at(size_t pos) {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return elements()[pos];
+    }
+    const T& at(size_t pos) const {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return elements()[pos];
+    }
+
+    T& operator[](size_t pos) { return elements()[pos]; }
+    const T& operator[](size_t pos) const { return elements()[pos]; }
+
+    T& front() { return elements()[0]; }
+    const T& front() const { return elements()[0]; }
+    T& back() { return elements()[size() - 1]; }
+    const T& back() const { return elements()[size() - 1]; }
+
+    void reserve(size_t count) {
+        if (count > capacity()) {
+            grow(count);
+        }
+    }
+
+    // Frees the block of an empty vector so it goes back to costing 8 bytes
+    void shrink_to_fit() noexcept {
+        if (empty()) {
+            release();
+        }
+    }
+
+    void push_back(const T& value) {
+        const size_t n = size();
+        if (n == capacity()) {
+            T copy = value; // value may live in the block that grow() frees
+            grow(n + 1);
+            new (elements() + n) T(std::move(copy));
+        }
+        else {
+            new (elements() + n) T(value);
+        }
+        set_size(n + 1);
+    }
+
+    void push_back(T&& value) {
+        const size_t n = size();
+        if (n == capacity()) {
+            T moved = std::move(value);
+            grow(n + 1);
+            new (elements() + n) T(std::move(moved));
+        }
+        else {
+            new (elements() + n) T(std::move(value));
+        }
+        set_size(n + 1);
+    }
+
+    void pop_back() {
+        const size_t n = size();
+        if (n > 0) {
+            set_size(n - 1);
+            elements()[n - 1].~T();
+        }
+    }
+
+    iterator insert(iterator pos, const T& value) {
+        return insert(pos, T(value));
+    }
+
+    iterator insert(iterator pos, T&& value) {
+        const size_t index = pos - begin();
+        const size_t n = size();
+        T moved = std::move(value);
+
+        if (n == capacity()) {
+            grow(n + 1);
+        }
+        raw_storage::insert(elements(), n, index, std::move(moved));
+        set_size(n + 1);
+        return iterator(elements() + index);
+    }
+
+    iterator insert(iterator pos, size_t count, const T& value) {
+        const size_t index = pos - begin();
+        const size_t n = size();
+        if (count == 0) {
+            return iterator(elements() + index);
+        }
+        T copy = value;
+
+        if (n + count > capacity()) {
+            grow(n + count);
+        }
+        raw_storage::insert(elements(), n, index, count, copy);
+        set_size(n + count);
+        return iterator(elements() + index);
+    }
+
+    iterator erase(iterator pos) {
+        if (pos < begin() || pos >= end()) {
+            return end();
+        }
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(iterator first, iterator last) {
+        if (first == last) {
+            return first;
+        }
+        const size_t num = last - first;
+        const size_t n = size();
+        raw_storage::erase(elements(), n, static_cast<size_t>(first - begin()), num);
+        set_size(n - num);
+        return first;
+    }
+
+    // Destroys the elements but keeps the block, like Vector::clear
+    void clear() noexcept { destroy_all(); }
+};
+
+#endif
@@ -0,0 +1,280 @@
+#ifndef CONCURRENT_VECTOR_H
+#define CONCURRENT_VECTOR_H
+
+#include <atomic>
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <new> // placement new, ::operator new
+#include <stdexcept> // std::out_of_range
+#include <utility> // std::forward
+
+#include "SegmentedVector.h" // segmented::Layout
+
+/*
+    ConcurrentVector
+    ----------------
+
+    An append-only vector that many threads can push into at once without
+    a lock. It uses SegmentedVector's block layout, so elements never move
+    and a slot's address is known as soon as its index is.
+
+    - push_back/emplace_back claim one index with an atomic fetch_add and
+      construct the element in place; grow_by(n) claims n at once.
+    - The block holding a new index is allocated by the first thread that
+      needs it; racing threads agree on one block with a compare-exchange.
+    - size() is the published size: every element below it is fully
+      constructed. Writers never wait for each other. Each block carries a
+      ready flag per slot; a writer sets the flags of the elements it has
+      built and then moves size() forward over the run of ready slots
+      after it. size() therefore stops only at the oldest append still in
+      flight, and moves on as soon as that one is done, however many
+      appends keep starting behind it.
+
+    Readers may call size(), operator[] below size(), and iterate from
+    begin() to end() while writers append. end() is a snapshot of size()
+    taken when it is called. Element access itself is not synchronized:
+    writing to an element that other threads read needs its own locking.
+
+    Copying, clear() and destruction are not thread safe and must only
+    happen once every writer is done. An element constructor that throws
+    leaves its slot never ready, which stops size() from advancing past it,
+    so T's constructors used for appending must not throw.
+*/
+
+template <class T, size_t FirstBlock = 16>
+class ConcurrentVector {
+    using layout = segmented::Layout<FirstBlock>;
+
+public:
+    class iterator;
+
+private:
+    using flag = std::atomic<unsigned char>;
+
+    // Each block is block_size elements followed by block_size ready flags
+    std::atomic<T*> blocks[layout::max_blocks] = {};
+    std::atomic<size_t> reserved{0};  // indices handed out
+    std::atomic<size_t> published{0}; // every index below is constructed
+
+    static flag* flags_of(T* block, size_t k) noexcept {
+        return reinterpret_cast<flag*>(reinterpret_cast<unsigned char*>(block) + layout::block_size(k) * sizeof(T));
+    }
+
+    // Returns block k, allocating it if nobody has yet
+    T* block(size_t k) {
+        T* b = blocks[k].load(std::memory_order_acquire);
+        if (b != nullptr) {
+            return b;
+        }
+        const size_t n = layout::block_size(k);
+        T* fresh = static_cast<T*>(::operator new(n * (sizeof(T) + sizeof(flag))));
+        flag* flags = flags_of(fresh, k);
+        for (size_t i = 0; i < n; i++) {
+            new (flags + i) flag(0);
+        }
+        // sequentially consistent, like the flags (see publish)
+        if (blocks[k].compare_exchange_strong(b, fresh)) {
+            return fresh;
+        }
+        ::operator delete(fresh); // another thread won, b holds its block
+        return b;
+    }
+
+    T* slot(size_t pos) {
+        size_t k = layout::block_of(pos);
+        return block(k) + (pos - layout::block_start(k));
+    }
+
+    // Only for indices below published, whose blocks are known to exist
+    T* published_slot(size_t pos) const noexcept {
+        size_t k = layout::block_of(pos);
+        return blocks[k].load(std::memory_order_acquire) + (pos - layout::block_start(k));
+    }
+
+    // The ready flag of a slot, or nullptr if its block is not allocated
+    // yet: an index can be claimed long before its writer gets to slot()
+    flag* ready(size_t pos) const noexcept {
+        size_t k = layout::block_of(pos);
+        T* b = blocks[k].load();
+        return b != nullptr ? flags_of(b, k) + (pos - layout::block_start(k)) : nullptr;
+    }
+
+    // Moves published over the ready slots after it, stopping at the first
+    // slot not built yet (or whose block does not even exist yet). The
+    // flags, block pointers, reserved and published are all sequentially
+    // consistent: of two writers that finish out of order, the later one to
+    // scan sees the other's flag, so no ready slot is left behind unpublished
+    void publish() {
+        size_t current = published.load();
+        for (;;) {
+            const size_t limit = reserved.load();
+            size_t end = current;
+            for (; end < limit; end++) {
+                const flag* f = ready(end);
+                if (f == nullptr || f->load() == 0) {
+                    break;
+                }
+            }
+            if (end == current) {
+                return;
+            }
+            // on failure current is reloaded, and the scan restarts from there
+            if (published.compare_exchange_weak(current, end)) {
+                current = end;
+            }
+        }
+    }
+
+    void release() noexcept {
+        clear();
+        for (size_t k = 0; k < layout::max_blocks; k++) {
+            // the flags are trivially destructible and go with the block
+            ::operator delete(blocks[k].exchange(nullptr, std::memory_order_relaxed));
+        }
+    }
+
+public:
+    ConcurrentVector() noexcept {}
+
+    ConcurrentVector(const ConcurrentVector& other) {
+        const size_t n = other.size();
+        for (size_t i = 0; i < n; i++) {
+            push_back(other[i]);
+        }
+    }
+
+    ConcurrentVector& operator=(const ConcurrentVector&) = delete;
+
+    ~ConcurrentVector() {
+        release();
+    }
+
+    // Published size: elements [0, size()) are readable
+    size_t size() const noexcept { return published.load(std::memory_order_acquire); }
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size()); }
+
+    T& operator[](size_t pos) noexcept { return *published_slot(pos); }
+    const T& operator[](size_t pos) const noexcept { return *published_slot(pos); }
+
+    T& at(size_t pos) {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return *published_slot(pos);
+    }
+    const T& at(size_t pos) const {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return *published_slot(pos);
+    }
+
+    // Allocates the blocks for count elements up front
+    void reserve(size_t count) {
+        for (size_t k = 0; k < layout::max_blocks && layout::block_start(k) < count; k++) {
+            block(k);
+        }
+    }
+
+    // Appends one element and returns its index
+    template <class... Args>
+    size_t emplace_back(Args&&... args) {
+        const size_t pos = reserved.fetch_add(1);
+        new (slot(pos)) T(std::forward<Args>(args)...);
+        ready(pos)->store(1);
+        publish();
+        return pos;
+    }
+
+    size_t push_back(const T& value) { return emplace_back(value); }
+    size_t push_back(T&& value) { return emplace_back(std::move(value)); }
+
+    // Appends count copies of value as one contiguous run of indices; returns the first
+    size_t grow_by(size_t count, const T& value = T()) {
+        const size_t first = reserved.fetch_add(count);
+        for (size_t i = first; i < first + count; i++) {
+            new (slot(i)) T(value);
+            ready(i)->store(1);
+        }
+        publish();
+        return first;
+    }
+
+    // Destroys every element but keeps the blocks; not thread safe
+    void clear() noexcept {
+        const size_t n = published.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < n; i++) {
+            published_slot(i)->~T();
+            ready(i)->store(0, std::memory_order_relaxed);
+        }
+        published.store(0, std::memory_order_relaxed);
+        reserved.store(0, std::memory_order_relaxed);
+    }
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = T*;
+        using reference         = T&;
+
+    private:
+        ConcurrentVector* owner;
+        difference_type index;
+
+    public:
+        iterator() : owner(nullptr), index(0) {}
+        iterator(ConcurrentVector* owner, difference_type index) : owner(owner), index(index) {}
+
+        iterator& operator=(const iterator&) noexcept = default;
+
+        [[nodiscard]] reference operator*() const noexcept { return *owner->published_slot(index); }
+        [[nodiscard]] pointer operator->() const noexcept { return owner->published_slot(index); }
+        [[nodiscard]] reference operator[](difference_type offset) const noexcept {
+            return *owner->published_slot(index + offset);
+        }
+
+        iterator& operator++() noexcept {
+            ++index;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++index;
+            return temp;
+        }
+        iterator& operator--() noexcept {
+            --index;
+            return *this;
+        }
+        iterator operator--(int) noexcept {
+            iterator temp = *this;
+            --index;
+            return temp;
+        }
+
+        iterator& operator+=(difference_type offset) noexcept {
+            index += offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator+(difference_type offset) const noexcept { return iterator(owner, index + offset); }
+        [[nodiscard]] friend iterator operator+(difference_type offset, const iterator& it) noexcept { return it + offset; }
+
+        iterator& operator-=(difference_type offset) noexcept {
+            index -= offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator-(difference_type offset) const noexcept { return iterator(owner, index - offset); }
+
+        [[nodiscard]] difference_type operator-(const iterator& rhs) const noexcept { return index - rhs.index; }
+
+        [[nodiscard]] bool operator==(const iterator& rhs) const noexcept { return index == rhs.index; }
+        [[nodiscard]] bool operator!=(const iterator& rhs) const noexcept { return index != rhs.index; }
+        [[nodiscard]] bool operator<(const iterator& rhs) const noexcept { return index < rhs.index; }
+        [[nodiscard]] bool operator>(const iterator& rhs) const noexcept { return index > rhs.index; }
+        [[nodiscard]] bool operator<=(const iterator& rhs) const noexcept { return index <= rhs.index; }
+        [[nodiscard]] bool operator>=(const iterator& rhs) const noexcept { return index >= rhs.index; }
+    };
+};
+
+#endif
@@ -0,0 +1,249 @@
+#ifndef COW_VECTOR_H
+#define COW_VECTOR_H
+
+#include <atomic>
+#include <cstddef> // size_t
+#include <stdexcept> // std::out_of_range
+#include <utility> // std::move
+
+#include "Vector.h"
+
+/*
+    CowVector
+    ---------
+
+    A copy-on-write Vector. Copies share one reference counted buffer, so
+    handing a large vector to another thread is O(1):
+
+    CowVector<double> prices = load();
+    CowVector<double> snapshot = prices.snapshot(); // no element is copied
+    prices.push_back(1.5);                          // prices copies its elements now
+                                                    // and snapshot keeps the old ones
+
+    The first mutation of a shared vector copies the elements into a
+    private buffer. Any non-const access counts as a mutation: that
+    includes non-const operator[], at(), front(), back() and begin(). For
+    reads that never copy, call them on a const CowVector (or use
+    cbegin()/cend() and get()).
+
+    A reference, iterator or data() pointer from a non-const access may
+    still be written through later, so once one has been handed out the
+    buffer is unshareable: copies, share() and snapshot() of this vector
+    deep-copy the elements instead of sharing them, the way std::string's
+    old copy-on-write strings did. The buffer becomes shareable again when
+    this vector next moves to a new buffer (a push_back past capacity).
+
+    Thread safety: the reference count is atomic, so different CowVector
+    objects sharing a buffer can be read, copied and destroyed on different
+    threads at the same time, and each may also be mutated by its own
+    thread. Like any object, one CowVector must not be mutated while
+    another thread uses that same object.
+*/
+
+template <class T>
+class CowVector {
+public:
+    using iterator = typename Vector<T>::iterator;
+    using const_iterator = const T*;
+
+private:
+    struct Buffer {
+        std::atomic<size_t> refs;
+        size_t capacity;
+        T* array;
+
+        explicit Buffer(size_t capacity) : refs(1), capacity(capacity), array(new T[capacity]) {}
+        ~Buffer() { delete[] array; }
+    };
+
+    Buffer* buffer;
+    size_t _size;
+    bool unshareable = false; // a mutable reference into buffer may be live
+
+    static void release(Buffer* b) noexcept {
+        if (b != nullptr && b->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            delete b;
+        }
+    }
+
+    // Copies the elements into a new private buffer of the given capacity
+    void reallocate(size_t capacity) {
+        Buffer* fresh = new Buffer(capacity);
+        const bool unique = buffer->refs.load(std::memory_order_acquire) == 1;
+        for (size_t i = 0; i < _size; i++) {
+            // nobody else can see a unique buffer, so its elements can be moved
+            fresh->array[i] = unique ? std::move(buffer->array[i]) : buffer->array[i];
+        }
+        release(buffer);
+        buffer = fresh;
+        unshareable = false; // references into the old buffer do not reach this one
+    }
+
+    // The buffer a copy of this vector gets: this one, or its own copy if it can't be shared
+    Buffer* share_buffer() const {
+        if (buffer == nullptr) {
+            return nullptr;
+        }
+        if (unshareable) {
+            if (_size == 0) {
+                return nullptr;
+            }
+            Buffer* copy = new Buffer(_size);
+            for (size_t i = 0; i < _size; i++) {
+                copy->array[i] = buffer->array[i];
+            }
+            return copy;
+        }
+        buffer->refs.fetch_add(1, std::memory_order_relaxed);
+        return buffer;
+    }
+
+    // Makes the buffer private before handing out a mutable reference into it
+    T* leak() {
+        detach();
+        unshareable = true;
+        return buffer != nullptr ? buffer->array : nullptr;
+    }
+
+    // Makes the buffer private before a write
+    void detach() {
+        if (buffer != nullptr && buffer->refs.load(std::memory_order_acquire) != 1) {
+            reallocate(buffer->capacity);
+        }
+    }
+
+    // Makes the buffer private with room for one more element (Vector's growth policy)
+    void detach_for_push() {
+        if (buffer == nullptr) {
+            buffer = new Buffer(1);
+        }
+        else if (_size == buffer->capacity) {
+            reallocate(buffer->capacity * 2);
+        }
+        else {
+            detach();
+        }
+    }
+
+public:
+    CowVector() noexcept : buffer(nullptr), _size(0) {}
+
+    CowVector(size_t count, const T& value) : buffer(count ? new Buffer(count) : nullptr), _size(count) {
+        for (size_t i = 0; i < count; i++) {
+            buffer->array[i] = value;
+        }
+    }
+
+    // Deep copies a Vector once; CowVector copies after that are free
+    explicit CowVector(const Vector<T>& other) : buffer(other.size() ? new Buffer(other.size()) : nullptr), _size(other.size()) {
+        for (size_t i = 0; i < _size; i++) {
+            buffer->array[i] = other[i];
+        }
+    }
+
+    CowVector(const CowVector& other) : buffer(other.share_buffer()), _size(buffer != nullptr ? other._size : 0) {}
+
+    CowVector(CowVector&& other) noexcept : buffer(other.buffer), _size(other._size), unshareable(other.unshareable) {
+        other.buffer = nullptr;
+        other._size = 0;
+        other.unshareable = false;
+    }
+
+    ~CowVector() {
+        release(buffer);
+    }
+
+    CowVector& operator=(const CowVector& other) {
+        if (this != &other) {
+            Buffer* shared = other.share_buffer();
+            release(buffer);
+            buffer = shared;
+            _size = buffer != nullptr ? other._size : 0;
+            unshareable = false;
+        }
+        return *this;
+    }
+
+    CowVector& operator=(CowVector&& other) noexcept {
+        if (this != &other) {
+            release(buffer);
+            buffer = other.buffer;
+            _size = other._size;
+            unshareable = other.unshareable;
+            other.buffer = nullptr;
+            other._size = 0;
+            other.unshareable = false;
+        }
+        return *this;
+    }
+
+    // O(1) copies sharing this vector's elements until either side writes
+    // (deep copies while the buffer is unshareable). They are the copy
+    // constructor under names that say what they cost.
+    CowVector share() const { return *this; }
+    CowVector snapshot() const { return *this; }
+
+    // Number of CowVectors sharing the elements (0 when nothing is allocated)
+    size_t use_count() const noexcept {
+        return buffer != nullptr ? buffer->refs.load(std::memory_order_acquire) : 0;
+    }
+    bool is_shared() const noexcept { return use_count() > 1; }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return buffer != nullptr ? buffer->capacity : 0; }
+
+    // Reads, never copy
+    const_iterator begin() const noexcept { return buffer != nullptr ? buffer->array : nullptr; }
+    const_iterator end() const noexcept { return begin() + _size; }
+    const_iterator cbegin() const noexcept { return begin(); }
+    const_iterator cend() const noexcept { return end(); }
+    const T* data() const noexcept { return begin(); }
+
+    const T& get(size_t pos) const noexcept { return buffer->array[pos]; }
+    const T& operator[](size_t pos) const noexcept { return buffer->array[pos]; }
+    const T& at(size_t pos) const {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return buffer->array[pos];
+    }
+    const T& front() const { return buffer->array[0]; }
+    const T& back() const { return buffer->array[_size - 1]; }
+
+    // Writes, copy the elements first if they are shared and leave the buffer unshareable
+    iterator begin() { return iterator(leak()); }
+    iterator end() { return begin() + _size; }
+    T* data() { return leak(); }
+
+    T& operator[](size_t pos) { return leak()[pos]; }
+    T& at(size_t pos) {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return leak()[pos];
+    }
+    T& front() { return leak()[0]; }
+    T& back() { return leak()[_size - 1]; }
+
+    void push_back(const T& value) {
+        T copy = value; // value may live in the buffer that is about to be released
+        detach_for_push();
+        buffer->array[_size] = std::move(copy);
+        _size++;
+    }
+
+    void push_back(T&& value) {
+        T moved = std::move(value);
+        detach_for_push();
+        buffer->array[_size] = std::move(moved);
+        _size++;
+    }
+
+    // Shrinking only changes this vector's size, so it never copies
+    void pop_back() noexcept {
+        if (_size > 0) {
+            _size--;
+        }
+    }
+
+    void clear() noexcept { _size = 0; }
+};
+
+#endif
@@ -0,0 +1,294 @@
+#ifndef GAP_BUFFER_H
+#define GAP_BUFFER_H
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <stdexcept> // std::out_of_range
+#include <utility> // std::move
+
+/*
+    GapBuffer
+    ---------
+
+    A Vector for edit-heavy sequences (text, logs) where inserts and erases
+    cluster around a moving cursor. The unused capacity is kept as a gap at
+    the last edit position instead of at the end:
+
+    [ a b c d _ _ _ _ e f ]     "abcdef" with the gap after 'd'
+              ^ gap
+
+    - insert/erase at the gap are O(1): they only move the gap's edges
+    - an edit elsewhere first moves the gap there, shifting only the
+      elements in between, so it costs O(distance from the last edit)
+      rather than O(size() - pos) as in Vector
+    - when the gap is used up the buffer doubles, like Vector, and the new
+      gap is placed at the edit position
+
+    Element i is at array[i] before the gap and array[i + gap size] after
+    it, so random access stays O(1) and the iterators are random access.
+    Iterators hold a position, not a pointer: they survive gap moves but,
+    as in Vector, refer to a different element after an insert or erase
+    before them.
+*/
+
+template <class T>
+class GapBuffer {
+public:
+    class iterator;
+
+private:
+    T* array;
+    size_t _capacity;
+    size_t gap_begin, gap_end; // the gap is array[gap_begin, gap_end)
+
+    size_t gap_size() const noexcept { return gap_end - gap_begin; }
+    size_t physical(size_t pos) const noexcept { return pos < gap_begin ? pos : pos + gap_size(); }
+
+    // Moves the gap so that it starts at logical position pos
+    void move_gap(size_t pos) {
+        while (gap_begin > pos) {
+            // element before the gap moves to just before the gap's end
+            array[--gap_end] = std::move(array[--gap_begin]);
+        }
+        while (gap_begin < pos) {
+            array[gap_begin++] = std::move(array[gap_end++]);
+        }
+    }
+
+    // Makes the gap at least min_gap long, keeping it where it is
+    void grow(size_t min_gap) {
+        const size_t used = size();
+        size_t capacity = _capacity == 0 ? 1 : _capacity * 2;
+        while (capacity - used < min_gap) {
+            capacity *= 2;
+        }
+
+        T* bigger = new T[capacity];
+        const size_t tail = _capacity - gap_end;
+        for (size_t i = 0; i < gap_begin; i++) {
+            bigger[i] = std::move(array[i]);
+        }
+        for (size_t i = 0; i < tail; i++) {
+            bigger[capacity - tail + i] = std::move(array[gap_end + i]);
+        }
+
+        delete[] array;
+        array = bigger;
+        gap_end = capacity - tail;
+        _capacity = capacity;
+    }
+
+public:
+    GapBuffer() noexcept : array(nullptr), _capacity(0), gap_begin(0), gap_end(0) {}
+
+    GapBuffer(size_t count, const T& value) : array(new T[count]), _capacity(count), gap_begin(count), gap_end(count) {
+        for (size_t i = 0; i < count; i++) {
+            array[i] = value;
+        }
+    }
+
+    explicit GapBuffer(size_t count) : array(new T[count]()), _capacity(count), gap_begin(count), gap_end(count) {}
+
+    GapBuffer(const GapBuffer& other)
+        : array(new T[other._capacity]), _capacity(other._capacity), gap_begin(other.gap_begin), gap_end(other.gap_end) {
+        for (size_t i = 0; i < gap_begin; i++) {
+            array[i] = other.array[i];
+        }
+        for (size_t i = gap_end; i < _capacity; i++) {
+            array[i] = other.array[i];
+        }
+    }
+
+    GapBuffer(GapBuffer&& other) noexcept
+        : array(other.array), _capacity(other._capacity), gap_begin(other.gap_begin), gap_end(other.gap_end) {
+        other.array = nullptr;
+        other._capacity = other.gap_begin = other.gap_end = 0;
+    }
+
+    ~GapBuffer() {
+        delete[] array;
+    }
+
+    GapBuffer& operator=(const GapBuffer& other) {
+        if (this != &other) {
+            GapBuffer copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    GapBuffer& operator=(GapBuffer&& other) noexcept {
+        if (this != &other) {
+            delete[] array;
+            array = other.array;
+            _capacity = other._capacity;
+            gap_begin = other.gap_begin;
+            gap_end = other.gap_end;
+
+            other.array = nullptr;
+            other._capacity = other.gap_begin = other.gap_end = 0;
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, size()); }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    size_t size() const noexcept { return _capacity - gap_size(); }
+    size_t capacity() const noexcept { return _capacity; }
+
+    // Logical position of the gap, i.e. of the last edit
+    size_t cursor() const noexcept { return gap_begin; }
+    // Moves the gap to pos ahead of a burst of edits there
+    void set_cursor(size_t pos) {
+        if (pos > size()) throw (std::out_of_range("index is out of range"));
+        move_gap(pos);
+    }
+
+    T& at(size_t pos) {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return array[physical(pos)];
+    }
+    const T& at(size_t pos) const {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return array[physical(pos)];
+    }
+
+    T& operator[](size_t pos) { return array[physical(pos)]; }
+    const T& operator[](size_t pos) const { return array[physical(pos)]; }
+
+    T& front() { return (*this)[0]; }
+    const T& front() const { return (*this)[0]; }
+    T& back() { return (*this)[size() - 1]; }
+    const T& back() const { return (*this)[size() - 1]; }
+
+    void push_back(const T& value) { insert(end(), value); }
+    void push_back(T&& value) { insert(end(), std::move(value)); }
+
+    void pop_back() {
+        if (!empty()) {
+            erase(end() - 1);
+        }
+    }
+
+    iterator insert(iterator pos, const T& value) {
+        T copy = value; // value may be an element that moves with the gap
+        return insert(pos, std::move(copy));
+    }
+
+    iterator insert(iterator pos, T&& value) {
+        const size_t index = pos.position();
+        move_gap(index);
+        if (gap_size() == 0) {
+            grow(1);
+        }
+        array[gap_begin++] = std::move(value);
+        return iterator(this, index);
+    }
+
+    iterator insert(iterator pos, size_t count, const T& value) {
+        const size_t index = pos.position();
+        T copy = value;
+        move_gap(index);
+        if (gap_size() < count) {
+            grow(count);
+        }
+        for (size_t i = 0; i < count; i++) {
+            array[gap_begin++] = copy;
+        }
+        return iterator(this, index);
+    }
+
+    iterator erase(iterator pos) {
+        if (pos < begin() || pos >= end()) {
+            return end();
+        }
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(iterator first, iterator last) {
+        const size_t index = first.position();
+        if (first == last) {
+            return first;
+        }
+        // the erased elements become part of the gap
+        move_gap(index);
+        gap_end += last - first;
+        return iterator(this, index);
+    }
+
+    void clear() noexcept {
+        gap_begin = 0;
+        gap_end = _capacity;
+    }
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = T*;
+        using reference         = T&;
+
+    private:
+        GapBuffer* owner;
+        difference_type index;
+
+    public:
+        iterator() : owner(nullptr), index(0) {}
+        iterator(GapBuffer* owner, difference_type index) : owner(owner), index(index) {}
+
+        iterator& operator=(const iterator&) noexcept = default;
+
+        [[nodiscard]] reference operator*() const noexcept { return (*owner)[index]; }
+        [[nodiscard]] pointer operator->() const noexcept { return &(*owner)[index]; }
+        [[nodiscard]] reference operator[](difference_type offset) const noexcept { return (*owner)[index + offset]; }
+
+        // Logical position of the element
+        [[nodiscard]] size_t position() const noexcept { return static_cast<size_t>(index); }
+
+        iterator& operator++() noexcept {
+            ++index;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++index;
+            return temp;
+        }
+        iterator& operator--() noexcept {
+            --index;
+            return *this;
+        }
+        iterator operator--(int) noexcept {
+            iterator temp = *this;
+            --index;
+            return temp;
+        }
+
+        iterator& operator+=(difference_type offset) noexcept {
+            index += offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator+(difference_type offset) const noexcept { return iterator(owner, index + offset); }
+        [[nodiscard]] friend iterator operator+(difference_type offset, const iterator& it) noexcept { return it + offset; }
+
+        iterator& operator-=(difference_type offset) noexcept {
+            index -= offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator-(difference_type offset) const noexcept { return iterator(owner, index - offset); }
+
+        [[nodiscard]] difference_type operator-(const iterator& rhs) const noexcept { return index - rhs.index; }
+
+        [[nodiscard]] bool operator==(const iterator& rhs) const noexcept { return index == rhs.index; }
+        [[nodiscard]] bool operator!=(const iterator& rhs) const noexcept { return index != rhs.index; }
+        [[nodiscard]] bool operator<(const iterator& rhs) const noexcept { return index < rhs.index; }
+        [[nodiscard]] bool operator>(const iterator& rhs) const noexcept { return index > rhs.index; }
+        [[nodiscard]] bool operator<=(const iterator& rhs) const noexcept { return index <= rhs.index; }
+        [[nodiscard]] bool operator>=(const iterator& rhs) const noexcept { return index >= rhs.index; }
+    };
+};
+
+#endif
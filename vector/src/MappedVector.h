@@ -0,0 +1,314 @@
+#ifndef MAPPED_VECTOR_H
+#define MAPPED_VECTOR_H
+
+#include <cerrno> // errno
+#include <cstddef> // size_t
+#include <cstdint> // uint64_t
+#include <cstring> // std::memcmp, std::memcpy, std::strerror
+#include <stdexcept> // std::out_of_range, std::runtime_error, std::length_error
+#include <string>
+#include <type_traits> // std::is_trivially_copyable
+
+#include <fcntl.h> // open
+#include <sys/mman.h> // mmap, munmap, msync
+#include <sys/stat.h> // fstat
+#include <unistd.h> // close, ftruncate, pread, sysconf
+
+#include "Vector.h"
+
+/*
+    MappedVector
+    ------------
+
+    A Vector of trivially copyable records whose storage is a file mapped
+    into memory with mmap (POSIX only). Opening a file does not read it:
+    pages are faulted in as they are touched, so opening is O(1) no matter
+    how large the file is.
+
+    File layout: a 64 byte header (magic, element size, element count)
+    followed by the raw elements. The file is always capacity() elements
+    long; size() is kept in the header.
+
+    Read-write mappings reserve a large range of virtual addresses up front
+    and grow the file inside it, so growth never moves the array: pointers,
+    references and iterators stay valid until the MappedVector is destroyed.
+
+    Example:
+
+    {
+        MappedVector<Record> log("records.dat");    // created if missing
+        log.push_back(Record{...});
+        log.flush();                                 // msync to disk
+    }
+
+    MappedVector<Record> ro("records.dat", MappedVector<Record>::READ_ONLY);
+    for (const Record& r : ro) { ... }
+
+    Writing through an iterator of a READ_ONLY mapping faults (the pages
+    are mapped without write permission).
+*/
+
+template <class T>
+class MappedVector {
+    static_assert(std::is_trivially_copyable<T>::value, "MappedVector requires a trivially copyable type");
+
+public:
+    using iterator = typename Vector<T>::iterator;
+
+    enum Mode { READ_ONLY, READ_WRITE };
+
+    // Default virtual reservation for read-write mappings (1 TiB on 64 bit)
+    static constexpr size_t DEFAULT_RESERVE = sizeof(size_t) >= 8 ? (size_t(1) << 40) : (size_t(1) << 30);
+
+private:
+    struct Header {
+        char magic[8];
+        uint64_t element_size;
+        uint64_t size;
+        uint64_t unused[5];
+    };
+    static_assert(sizeof(Header) == 64, "header must keep the elements 64 byte aligned");
+
+    static constexpr char MAGIC[8] = { 'M', 'V', 'E', 'C', 'T', 'O', 'R', '1' };
+
+    int fd;
+    Mode mode;
+    char* base; // start of the mapping (the header)
+    size_t _reserved; // bytes of address space owned by this object
+    size_t _capacity;
+
+    Header* header() const noexcept { return reinterpret_cast<Header*>(base); }
+    T* array() const noexcept { return reinterpret_cast<T*>(base + sizeof(Header)); }
+
+    [[noreturn]] static void fail(const std::string& what) {
+        throw std::runtime_error("MappedVector: " + what + ": " + std::strerror(errno));
+    }
+
+    static size_t page_size() noexcept {
+        static const size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    static size_t file_bytes(size_t capacity) noexcept {
+        return sizeof(Header) + capacity * sizeof(T);
+    }
+
+    // Resizes the file and maps it over the start of the reservation.
+    // MAP_FIXED replaces the old mapping in place, so base never moves.
+    void remap(size_t capacity) {
+        size_t bytes = file_bytes(capacity);
+        if (bytes > _reserved) {
+            throw std::length_error("MappedVector: capacity exceeds the reserved address range");
+        }
+        if (ftruncate(fd, static_cast<off_t>(bytes)) != 0) {
+            fail("ftruncate");
+        }
+        if (mmap(base, bytes, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_FIXED, fd, 0) == MAP_FAILED) {
+            fail("mmap");
+        }
+        _capacity = capacity;
+    }
+
+    void grow() {
+        // start at one page of elements instead of growing 1, 2, 4, ... through tiny remaps
+        size_t initial = (page_size() - sizeof(Header)) / sizeof(T);
+        reserve(_capacity == 0 ? (initial > 0 ? initial : 1) : _capacity * 2);
+    }
+
+    // Whether the file behind fd, length bytes long, is a MappedVector of T
+    static bool holds_this_type(int fd, size_t length) noexcept {
+        Header h;
+        if (length < sizeof(Header) || pread(fd, &h, sizeof(h), 0) != static_cast<ssize_t>(sizeof(h))) {
+            return false;
+        }
+        return std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) == 0 && h.element_size == sizeof(T)
+            && h.size <= (length - sizeof(Header)) / sizeof(T);
+    }
+
+    void writable() const {
+        if (mode == READ_ONLY) {
+            throw std::logic_error("MappedVector: mapping is read-only");
+        }
+    }
+
+    void release() noexcept {
+        if (base != nullptr) {
+            munmap(base, _reserved);
+        }
+        if (fd >= 0) {
+            close(fd);
+        }
+        base = nullptr;
+        fd = -1;
+        _reserved = 0;
+        _capacity = 0;
+    }
+
+public:
+    // Maps the file at path. READ_WRITE creates the file if it does not exist.
+    // Throws std::runtime_error if the file cannot be mapped or holds another type.
+    explicit MappedVector(const std::string& path, Mode mode = READ_WRITE, size_t reserve_bytes = DEFAULT_RESERVE)
+        : fd(-1), mode(mode), base(nullptr), _reserved(0), _capacity(0) {
+
+        fd = open(path.c_str(), mode == READ_ONLY ? O_RDONLY : (O_RDWR | O_CREAT), 0644);
+        if (fd < 0) {
+            fail("open '" + path + "'");
+        }
+
+        struct stat st;
+        if (fstat(fd, &st) != 0) {
+            release();
+            fail("fstat");
+        }
+        size_t length = static_cast<size_t>(st.st_size);
+
+        // Check an existing file through a plain read before mapping it:
+        // mapping READ_WRITE resizes the file to whole elements, which must
+        // not happen to a file that turns out to be something else
+        if (length != 0 && !holds_this_type(fd, length)) {
+            release();
+            throw std::runtime_error("MappedVector: '" + path + "' is not a MappedVector file of this type");
+        }
+
+        if (mode == READ_ONLY) {
+            if (length == 0) {
+                release();
+                throw std::runtime_error("MappedVector: '" + path + "' is not a MappedVector file");
+            }
+            void* p = mmap(nullptr, length, PROT_READ, MAP_SHARED, fd, 0);
+            if (p == MAP_FAILED) {
+                release();
+                fail("mmap");
+            }
+            base = static_cast<char*>(p);
+            _reserved = length;
+            _capacity = (length - sizeof(Header)) / sizeof(T);
+        }
+        else {
+            // PROT_NONE + MAP_NORESERVE only claims address space, not memory
+            _reserved = reserve_bytes < length ? length : reserve_bytes;
+            void* p = mmap(nullptr, _reserved, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+            if (p == MAP_FAILED) {
+                release();
+                fail("mmap reserve");
+            }
+            base = static_cast<char*>(p);
+
+            if (length == 0) {
+                remap(0);
+                std::memcpy(header()->magic, MAGIC, sizeof(MAGIC));
+                header()->element_size = sizeof(T);
+                header()->size = 0;
+            }
+            else {
+                remap((length - sizeof(Header)) / sizeof(T));
+            }
+        }
+    }
+
+    MappedVector(const MappedVector&) = delete;
+    MappedVector& operator=(const MappedVector&) = delete;
+
+    MappedVector(MappedVector&& other) noexcept
+        : fd(other.fd), mode(other.mode), base(other.base), _reserved(other._reserved), _capacity(other._capacity) {
+        other.fd = -1;
+        other.base = nullptr;
+        other._reserved = 0;
+        other._capacity = 0;
+    }
+
+    MappedVector& operator=(MappedVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            fd = other.fd;
+            mode = other.mode;
+            base = other.base;
+            _reserved = other._reserved;
+            _capacity = other._capacity;
+
+            other.fd = -1;
+            other.base = nullptr;
+            other._reserved = 0;
+            other._capacity = 0;
+        }
+        return *this;
+    }
+
+    // Unmapping writes dirty pages back eventually; call flush() to force it
+    ~MappedVector() {
+        release();
+    }
+
+    iterator begin() noexcept { return iterator(base ? array() : nullptr); }
+    iterator end() noexcept { return begin() + size(); }
+
+    [[nodiscard]] bool empty() const noexcept { return size() == 0; }
+    [[nodiscard]] bool read_only() const noexcept { return mode == READ_ONLY; }
+
+    size_t size() const noexcept { return base ? header()->size : 0; }
+    size_t capacity() const noexcept { return _capacity; }
+
+    T* data() noexcept { return base ? array() : nullptr; }
+    const T* data() const noexcept { return base ? array() : nullptr; }
+
+    T& at(size_t pos) {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return array()[pos];
+    }
+    const T& at(size_t pos) const {
+        if (pos >= size()) throw (std::out_of_range("index is out of range"));
+        return array()[pos];
+    }
+
+    T& operator[](size_t pos) { return array()[pos]; }
+    const T& operator[](size_t pos) const { return array()[pos]; }
+
+    T& front() { return array()[0]; }
+    const T& front() const { return array()[0]; }
+    T& back() { return array()[size() - 1]; }
+    const T& back() const { return array()[size() - 1]; }
+
+    // Extends the file to hold at least count elements
+    void reserve(size_t count) {
+        writable();
+        if (count > _capacity) {
+            remap(count);
+        }
+    }
+
+    void push_back(const T& value) {
+        writable();
+        size_t n = size();
+        if (n == _capacity) {
+            grow();
+        }
+        array()[n] = value;
+        header()->size = n + 1;
+    }
+
+    void pop_back() {
+        writable();
+        if (size() > 0) {
+            header()->size--;
+        }
+    }
+
+    void clear() {
+        writable();
+        header()->size = 0;
+    }
+
+    // Writes dirty pages back to the file (msync). async only schedules the write.
+    void flush(bool async = false) {
+        if (mode == READ_WRITE && base != nullptr) {
+            if (msync(base, file_bytes(_capacity), async ? MS_ASYNC : MS_SYNC) != 0) {
+                fail("msync");
+            }
+        }
+    }
+};
+
+template <class T>
+constexpr char MappedVector<T>::MAGIC[8];
+
+#endif
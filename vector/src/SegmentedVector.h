@@ -0,0 +1,285 @@
+#ifndef SEGMENTED_VECTOR_H
+#define SEGMENTED_VECTOR_H
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <new> // placement new, ::operator new
+#include <stdexcept> // std::out_of_range
+#include <utility> // std::move, std::forward
+
+/*
+    SegmentedVector
+    ---------------
+
+    A vector made of geometrically growing blocks that never relocates its
+    elements. Block 0 holds FirstBlock elements, block 1 twice that, and so
+    on, so growing allocates one new block and leaves everything else where
+    it is:
+
+    - push_back never copies or moves existing elements, so its worst case
+      does not grow with size()
+    - pointers and references to elements stay valid until the element is
+      removed; iterators (an index and a pointer to the vector) stay valid
+      until the vector is moved or destroyed, or the element is removed
+
+    Element i lives in block k = log2(i / FirstBlock + 1), found with one
+    count-leading-zeros, so random access is O(1) through a fixed table of
+    block pointers. The block sizes double, so at most half of the capacity
+    is unused, as with Vector.
+
+    Unlike Vector, unused capacity is raw storage: elements are constructed
+    by push_back/emplace_back and destroyed by pop_back/clear.
+*/
+
+namespace segmented {
+
+    constexpr size_t log2(size_t n) noexcept {
+        return n <= 1 ? 0 : 1 + log2(n / 2);
+    }
+
+    // Index math for blocks of FirstBlock, 2 * FirstBlock, 4 * FirstBlock, ...
+    // (shared with ConcurrentVector)
+    template <size_t FirstBlock>
+    struct Layout {
+        static_assert(FirstBlock > 0 && (FirstBlock & (FirstBlock - 1)) == 0,
+            "FirstBlock must be a power of two");
+
+        // Enough blocks to cover (almost) every size_t index
+        static constexpr size_t max_blocks = sizeof(size_t) * 8 - log2(FirstBlock);
+
+        static size_t block_of(size_t index) noexcept {
+            size_t j = index / FirstBlock + 1;
+            return sizeof(unsigned long long) * 8 - 1 - __builtin_clzll(j);
+        }
+
+        // First index stored in block k
+        static constexpr size_t block_start(size_t block) noexcept {
+            return FirstBlock * ((size_t(1) << block) - 1);
+        }
+
+        static constexpr size_t block_size(size_t block) noexcept {
+            return FirstBlock << block;
+        }
+    };
+}
+
+template <class T, size_t FirstBlock = 16>
+class SegmentedVector {
+    using layout = segmented::Layout<FirstBlock>;
+
+public:
+    class iterator;
+
+private:
+    T* blocks[layout::max_blocks] = {};
+    size_t _blocks = 0; // blocks allocated
+    size_t _capacity = 0, _size = 0;
+
+    void add_block() {
+        blocks[_blocks] = static_cast<T*>(::operator new(layout::block_size(_blocks) * sizeof(T)));
+        _capacity += layout::block_size(_blocks);
+        _blocks++;
+    }
+
+    T* slot(size_t pos) const noexcept {
+        size_t block = layout::block_of(pos);
+        return blocks[block] + (pos - layout::block_start(block));
+    }
+
+    void release() noexcept {
+        clear();
+        for (size_t b = 0; b < _blocks; b++) {
+            ::operator delete(blocks[b]);
+            blocks[b] = nullptr;
+        }
+        _blocks = 0;
+        _capacity = 0;
+    }
+
+    void steal(SegmentedVector& other) noexcept {
+        for (size_t b = 0; b < other._blocks; b++) {
+            blocks[b] = other.blocks[b];
+            other.blocks[b] = nullptr;
+        }
+        _blocks = other._blocks;
+        _capacity = other._capacity;
+        _size = other._size;
+        other._blocks = 0;
+        other._capacity = 0;
+        other._size = 0;
+    }
+
+public:
+    SegmentedVector() noexcept {}
+
+    SegmentedVector(size_t count, const T& value) {
+        reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            push_back(value);
+        }
+    }
+
+    SegmentedVector(const SegmentedVector& other) {
+        reserve(other._size);
+        for (size_t i = 0; i < other._size; i++) {
+            push_back(other[i]);
+        }
+    }
+
+    SegmentedVector(SegmentedVector&& other) noexcept {
+        steal(other);
+    }
+
+    ~SegmentedVector() {
+        release();
+    }
+
+    SegmentedVector& operator=(const SegmentedVector& other) {
+        if (this != &other) {
+            clear();
+            reserve(other._size);
+            for (size_t i = 0; i < other._size; i++) {
+                push_back(other[i]);
+            }
+        }
+        return *this;
+    }
+
+    SegmentedVector& operator=(SegmentedVector&& other) noexcept {
+        if (this != &other) {
+            release();
+            steal(other);
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(this, 0); }
+    iterator end() noexcept { return iterator(this, _size); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return _capacity; }
+
+    // Number of blocks allocated so far
+    size_t block_count() const noexcept { return _blocks; }
+
+    T& at(size_t pos) {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return *slot(pos);
+    }
+    const T& at(size_t pos) const {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return *slot(pos);
+    }
+
+    T& operator[](size_t pos) { return *slot(pos); }
+    const T& operator[](size_t pos) const { return *slot(pos); }
+
+    T& front() { return *slot(0); }
+    const T& front() const { return *slot(0); }
+    T& back() { return *slot(_size - 1); }
+    const T& back() const { return *slot(_size - 1); }
+
+    // Allocates blocks until count elements fit; nothing already stored moves
+    void reserve(size_t count) {
+        while (_capacity < count) {
+            add_block();
+        }
+    }
+
+    template <class... Args>
+    T& emplace_back(Args&&... args) {
+        if (_size == _capacity) {
+            add_block();
+        }
+        T* p = new (slot(_size)) T(std::forward<Args>(args)...);
+        _size++;
+        return *p;
+    }
+
+    // The new block never replaces the old ones, so value may alias an element
+    void push_back(const T& value) { emplace_back(value); }
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    void pop_back() {
+        if (_size > 0) {
+            _size--;
+            slot(_size)->~T();
+        }
+    }
+
+    // Destroys the elements but keeps the blocks
+    void clear() noexcept {
+        while (_size > 0) {
+            _size--;
+            slot(_size)->~T();
+        }
+    }
+
+    // An index into the vector, so it stays valid while the vector grows
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = T;
+        using difference_type   = ptrdiff_t;
+        using pointer           = T*;
+        using reference         = T&;
+
+    private:
+        SegmentedVector* owner;
+        difference_type index;
+
+    public:
+        iterator() : owner(nullptr), index(0) {}
+        iterator(SegmentedVector* owner, difference_type index) : owner(owner), index(index) {}
+
+        iterator& operator=(const iterator&) noexcept = default;
+
+        [[nodiscard]] reference operator*() const noexcept { return *owner->slot(index); }
+        [[nodiscard]] pointer operator->() const noexcept { return owner->slot(index); }
+        [[nodiscard]] reference operator[](difference_type offset) const noexcept { return *owner->slot(index + offset); }
+
+        iterator& operator++() noexcept {
+            ++index;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++index;
+            return temp;
+        }
+        iterator& operator--() noexcept {
+            --index;
+            return *this;
+        }
+        iterator operator--(int) noexcept {
+            iterator temp = *this;
+            --index;
+            return temp;
+        }
+
+        iterator& operator+=(difference_type offset) noexcept {
+            index += offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator+(difference_type offset) const noexcept { return iterator(owner, index + offset); }
+        [[nodiscard]] friend iterator operator+(difference_type offset, const iterator& it) noexcept { return it + offset; }
+
+        iterator& operator-=(difference_type offset) noexcept {
+            index -= offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator-(difference_type offset) const noexcept { return iterator(owner, index - offset); }
+
+        [[nodiscard]] difference_type operator-(const iterator& rhs) const noexcept { return index - rhs.index; }
+
+        [[nodiscard]] bool operator==(const iterator& rhs) const noexcept { return index == rhs.index; }
+        [[nodiscard]] bool operator!=(const iterator& rhs) const noexcept { return index != rhs.index; }
+        [[nodiscard]] bool operator<(const iterator& rhs) const noexcept { return index < rhs.index; }
+        [[nodiscard]] bool operator>(const iterator& rhs) const noexcept { return index > rhs.index; }
+        [[nodiscard]] bool operator<=(const iterator& rhs) const noexcept { return index <= rhs.index; }
+        [[nodiscard]] bool operator>=(const iterator& rhs) const noexcept { return index >= rhs.index; }
+    };
+};
+
+#endif
@@ -0,0 +1,269 @@
+#ifndef SMALL_VECTOR_H
+#define SMALL_VECTOR_H
+
+#include <cstddef> // size_t
+#include <new> // placement new, ::operator new
+#include <stdexcept> // std::out_of_range
+#include <utility> // std::move
+
+#include "Vector.h"
+#include "raw_storage.h"
+
+/*
+    SmallVector
+    -----------
+
+    A Vector that keeps up to N elements inside the object itself and only
+    allocates once it outgrows them. Short sequences never touch the heap:
+
+    SmallVector<int, 8> v;
+    for (int i = 0; i < 8; i++) v.push_back(i); // no allocations
+    v.push_back(8);                              // first allocation (capacity 16)
+
+    The API and iterator type are the same as Vector<T>. Unlike Vector, the
+    unused capacity is raw storage: elements are constructed when they are
+    added and destroyed when they are removed.
+
+    Moving a heap backed SmallVector steals the buffer. Moving an inline one
+    has to move the (at most N) elements, which is a memcpy for trivially
+    copyable types. Either way the moved-from vector is left empty.
+*/
+
+template <class T, size_t N>
+class SmallVector {
+    static_assert(N > 0, "SmallVector needs at least one inline element, use Vector otherwise");
+
+public:
+    using iterator = typename Vector<T>::iterator;
+
+    static constexpr size_t inline_capacity = N;
+
+private:
+    T* array;
+    size_t _capacity, _size;
+    alignas(T) unsigned char buffer[N * sizeof(T)];
+
+    T* inline_data() noexcept { return reinterpret_cast<T*>(buffer); }
+    const T* inline_data() const noexcept { return reinterpret_cast<const T*>(buffer); }
+
+    void destroy_all() noexcept {
+        raw_storage::destroy(array, _size);
+        _size = 0;
+    }
+
+    void free_heap() noexcept {
+        if (array != inline_data()) {
+            ::operator delete(array);
+        }
+        array = inline_data();
+        _capacity = N;
+    }
+
+    // Same doubling policy as Vector, but starting from the inline capacity
+    void grow(size_t min_capacity) {
+        size_t capacity = _capacity * 2;
+        if (capacity < min_capacity) {
+            capacity = min_capacity;
+        }
+        T* bigger = static_cast<T*>(::operator new(capacity * sizeof(T)));
+        raw_storage::relocate(array, _size, bigger);
+        if (array != inline_data()) {
+            ::operator delete(array);
+        }
+        array = bigger;
+        _capacity = capacity;
+    }
+
+    // Takes other's elements, stealing its heap buffer if it has one
+    void steal(SmallVector& other) {
+        if (other.array == other.inline_data()) {
+            raw_storage::relocate(other.array, other._size, array);
+            _size = other._size;
+        }
+        else {
+            array = other.array;
+            _capacity = other._capacity;
+            _size = other._size;
+            other.array = other.inline_data();
+            other._capacity = N;
+        }
+        other._size = 0;
+    }
+
+public:
+    SmallVector() noexcept : array(inline_data()), _capacity(N), _size(0) {}
+
+    SmallVector(size_t count, const T& value) : SmallVector() {
+        reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            new (array + i) T(value);
+        }
+        _size = count;
+    }
+
+    explicit SmallVector(size_t count) : SmallVector() {
+        reserve(count);
+        for (size_t i = 0; i < count; i++) {
+            new (array + i) T();
+        }
+        _size = count;
+    }
+
+    SmallVector(const SmallVector& other) : SmallVector() {
+        reserve(other._size);
+        for (size_t i = 0; i < other._size; i++) {
+            new (array + i) T(other.array[i]);
+        }
+        _size = other._size;
+    }
+
+    SmallVector(SmallVector&& other) noexcept : SmallVector() {
+        steal(other);
+    }
+
+    ~SmallVector() {
+        destroy_all();
+        free_heap();
+    }
+
+    SmallVector& operator=(const SmallVector& other) {
+        if (this != &other) {
+            destroy_all();
+            reserve(other._size);
+            for (size_t i = 0; i < other._size; i++) {
+                new (array + i) T(other.array[i]);
+            }
+            _size = other._size;
+        }
+        return *this;
+    }
+
+    SmallVector& operator=(SmallVector&& other) noexcept {
+        if (this != &other) {
+            destroy_all();
+            free_heap();
+            steal(other);
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(array); }
+    iterator end() noexcept { return iterator(array) + _size; }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    // True while the elements still live inside the object
+    [[nodiscard]] bool is_inline() const noexcept { return array == inline_data(); }
+
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return _capacity; }
+
+    T* data() noexcept { return array; }
+    const T* data() const noexcept { return array; }
+
+    T& at(size_t pos) {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return array[pos];
+    }
+    const T& at(size_t pos) const {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return array[pos];
+    }
+
+    T& operator[](size_t pos) { return array[pos]; }
+    const T& operator[](size_t pos) const { return array[pos]; }
+
+    T& front() { return array[0]; }
+    const T& front() const { return array[0]; }
+    T& back() { return array[_size - 1]; }
+    const T& back() const { return array[_size - 1]; }
+
+    void reserve(size_t count) {
+        if (count > _capacity) {
+            grow(count);
+        }
+    }
+
+    void push_back(const T& value) {
+        if (_size == _capacity) {
+            T copy = value; // value may live in the array that grow() frees
+            grow(_size + 1);
+            new (array + _size) T(std::move(copy));
+        }
+        else {
+            new (array + _size) T(value);
+        }
+        _size++;
+    }
+
+    void push_back(T&& value) {
+        if (_size == _capacity) {
+            T moved = std::move(value);
+            grow(_size + 1);
+            new (array + _size) T(std::move(moved));
+        }
+        else {
+            new (array + _size) T(std::move(value));
+        }
+        _size++;
+    }
+
+    void pop_back() {
+        if (_size > 0) {
+            _size--;
+            array[_size].~T();
+        }
+    }
+
+    iterator insert(iterator pos, const T& value) {
+        return insert(pos, T(value));
+    }
+
+    iterator insert(iterator pos, T&& value) {
+        size_t index = pos - begin();
+        T moved = std::move(value);
+
+        if (_size == _capacity) {
+            grow(_size + 1);
+        }
+        raw_storage::insert(array, _size, index, std::move(moved));
+        _size++;
+        return iterator(array + index);
+    }
+
+    iterator insert(iterator pos, size_t count, const T& value) {
+        size_t index = pos - begin();
+        if (count == 0) {
+            return iterator(array + index);
+        }
+        T copy = value;
+
+        if (_size + count > _capacity) {
+            grow(_size + count);
+        }
+        raw_storage::insert(array, _size, index, count, copy);
+        _size += count;
+        return iterator(array + index);
+    }
+
+    iterator erase(iterator pos) {
+        if (pos < begin() || pos >= end()) {
+            return end();
+        }
+        return erase(pos, pos + 1);
+    }
+
+    iterator erase(iterator first, iterator last) {
+        if (first == last) {
+            return first;
+        }
+        size_t num = last - first;
+        raw_storage::erase(array, _size, static_cast<size_t>(first - begin()), num);
+        _size -= num;
+        return first;
+    }
+
+    // Destroys the elements but keeps the capacity (and any heap buffer)
+    void clear() noexcept { destroy_all(); }
+};
+
+#endif
@@ -0,0 +1,343 @@
+#ifndef SOA_VECTOR_H
+#define SOA_VECTOR_H
+
+#include <cstddef> // size_t, ptrdiff_t
+#include <iterator> // std::random_access_iterator_tag
+#include <stdexcept> // std::out_of_range
+#include <tuple>
+#include <utility> // std::index_sequence, std::move, std::swap
+
+/*
+    SoAVector
+    ---------
+
+    A structure-of-arrays Vector: every field of a record lives in its own
+    contiguous array, so a scan over one field only reads that field.
+
+    SoAVector<float, int, double> v;   // (price, quantity, weight)
+    v.push_back(9.5f, 3, 0.25);
+
+    auto prices = v.column<0>();       // contiguous float span
+    float total = simd::sum(prices.begin(), prices.end());
+
+    The arrays share one size and capacity and grow together with the same
+    doubling policy as Vector.
+
+    Dereferencing an iterator gives a `reference` proxy that bundles a
+    reference to every field. It converts to and assigns from value_type
+    (a std::tuple of the fields), and swapping two proxies swaps the
+    records, so the algorithms in sorting/src/sorting.h work unchanged.
+    Comparators that take `const value_type&` copy the record on every
+    comparison; taking `const reference&` and using get<I>() avoids that.
+
+    Growing invalidates iterators, references and column spans, as in Vector.
+*/
+
+// Contiguous run of one field, e.g. SoAVector::column<I>()
+template <class T>
+class ColumnSpan {
+    T* ptr;
+    size_t count;
+
+public:
+    ColumnSpan(T* ptr, size_t count) noexcept : ptr(ptr), count(count) {}
+
+    T* begin() const noexcept { return ptr; }
+    T* end() const noexcept { return ptr + count; }
+    T* data() const noexcept { return ptr; }
+    size_t size() const noexcept { return count; }
+    [[nodiscard]] bool empty() const noexcept { return count == 0; }
+    T& operator[](size_t pos) const { return ptr[pos]; }
+};
+
+template <class... Fields>
+class SoAVector {
+    static_assert(sizeof...(Fields) > 0, "SoAVector needs at least one field");
+
+public:
+    using value_type = std::tuple<Fields...>;
+    using indices = std::index_sequence_for<Fields...>;
+
+    template <size_t I>
+    using field_type = std::tuple_element_t<I, value_type>;
+
+    class reference;
+    class iterator;
+
+private:
+    std::tuple<Fields*...> arrays;
+    size_t _capacity, _size;
+
+    template <size_t... I>
+    void reallocate(size_t capacity, std::index_sequence<I...>) {
+        std::tuple<Fields*...> bigger(new Fields[capacity]...);
+        for (size_t i = 0; i < _size; i++) {
+            ((std::get<I>(bigger)[i] = std::move(std::get<I>(arrays)[i])), ...);
+        }
+        (delete[] std::get<I>(arrays), ...);
+        arrays = bigger;
+        _capacity = capacity;
+    }
+
+    // Same policy as Vector::grow
+    void grow() {
+        reallocate(_capacity == 0 ? 1 : _capacity * 2, indices{});
+    }
+
+    template <size_t... I>
+    void release(std::index_sequence<I...>) noexcept {
+        (delete[] std::get<I>(arrays), ...);
+    }
+
+    template <size_t... I>
+    reference make_reference(size_t pos, std::index_sequence<I...>) const noexcept {
+        return reference(std::get<I>(arrays)[pos]...);
+    }
+
+    template <size_t... I>
+    void copy_from(const SoAVector& other, std::index_sequence<I...>) {
+        arrays = std::tuple<Fields*...>(other._capacity ? new Fields[other._capacity] : nullptr...);
+        for (size_t i = 0; i < other._size; i++) {
+            ((std::get<I>(arrays)[i] = std::get<I>(other.arrays)[i]), ...);
+        }
+    }
+
+public:
+    SoAVector() noexcept : arrays(static_cast<Fields*>(nullptr)...), _capacity(0), _size(0) {}
+
+    SoAVector(const SoAVector& other) : _capacity(other._capacity), _size(other._size) {
+        copy_from(other, indices{});
+    }
+
+    SoAVector(SoAVector&& other) noexcept : arrays(other.arrays), _capacity(other._capacity), _size(other._size) {
+        other.arrays = std::tuple<Fields*...>(static_cast<Fields*>(nullptr)...);
+        other._capacity = 0;
+        other._size = 0;
+    }
+
+    ~SoAVector() {
+        release(indices{});
+    }
+
+    SoAVector& operator=(const SoAVector& other) {
+        if (this != &other) {
+            release(indices{});
+            copy_from(other, indices{});
+            _capacity = other._capacity;
+            _size = other._size;
+        }
+        return *this;
+    }
+
+    SoAVector& operator=(SoAVector&& other) noexcept {
+        if (this != &other) {
+            release(indices{});
+            arrays = other.arrays;
+            _capacity = other._capacity;
+            _size = other._size;
+
+            other.arrays = std::tuple<Fields*...>(static_cast<Fields*>(nullptr)...);
+            other._capacity = 0;
+            other._size = 0;
+        }
+        return *this;
+    }
+
+    iterator begin() noexcept { return iterator(arrays, 0); }
+    iterator end() noexcept { return iterator(arrays, _size); }
+
+    [[nodiscard]] bool empty() const noexcept { return _size == 0; }
+    size_t size() const noexcept { return _size; }
+    size_t capacity() const noexcept { return _capacity; }
+
+    void reserve(size_t count) {
+        if (count > _capacity) {
+            reallocate(count, indices{});
+        }
+    }
+
+    reference operator[](size_t pos) noexcept { return make_reference(pos, indices{}); }
+
+    reference at(size_t pos) {
+        if (pos >= _size) throw (std::out_of_range("index is out of range"));
+        return make_reference(pos, indices{});
+    }
+
+    reference front() noexcept { return make_reference(0, indices{}); }
+    reference back() noexcept { return make_reference(_size - 1, indices{}); }
+
+    // Field I of record pos
+    template <size_t I>
+    field_type<I>& get(size_t pos) noexcept { return std::get<I>(arrays)[pos]; }
+    template <size_t I>
+    const field_type<I>& get(size_t pos) const noexcept { return std::get<I>(arrays)[pos]; }
+
+    // Every record's field I as one contiguous array
+    template <size_t I>
+    ColumnSpan<field_type<I>> column() noexcept { return ColumnSpan<field_type<I>>(std::get<I>(arrays), _size); }
+    template <size_t I>
+    ColumnSpan<const field_type<I>> column() const noexcept {
+        return ColumnSpan<const field_type<I>>(std::get<I>(arrays), _size);
+    }
+
+    template <size_t I>
+    field_type<I>* data() noexcept { return std::get<I>(arrays); }
+    template <size_t I>
+    const field_type<I>* data() const noexcept { return std::get<I>(arrays); }
+
+    void push_back(const Fields&... values) {
+        if (_size == _capacity) {
+            grow();
+        }
+        make_reference(_size, indices{}) = std::forward_as_tuple(values...);
+        _size++;
+    }
+
+    void push_back(const value_type& record) {
+        if (_size == _capacity) {
+            grow();
+        }
+        make_reference(_size, indices{}) = record;
+        _size++;
+    }
+
+    void push_back(value_type&& record) {
+        if (_size == _capacity) {
+            grow();
+        }
+        make_reference(_size, indices{}) = std::move(record);
+        _size++;
+    }
+
+    void pop_back() {
+        if (_size > 0) {
+            _size--;
+        }
+    }
+
+    void clear() noexcept { _size = 0; }
+
+    // Proxy for one record: a reference to each of its fields
+    class reference {
+        std::tuple<Fields&...> refs;
+
+        template <size_t... I>
+        static void swap_fields(reference& a, reference& b, std::index_sequence<I...>) {
+            using std::swap;
+            (swap(std::get<I>(a.refs), std::get<I>(b.refs)), ...);
+        }
+
+    public:
+        explicit reference(Fields&... fields) noexcept : refs(fields...) {}
+        reference(const reference&) = default;
+
+        // Assignments write through to the record, they never rebind
+        reference& operator=(const reference& other) {
+            refs = other.refs;
+            return *this;
+        }
+        reference& operator=(const value_type& value) {
+            refs = value;
+            return *this;
+        }
+        reference& operator=(value_type&& value) {
+            refs = std::move(value);
+            return *this;
+        }
+        template <class... Values>
+        reference& operator=(const std::tuple<Values...>& values) {
+            refs = values;
+            return *this;
+        }
+
+        operator value_type() const { return value_type(refs); }
+
+        template <size_t I>
+        field_type<I>& get() const noexcept { return std::get<I>(refs); }
+
+        // Found by ADL, so unqualified swap(*a, *b) swaps the records
+        friend void swap(reference a, reference b) {
+            swap_fields(a, b, indices{});
+        }
+
+        friend bool operator==(const reference& a, const reference& b) { return a.refs == b.refs; }
+        friend bool operator!=(const reference& a, const reference& b) { return a.refs != b.refs; }
+        friend bool operator<(const reference& a, const reference& b) { return a.refs < b.refs; }
+        friend bool operator>(const reference& a, const reference& b) { return a.refs > b.refs; }
+        friend bool operator<=(const reference& a, const reference& b) { return a.refs <= b.refs; }
+        friend bool operator>=(const reference& a, const reference& b) { return a.refs >= b.refs; }
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = SoAVector::value_type;
+        using difference_type   = ptrdiff_t;
+        using pointer           = void;
+        using reference         = SoAVector::reference;
+
+    private:
+        std::tuple<Fields*...> base;
+        difference_type index;
+
+        template <size_t... I>
+        reference at(difference_type pos, std::index_sequence<I...>) const noexcept {
+            return reference(std::get<I>(base)[pos]...);
+        }
+
+    public:
+        iterator() : base(static_cast<Fields*>(nullptr)...), index(0) {}
+        iterator(const std::tuple<Fields*...>& base, difference_type index) : base(base), index(index) {}
+
+        iterator& operator=(const iterator&) noexcept = default;
+
+        [[nodiscard]] reference operator*() const noexcept { return at(index, indices{}); }
+        [[nodiscard]] reference operator[](difference_type offset) const noexcept { return at(index + offset, indices{}); }
+
+        // Position of the record, usable with SoAVector::get and column spans
+        [[nodiscard]] size_t position() const noexcept { return static_cast<size_t>(index); }
+
+        iterator& operator++() noexcept {
+            ++index;
+            return *this;
+        }
+        iterator operator++(int) noexcept {
+            iterator temp = *this;
+            ++index;
+            return temp;
+        }
+        iterator& operator--() noexcept {
+            --index;
+            return *this;
+        }
+        iterator operator--(int) noexcept {
+            iterator temp = *this;
+            --index;
+            return temp;
+        }
+
+        iterator& operator+=(difference_type offset) noexcept {
+            index += offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator+(difference_type offset) const noexcept { return iterator(base, index + offset); }
+        [[nodiscard]] friend iterator operator+(difference_type offset, const iterator& it) noexcept { return it + offset; }
+
+        iterator& operator-=(difference_type offset) noexcept {
+            index -= offset;
+            return *this;
+        }
+        [[nodiscard]] iterator operator-(difference_type offset) const noexcept { return iterator(base, index - offset); }
+
+        [[nodiscard]] difference_type operator-(const iterator& rhs) const noexcept { return index - rhs.index; }
+
+        [[nodiscard]] bool operator==(const iterator& rhs) const noexcept { return index == rhs.index; }
+        [[nodiscard]] bool operator!=(const iterator& rhs) const noexcept { return index != rhs.index; }
+        [[nodiscard]] bool operator<(const iterator& rhs) const noexcept { return index < rhs.index; }
+        [[nodiscard]] bool operator>(const iterator& rhs) const noexcept { return index > rhs.index; }
+        [[nodiscard]] bool operator<=(const iterator& rhs) const noexcept { return index <= rhs.index; }
+        [[nodiscard]] bool operator>=(const iterator& rhs) const noexcept { return index >= rhs.index; }
+    };
+};
+
+#endif
@@ -0,0 +1,198 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <algorithm> // std::max
+#include <atomic>
+#include <condition_variable>
+#include <cstddef> // size_t
+#include <exception> // std::exception_ptr
+#include <functional> // std::function
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+    ThreadPool
+    ----------
+
+    A fixed set of worker threads that are started once and reused by every
+    parallel algorithm (see parallel.h). The thread calling run() takes part
+    in the work, so a pool of size() == 1 has no workers and runs everything
+    on the caller.
+
+    Work is handed out in chunks: run(chunks, schedule, fn) calls fn(chunk)
+    exactly once for every chunk in [0, chunks).
+
+    - Schedule::STATIC splits the chunks into one contiguous run per thread.
+      Nothing is shared while running, which is best for uniform work.
+    - Schedule::DYNAMIC lets threads claim the next chunk from an atomic
+      counter, so fast threads pick up the slack when the work is skewed.
+
+    One job runs at a time; concurrent callers wait their turn. A run()
+    issued from inside a job (nested parallelism) executes serially on the
+    calling thread instead of deadlocking. If a chunk throws, the first
+    exception is rethrown from run() after every thread has stopped.
+*/
+
+enum class Schedule { STATIC, DYNAMIC };
+
+class ThreadPool {
+    std::vector<std::thread> workers;
+
+    std::mutex run_mutex; // serializes callers of run()
+    std::mutex m;
+    std::condition_variable wake, done;
+
+    // Current job, guarded by m
+    const std::function<void(size_t)>* job = nullptr;
+    size_t generation = 0;
+    size_t pending = 0;
+    bool stopping = false;
+
+    // Chunk bookkeeping for the running job
+    std::atomic<size_t> next_chunk{0};
+    std::exception_ptr error;
+
+    static bool& inside_job() {
+        static thread_local bool inside = false;
+        return inside;
+    }
+
+    void record(std::exception_ptr e) {
+        std::lock_guard<std::mutex> lock(m);
+        if (!error) {
+            error = e;
+        }
+    }
+
+    void work(size_t participant) {
+        size_t seen = 0;
+        while (true) {
+            const std::function<void(size_t)>* current;
+            {
+                std::unique_lock<std::mutex> lock(m);
+                wake.wait(lock, [&] { return stopping || generation != seen; });
+                if (stopping) {
+                    return;
+                }
+                seen = generation;
+                current = job;
+            }
+
+            inside_job() = true;
+            try {
+                (*current)(participant);
+            } catch (...) {
+                record(std::current_exception());
+            }
+            inside_job() = false;
+
+            std::lock_guard<std::mutex> lock(m);
+            if (--pending == 0) {
+                done.notify_one();
+            }
+        }
+    }
+
+    // Calls fn(p) once on each participant p in [0, size()), the caller being 0
+    void broadcast(const std::function<void(size_t)>& fn) {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            job = &fn;
+            pending = workers.size();
+            error = nullptr;
+            ++generation;
+        }
+        wake.notify_all();
+
+        inside_job() = true;
+        try {
+            fn(0);
+        } catch (...) {
+            record(std::current_exception());
+        }
+        inside_job() = false;
+
+        std::unique_lock<std::mutex> lock(m);
+        done.wait(lock, [&] { return pending == 0; });
+        job = nullptr;
+    }
+
+public:
+    // threads counts the caller, so ThreadPool(4) starts 3 workers
+    explicit ThreadPool(size_t threads = std::max(1u, std::thread::hardware_concurrency())) {
+        for (size_t i = 1; i < threads; i++) {
+            workers.emplace_back([this, i] { work(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& t : workers) {
+            t.join();
+        }
+    }
+
+    // Number of threads that execute a job, including the caller
+    size_t size() const noexcept { return workers.size() + 1; }
+
+    // Pool shared by the parallel algorithms when none is given
+    static ThreadPool& shared() {
+        static ThreadPool pool;
+        return pool;
+    }
+
+    // Calls fn(chunk) for every chunk in [0, chunks) and returns once all are done
+    template <typename Fn>
+    void run(size_t chunks, Schedule schedule, Fn&& fn) {
+        if (chunks == 0) {
+            return;
+        }
+        if (workers.empty() || chunks == 1 || inside_job()) {
+            for (size_t c = 0; c < chunks; c++) {
+                fn(c);
+            }
+            return;
+        }
+
+        std::lock_guard<std::mutex> serialize(run_mutex);
+        const size_t threads = size();
+        next_chunk.store(0, std::memory_order_relaxed);
+
+        std::function<void(size_t)> body;
+        if (schedule == Schedule::STATIC) {
+            body = [&](size_t participant) {
+                size_t first = chunks * participant / threads;
+                size_t last = chunks * (participant + 1) / threads;
+                for (size_t c = first; c < last; c++) {
+                    fn(c);
+                }
+            };
+        }
+        else {
+            body = [&](size_t) {
+                size_t c;
+                while ((c = next_chunk.fetch_add(1, std::memory_order_relaxed)) < chunks) {
+                    fn(c);
+                }
+            };
+        }
+
+        broadcast(body);
+
+        if (error) {
+            std::exception_ptr e = error;
+            error = nullptr;
+            std::rethrow_exception(e);
+        }
+    }
+};
+
+#endif
@@ -3,8 +3,9 @@
 
 #include <algorithm> // std::random_access_iterator_tag
 #include <cstddef> // size_t
+#include <cstring> // std::memcpy, std::memmove
 #include <stdexcept> // std::out_of_range
-#include <type_traits> // std::is_same
+#include <type_traits> // std::is_same, std::is_trivially_copyable
 #include <iostream>
 
 
@@ -16,6 +17,23 @@ private:
     T* array;
     size_t _capacity, _size;
 
+    // Moves count elements from src to dst, which may overlap. Trivially
+    // copyable elements go as one memmove instead of one at a time.
+    static void shift(T* src, size_t count, T* dst) {
+        if (count == 0 || src == dst) {
+            return;
+        }
+        if (std::is_trivially_copyable<T>::value) {
+            std::memmove(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+        }
+        else if (dst < src) {
+            std::move(src, src + count, dst);
+        }
+        else {
+            std::move_backward(src, src + count, dst + count);
+        }
+    }
+
     // You may want to write a function that grows the vector
     void grow() { 
         if (_capacity == 0) {
@@ -27,8 +45,15 @@ private:
         
         T* array_temp = new T[_capacity];
 
-        for (size_t i = 0; i < _size; i++) {
-            array_temp[i] = std::move(array[i]);
+        if (std::is_trivially_copyable<T>::value) {
+            if (_size > 0) {
+                std::memcpy(static_cast<void*>(array_temp), static_cast<const void*>(array), _size * sizeof(T));
+            }
+        }
+        else {
+            for (size_t i = 0; i < _size; i++) {
+                array_temp[i] = std::move(array[i]);
+            }
         }
 
         delete [] array;
@@ -136,6 +161,10 @@ public:
 
     const T& operator[](size_t pos) const { return array[pos]; }
 
+    // Direct access to the underlying array (nullptr when nothing has been allocated)
+    T* data() noexcept { return array; }
+    const T* data() const noexcept { return array; }
+
     T& front() { return array[0]; }
     const T& front() const { return array[0]; }
     T& back() { return array[_size - 1]; }
@@ -170,9 +199,7 @@ public:
             grow();
         }
 
-        for (size_t i = _size; i > index; --i) {
-            array[i] = std::move(array[i - 1]); 
-        }
+        shift(array + index, _size - index, array + index + 1);
         array[index] = value;
         _size++;
         return iterator(&(array[index]));
@@ -186,9 +213,7 @@ public:
             grow();
         }
 
-        for (size_t i = _size; i > index; --i) {
-            array[i] = std::move(array[i - 1]); 
-        }
+        shift(array + index, _size - index, array + index + 1);
         array[index] = std::move(value);
         _size++;
         return iterator(&(array[index]));
@@ -204,9 +229,7 @@ public:
         }
         
         //shift over elements to make space for the elements inserted
-        for (size_t i = _size + count - 1; i > index + count - 1; --i) {
-            array[i] = std::move(array[i - count]); 
-        }
+        shift(array + index, _size - index, array + index + count);
 
         //adds the number of count elements to the array
         for (size_t i = 0; i < count; i++) {
@@ -223,7 +246,8 @@ public:
         if (pos < begin() || pos >= end()) {
             return end();
         }
-        std::move(pos + 1, end(), pos);
+        size_t index = pos - begin();
+        shift(array + index + 1, _size - index - 1, array + index);
         _size--;
         return pos;
     }
@@ -234,9 +258,8 @@ public:
             return first;
         }
         size_t num = last - first; //distance between the two
-        for (iterator temp = first; temp != end() - num; temp++) {
-            *temp = *(temp + num); //shifts the elements over to the left
-        }
+        size_t index = first - begin();
+        shift(array + index + num, _size - index - num, array + index); //shifts the elements over to the left
         //corrects the size
         _size -= num;
         return first;
@@ -250,6 +273,8 @@ public:
         using difference_type   = ptrdiff_t;
         using pointer           = T*;
         using reference         = T&;
+        // The elements are adjacent in memory (see sort::is_contiguous_iterator)
+        using is_contiguous     = std::true_type;
 
     private:
         // HINT: For random_access_iterator, the data member is a pointer 99.9% of the time
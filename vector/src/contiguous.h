@@ -0,0 +1,21 @@
+#pragma once
+
+#include <type_traits> // std::is_pointer, std::void_t
+
+/*
+    Whether an iterator's elements are adjacent in memory, so that a range
+    of them can be handled as one block of bytes (written with one write(),
+    loaded into vector registers): pointers, and iterators that declare
+
+        using is_contiguous = std::true_type;
+
+    as Vector's (and so SmallVector's, CompactVector's and MappedVector's)
+    do. The same marker is read by sort::is_contiguous_iterator and
+    views::is_contiguous in the other modules.
+*/
+
+template <typename Iter, typename = void>
+struct is_contiguous_iterator : std::is_pointer<Iter> {};
+
+template <typename Iter>
+struct is_contiguous_iterator<Iter, std::void_t<typename Iter::is_contiguous>> : Iter::is_contiguous {};
@@ -0,0 +1,209 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <functional> // std::plus
+#include <iterator> // std::iterator_traits
+#include <vector>
+
+#include "ThreadPool.h"
+
+/*
+    Parallel algorithms over random access iterators
+    ------------------------------------------------
+
+    Works with any random access iterator, including Vector<T>::iterator and
+    Vector_Basic<T>::iterator. The range is cut into chunks of `grain`
+    elements which are spread over a ThreadPool (see ThreadPool.h for what
+    STATIC and DYNAMIC scheduling do).
+
+    Example:
+
+    Vector<double> v = ...;
+    parallel_for_each(v.begin(), v.end(), [](double& x) { x *= 2; });
+
+    ThreadPool pool(4);
+    double total = parallel_reduce(v.begin(), v.end(), 0.0, std::plus<double>{},
+                                   ParallelOptions{ Schedule::DYNAMIC, 4096, &pool });
+
+    Reductions and scans apply op in chunk order, so op has to be associative
+    but not commutative. Every algorithm returns only after all the work is
+    done; the functions passed in must be safe to call from several threads.
+*/
+
+struct ParallelOptions {
+    Schedule schedule = Schedule::STATIC;
+    // Elements per chunk; 0 picks one chunk per thread for STATIC
+    // and 16 chunks per thread for DYNAMIC
+    size_t grain = 0;
+    // nullptr uses ThreadPool::shared()
+    ThreadPool* pool = nullptr;
+};
+
+namespace parallel_detail {
+
+    inline ThreadPool& pool_of(const ParallelOptions& opts) {
+        return opts.pool ? *opts.pool : ThreadPool::shared();
+    }
+
+    inline size_t grain_of(const ParallelOptions& opts, size_t n, size_t threads) {
+        if (opts.grain > 0) {
+            return opts.grain;
+        }
+        size_t chunks = opts.schedule == Schedule::STATIC ? threads : threads * 16;
+        size_t grain = (n + chunks - 1) / chunks;
+        return grain > 0 ? grain : 1;
+    }
+
+    // Calls fn(chunk, first, last) for the index range [first, last) of every chunk
+    template <typename Fn>
+    size_t for_chunks(size_t n, const ParallelOptions& opts, Fn&& fn) {
+        ThreadPool& pool = pool_of(opts);
+        const size_t grain = grain_of(opts, n, pool.size());
+        const size_t chunks = (n + grain - 1) / grain;
+        pool.run(chunks, opts.schedule, [&](size_t c) {
+            size_t first = c * grain;
+            size_t last = first + grain < n ? first + grain : n;
+            fn(c, first, last);
+        });
+        return chunks;
+    }
+
+    inline size_t chunk_count(size_t n, const ParallelOptions& opts) {
+        const size_t grain = grain_of(opts, n, pool_of(opts).size());
+        return (n + grain - 1) / grain;
+    }
+}
+
+// Calls fn(element) for every element of [first, last)
+template <typename RandomIter, typename Fn>
+void parallel_for_each(RandomIter first, RandomIter last, Fn fn, const ParallelOptions& opts = ParallelOptions{}) {
+    parallel_detail::for_chunks(last - first, opts, [&](size_t, size_t b, size_t e) {
+        for (RandomIter it = first + b, stop = first + e; it != stop; ++it) {
+            fn(*it);
+        }
+    });
+}
+
+// Writes op(first[i]) to out[i]; returns the end of the output range
+template <typename RandomIter, typename OutIter, typename UnaryOp>
+OutIter parallel_transform(RandomIter first, RandomIter last, OutIter out, UnaryOp op,
+    const ParallelOptions& opts = ParallelOptions{}) {
+    const size_t n = last - first;
+    parallel_detail::for_chunks(n, opts, [&](size_t, size_t b, size_t e) {
+        OutIter o = out + b;
+        for (RandomIter it = first + b, stop = first + e; it != stop; ++it, ++o) {
+            *o = op(*it);
+        }
+    });
+    return out + n;
+}
+
+// init op first[0] op first[1] ... with op applied in order within and across chunks
+template <typename RandomIter, typename T, typename BinaryOp = std::plus<T>>
+T parallel_reduce(RandomIter first, RandomIter last, T init, BinaryOp op = BinaryOp{},
+    const ParallelOptions& opts = ParallelOptions{}) {
+    const size_t n = last - first;
+    if (n == 0) {
+        return init;
+    }
+
+    // one partial per chunk, each seeded with the chunk's first element
+    std::vector<T> partials(parallel_detail::chunk_count(n, opts), init);
+
+    parallel_detail::for_chunks(n, opts, [&](size_t c, size_t b, size_t e) {
+        T acc = first[b];
+        for (size_t i = b + 1; i < e; i++) {
+            acc = op(acc, first[i]);
+        }
+        partials[c] = acc;
+    });
+
+    T result = init;
+    for (const T& p : partials) {
+        result = op(result, p);
+    }
+    return result;
+}
+
+// out[i] = first[0] op ... op first[i]; out may equal first. Returns the end of the output.
+template <typename RandomIter, typename OutIter,
+    typename BinaryOp = std::plus<typename std::iterator_traits<RandomIter>::value_type>>
+OutIter parallel_inclusive_scan(RandomIter first, RandomIter last, OutIter out, BinaryOp op = BinaryOp{},
+    const ParallelOptions& opts = ParallelOptions{}) {
+    using T = typename std::iterator_traits<RandomIter>::value_type;
+    const size_t n = last - first;
+    if (n == 0) {
+        return out;
+    }
+
+    // Pass 1: scan each chunk on its own
+    std::vector<T> totals(parallel_detail::chunk_count(n, opts));
+    parallel_detail::for_chunks(n, opts, [&](size_t c, size_t b, size_t e) {
+        T acc = first[b];
+        out[b] = acc;
+        for (size_t i = b + 1; i < e; i++) {
+            acc = op(acc, first[i]);
+            out[i] = acc;
+        }
+        totals[c] = acc;
+    });
+
+    // Turn the chunk totals into the carry each chunk has to add
+    for (size_t c = 1; c < totals.size(); c++) {
+        totals[c] = op(totals[c - 1], totals[c]);
+    }
+
+    // Pass 2: fold the carry of everything before a chunk into it
+    parallel_detail::for_chunks(n, opts, [&](size_t c, size_t b, size_t e) {
+        if (c == 0) {
+            return;
+        }
+        const T carry = totals[c - 1];
+        for (size_t i = b; i < e; i++) {
+            out[i] = op(carry, out[i]);
+        }
+    });
+    return out + n;
+}
+
+// Copies the elements satisfying pred to out, keeping their order; returns the end of the output
+template <typename RandomIter, typename OutIter, typename Predicate>
+OutIter parallel_copy_if(RandomIter first, RandomIter last, OutIter out, Predicate pred,
+    const ParallelOptions& opts = ParallelOptions{}) {
+    const size_t n = last - first;
+    if (n == 0) {
+        return out;
+    }
+
+    // Pass 1: evaluate pred once per element and count the matches per chunk
+    std::vector<unsigned char> keep(n);
+    std::vector<size_t> offsets(parallel_detail::chunk_count(n, opts));
+    parallel_detail::for_chunks(n, opts, [&](size_t c, size_t b, size_t e) {
+        size_t matches = 0;
+        for (size_t i = b; i < e; i++) {
+            keep[i] = pred(first[i]) ? 1 : 0;
+            matches += keep[i];
+        }
+        offsets[c] = matches;
+    });
+
+    // Exclusive scan of the counts gives each chunk its output position
+    size_t total = 0;
+    for (size_t& o : offsets) {
+        size_t matches = o;
+        o = total;
+        total += matches;
+    }
+
+    // Pass 2: every chunk copies into its own slice of the output
+    parallel_detail::for_chunks(n, opts, [&](size_t c, size_t b, size_t e) {
+        OutIter o = out + offsets[c];
+        for (size_t i = b; i < e; i++) {
+            if (keep[i]) {
+                *o = first[i];
+                ++o;
+            }
+        }
+    });
+    return out + total;
+}
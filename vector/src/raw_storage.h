@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm> // std::move, std::move_backward
+#include <cstddef> // size_t
+#include <cstring> // std::memcpy
+#include <new> // placement new
+#include <type_traits> // std::is_trivially_copyable
+#include <utility> // std::move
+
+/*
+    Element moves for vectors whose unused capacity is raw storage
+    (SmallVector, CompactVector): slots [0, size) hold live elements, the
+    slots after them are uninitialized memory, so an element moving into
+    them is constructed in place and one leaving them is destroyed.
+
+    Every function takes the array and its current size; the callers keep
+    the size (in the object or in the heap block) and update it afterwards.
+    The inserts need room for the new elements already.
+*/
+
+namespace raw_storage {
+
+    // Move-constructs count elements from src into raw storage at dst and destroys the sources
+    template <class T>
+    void relocate(T* src, size_t count, T* dst) {
+        if (std::is_trivially_copyable<T>::value) {
+            if (count > 0) {
+                std::memcpy(static_cast<void*>(dst), static_cast<const void*>(src), count * sizeof(T));
+            }
+            return;
+        }
+        for (size_t i = 0; i < count; i++) {
+            new (dst + i) T(std::move(src[i]));
+            src[i].~T();
+        }
+    }
+
+    template <class T>
+    void destroy(T* array, size_t count) noexcept {
+        for (size_t i = 0; i < count; i++) {
+            array[i].~T();
+        }
+    }
+
+    // Puts value at index, shifting [index, size) up by one
+    template <class T>
+    void insert(T* array, size_t size, size_t index, T&& value) {
+        if (index == size) {
+            new (array + size) T(std::move(value));
+        }
+        else {
+            // the last element moves into raw storage, the rest shift over it
+            new (array + size) T(std::move(array[size - 1]));
+            std::move_backward(array + index, array + size - 1, array + size);
+            array[index] = std::move(value);
+        }
+    }
+
+    // Puts count copies of value at index, shifting [index, size) up by count
+    template <class T>
+    void insert(T* array, size_t size, size_t index, size_t count, const T& value) {
+        // shift [index, size) up by count; slots at or past size are raw storage
+        for (size_t i = size; i > index; i--) {
+            size_t to = i - 1 + count;
+            if (to >= size) {
+                new (array + to) T(std::move(array[i - 1]));
+            }
+            else {
+                array[to] = std::move(array[i - 1]);
+            }
+        }
+
+        for (size_t i = index; i < index + count; i++) {
+            if (i >= size) {
+                new (array + i) T(value);
+            }
+            else {
+                array[i] = value;
+            }
+        }
+    }
+
+    // Removes [index, index + count), shifting the elements after it down
+    template <class T>
+    void erase(T* array, size_t size, size_t index, size_t count) {
+        std::move(array + index + count, array + size, array + index);
+        destroy(array + size - count, count);
+    }
+}
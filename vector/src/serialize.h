@@ -0,0 +1,342 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // uint32_t, uint64_t, SIZE_MAX
+#include <cstring> // std::memcmp, std::memcpy
+#include <istream>
+#include <iterator> // std::iterator_traits
+#include <ostream>
+#include <stdexcept> // std::runtime_error
+#include <string>
+#include <type_traits> // std::is_trivially_copyable, std::enable_if_t
+
+#include "Vector.h"
+#include "contiguous.h"
+
+/*
+    Binary serialization for Vector
+    -------------------------------
+
+    A compact format for shipping Vector contents between processes:
+
+    | 64 byte header                         | payload              |
+    | magic, version, kind, element size,    | raw element bytes    |
+    | count, payload bytes, checksum         | (or length prefixed  |
+    |                                        |  strings)            |
+
+    - Trivially copyable T: the payload is the elements' bytes, written with
+      one write() and read back with one read() straight into the Vector's
+      array. The header keeps the payload 64 byte aligned. A stream that
+      cannot seek is read in bounded pieces and copied over instead, so
+      that a forged count cannot make read() allocate more than the input
+      holds.
+    - std::string: every string is a uint64_t length followed by its bytes.
+    - The checksum is a Fletcher-64 over the payload (as 32 bit words, the
+      tail zero padded). It is cheap enough to run at memory bandwidth.
+
+    Example:
+
+    Vector<Sample> v = ...;
+    std::ofstream out("samples.bin", std::ios::binary);
+    serial::write(out, v.begin(), v.end());   // any contiguous range: Vector,
+                                              // Vector_Basic, pointers
+
+    std::ifstream in("samples.bin", std::ios::binary);
+    Vector<Sample> back = serial::read<Sample>(in);
+
+    // Zero copy: validate a buffer already in memory (e.g. mmap'ed or
+    // received) and use its elements where they are
+    serial::View<Sample> view = serial::view<Sample>(buffer, bytes);
+
+    Elements are stored in the writer's byte order and layout, so readers
+    must run on the same kind of machine. Errors (bad magic, wrong type,
+    truncated input, checksum mismatch) throw std::runtime_error.
+*/
+
+namespace serial {
+
+    constexpr uint32_t VERSION = 1;
+
+    enum Kind : uint32_t { RAW = 1, STRING = 2 };
+
+    struct Header {
+        char magic[8];
+        uint32_t version;
+        uint32_t kind;
+        uint64_t element_size; // sizeof(T) for RAW, 0 for STRING
+        uint64_t count;
+        uint64_t payload_bytes;
+        uint64_t checksum;
+        uint64_t unused[2];
+    };
+    static_assert(sizeof(Header) == 64, "header must keep the payload 64 byte aligned");
+
+    constexpr char MAGIC[8] = { 'V', 'E', 'C', 'T', 'O', 'R', 'B', 'N' };
+
+    // Fletcher-64 over 32 bit words, reducing lazily so the loop is two adds per word
+    inline uint64_t checksum(const void* data, size_t bytes) noexcept {
+        const unsigned char* p = static_cast<const unsigned char*>(data);
+        const uint64_t MOD = 0xFFFFFFFFULL;
+        uint64_t a = 0, b = 0;
+        size_t words = bytes / 4;
+        while (words > 0) {
+            // b stays below 2^64 for this many words between reductions
+            size_t block = words < 65536 ? words : 65536;
+            words -= block;
+            for (size_t i = 0; i < block; i++, p += 4) {
+                uint32_t w;
+                std::memcpy(&w, p, 4);
+                a += w;
+                b += a;
+            }
+            a %= MOD;
+            b %= MOD;
+        }
+        if (bytes % 4 != 0) {
+            uint32_t w = 0;
+            std::memcpy(&w, p, bytes % 4);
+            a = (a + w) % MOD;
+            b = (b + a) % MOD;
+        }
+        return (b << 32) | a;
+    }
+
+    namespace detail {
+
+        inline Header make_header(Kind kind, uint64_t element_size, uint64_t count, uint64_t payload_bytes,
+            uint64_t sum) {
+            Header h{};
+            std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+            h.version = VERSION;
+            h.kind = kind;
+            h.element_size = element_size;
+            h.count = count;
+            h.payload_bytes = payload_bytes;
+            h.checksum = sum;
+            return h;
+        }
+
+        inline void check_header(const Header& h, Kind kind, uint64_t element_size) {
+            if (std::memcmp(h.magic, MAGIC, sizeof(MAGIC)) != 0) {
+                throw std::runtime_error("not a serialized vector (bad magic)");
+            }
+            if (h.version != VERSION) {
+                throw std::runtime_error("unsupported serialized vector version " + std::to_string(h.version));
+            }
+            if (h.kind != kind || h.element_size != element_size) {
+                throw std::runtime_error("serialized vector holds a different element type");
+            }
+            // count * element_size must not wrap around to a plausible payload size
+            if (kind == RAW && h.count > SIZE_MAX / element_size) {
+                throw std::runtime_error("serialized vector header is inconsistent");
+            }
+            if (kind == RAW && h.payload_bytes != h.count * element_size) {
+                throw std::runtime_error("serialized vector header is inconsistent");
+            }
+        }
+
+        inline void write_bytes(std::ostream& out, const void* data, size_t bytes) {
+            out.write(static_cast<const char*>(data), static_cast<std::streamsize>(bytes));
+            if (!out) {
+                throw std::runtime_error("failed to write serialized vector");
+            }
+        }
+
+        inline void read_bytes(std::istream& in, void* data, size_t bytes) {
+            in.read(static_cast<char*>(data), static_cast<std::streamsize>(bytes));
+            if (static_cast<size_t>(in.gcount()) != bytes) {
+                throw std::runtime_error("serialized vector is truncated");
+            }
+        }
+
+        // Throws if a seekable stream holds fewer than bytes more bytes, so a
+        // forged count fails before anything is allocated for it. Returns false
+        // for a stream that cannot seek (a pipe, a socket), whose length is unknown
+        inline bool check_available(std::istream& in, uint64_t bytes) {
+            std::streambuf* buf = in.rdbuf();
+            const std::streampos here = buf->pubseekoff(0, std::ios::cur, std::ios::in);
+            if (here == std::streampos(-1)) {
+                return false;
+            }
+            const std::streampos end = buf->pubseekoff(0, std::ios::end, std::ios::in);
+            buf->pubseekpos(here, std::ios::in);
+            if (end == std::streampos(-1)) {
+                return false;
+            }
+            if (static_cast<uint64_t>(end - here) < bytes) {
+                throw std::runtime_error("serialized vector is truncated");
+            }
+            return true;
+        }
+
+        // Reads bytes in pieces of at most 1 MiB, so that memory grows with
+        // the input actually there rather than with what the header claims
+        inline std::string read_in_pieces(std::istream& in, uint64_t bytes) {
+            const size_t piece = size_t(1) << 20;
+            std::string payload;
+            while (payload.size() < bytes) {
+                size_t n = bytes - payload.size() < piece ? bytes - payload.size() : piece;
+                size_t at = payload.size();
+                payload.resize(at + n);
+                read_bytes(in, &payload[at], n);
+            }
+            return payload;
+        }
+
+        inline void verify(const void* payload, const Header& h) {
+            if (checksum(payload, h.payload_bytes) != h.checksum) {
+                throw std::runtime_error("serialized vector checksum mismatch");
+            }
+        }
+
+        template <typename Iter>
+        using value_of = typename std::iterator_traits<Iter>::value_type;
+    }
+
+    // Writes the contiguous range [first, last) of trivially copyable elements.
+    // Only pointers and iterators marked is_contiguous are accepted: the
+    // payload is copied as one block of bytes starting at &*first
+    template <typename ContiguousIter, typename T = detail::value_of<ContiguousIter>>
+    std::enable_if_t<std::is_trivially_copyable<T>::value && is_contiguous_iterator<ContiguousIter>::value>
+    write(std::ostream& out, ContiguousIter first, ContiguousIter last) {
+        const size_t count = last - first;
+        const T* data = count > 0 ? &*first : nullptr;
+        const size_t bytes = count * sizeof(T);
+
+        Header h = detail::make_header(RAW, sizeof(T), count, bytes, checksum(data, bytes));
+        detail::write_bytes(out, &h, sizeof(h));
+        if (bytes > 0) {
+            detail::write_bytes(out, data, bytes);
+        }
+    }
+
+    // Writes a range of strings, each as a uint64_t length and its bytes
+    template <typename Iter, typename T = detail::value_of<Iter>>
+    std::enable_if_t<std::is_same<T, std::string>::value>
+    write(std::ostream& out, Iter first, Iter last) {
+        // Build the payload first so it can be checksummed and written at once
+        std::string payload;
+        size_t count = 0;
+        for (Iter it = first; it != last; ++it, ++count) {
+            uint64_t length = it->size();
+            payload.append(reinterpret_cast<const char*>(&length), sizeof(length));
+            payload.append(*it);
+        }
+
+        Header h = detail::make_header(STRING, 0, count, payload.size(), checksum(payload.data(), payload.size()));
+        detail::write_bytes(out, &h, sizeof(h));
+        detail::write_bytes(out, payload.data(), payload.size());
+    }
+
+    // Reads a vector written by write(); verify = false skips the checksum pass
+    template <typename T>
+    std::enable_if_t<std::is_trivially_copyable<T>::value, Vector<T>>
+    read(std::istream& in, bool verify = true) {
+        Header h;
+        detail::read_bytes(in, &h, sizeof(h));
+        detail::check_header(h, RAW, sizeof(T));
+
+        if (h.payload_bytes > 0 && !detail::check_available(in, h.payload_bytes)) {
+            // unknown length: the payload is read first and copied over once it is all there
+            std::string payload = detail::read_in_pieces(in, h.payload_bytes);
+            Vector<T> v(h.count);
+            std::memcpy(v.data(), payload.data(), payload.size());
+            if (verify) {
+                detail::verify(v.data(), h);
+            }
+            return v;
+        }
+
+        Vector<T> v(h.count);
+        if (h.payload_bytes > 0) {
+            detail::read_bytes(in, v.data(), h.payload_bytes); // the one read of the payload
+        }
+        if (verify) {
+            detail::verify(v.data(), h);
+        }
+        return v;
+    }
+
+    template <typename T>
+    std::enable_if_t<std::is_same<T, std::string>::value, Vector<T>>
+    read(std::istream& in, bool verify = true) {
+        Header h;
+        detail::read_bytes(in, &h, sizeof(h));
+        detail::check_header(h, STRING, 0);
+
+        std::string payload;
+        if (detail::check_available(in, h.payload_bytes)) {
+            payload.resize(h.payload_bytes);
+            if (h.payload_bytes > 0) {
+                detail::read_bytes(in, &payload[0], h.payload_bytes);
+            }
+        }
+        else {
+            payload = detail::read_in_pieces(in, h.payload_bytes);
+        }
+        if (verify) {
+            detail::verify(payload.data(), h);
+        }
+
+        Vector<std::string> v;
+        size_t pos = 0;
+        for (uint64_t i = 0; i < h.count; i++) {
+            uint64_t length;
+            if (payload.size() - pos < sizeof(length)) {
+                throw std::runtime_error("serialized vector is truncated");
+            }
+            std::memcpy(&length, payload.data() + pos, sizeof(length));
+            pos += sizeof(length);
+            if (payload.size() - pos < length) {
+                throw std::runtime_error("serialized vector is truncated");
+            }
+            v.push_back(payload.substr(pos, length));
+            pos += length;
+        }
+        return v;
+    }
+
+    // Elements of a serialized vector used in place, inside someone else's buffer
+    template <typename T>
+    class View {
+        const T* ptr;
+        size_t count;
+
+    public:
+        View(const T* ptr, size_t count) noexcept : ptr(ptr), count(count) {}
+
+        const T* begin() const noexcept { return ptr; }
+        const T* end() const noexcept { return ptr + count; }
+        const T* data() const noexcept { return ptr; }
+        size_t size() const noexcept { return count; }
+        [[nodiscard]] bool empty() const noexcept { return count == 0; }
+        const T& operator[](size_t pos) const noexcept { return ptr[pos]; }
+    };
+
+    // Validates a serialized vector held in buffer and returns its elements
+    // without copying them. The buffer must outlive the view and be aligned
+    // for T (malloc, new and mmap memory are). verify = false skips the checksum.
+    template <typename T>
+    View<T> view(const void* buffer, size_t bytes, bool verify = true) {
+        static_assert(std::is_trivially_copyable<T>::value, "only trivially copyable elements can be viewed in place");
+
+        if (bytes < sizeof(Header)) {
+            throw std::runtime_error("serialized vector is truncated");
+        }
+        Header h;
+        std::memcpy(&h, buffer, sizeof(h));
+        detail::check_header(h, RAW, sizeof(T));
+        if (bytes - sizeof(Header) < h.payload_bytes) {
+            throw std::runtime_error("serialized vector is truncated");
+        }
+
+        const char* payload = static_cast<const char*>(buffer) + sizeof(Header);
+        if (reinterpret_cast<uintptr_t>(payload) % alignof(T) != 0) {
+            throw std::runtime_error("buffer is not aligned for the element type");
+        }
+        if (verify) {
+            detail::verify(payload, h);
+        }
+        return View<T>(reinterpret_cast<const T*>(payload), h.count);
+    }
+}
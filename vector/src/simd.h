@@ -0,0 +1,568 @@
+#pragma once
+
+#include <cstddef> // size_t
+#include <cstdint> // int8_t, int16_t, int32_t, int64_t, uint64_t
+#include <cstring> // std::memcpy
+#include <iterator> // std::iterator_traits
+#include <limits> // std::numeric_limits
+#include <ostream>
+#include <type_traits> // std::is_arithmetic, std::enable_if
+#include <utility> // std::index_sequence
+
+#include "contiguous.h"
+
+/*
+    Vectorized search and reduction kernels
+    ---------------------------------------
+
+    Drop-in replacements for the scalar find / count / min / max / sum /
+    dot / prefix-sum loops over contiguous ranges of arithmetic types:
+    plain pointers, or iterators that declare
+    using is_contiguous = std::true_type; as Vector's, SmallVector's and
+    CompactVector's do (the marker sort::is_contiguous_iterator reads).
+
+    Every kernel is written once against GCC/Clang vector extensions and
+    instantiated for each ISA level with a target attribute, so the same
+    body is compiled to SSE2, AVX2 and AVX-512 instructions. The best level
+    the running CPU supports is picked at runtime; every function also takes
+    an optional Isa argument to force a lower level (levels the CPU cannot
+    run are clamped down to simd::detected()).
+
+    Example:
+
+    Vector<float> v = ...;
+
+    float total = simd::sum(v.begin(), v.end());
+    auto lowest = simd::min_element(v.begin(), v.end());
+    simd::inclusive_scan(v.begin(), v.end(), v.begin()); // in place
+
+    Floating point sums, dot products and scans are reassociated, so they
+    may differ from a sequential loop in the last few bits. The position
+    returned by min_element / max_element is unspecified when the range
+    holds a NaN.
+*/
+
+#if defined(__x86_64__) || defined(__i386__)
+#define SIMD_X86 1
+#endif
+
+#define SIMD_INLINE inline __attribute__((always_inline))
+
+namespace simd {
+
+    enum class Isa { SCALAR, SSE2, AVX2, AVX512 };
+
+    inline std::ostream& operator<<(std::ostream& o, Isa isa) {
+        switch (isa) {
+            case Isa::SCALAR:
+                return o << "scalar";
+            case Isa::SSE2:
+                return o << "sse2";
+            case Isa::AVX2:
+                return o << "avx2";
+            case Isa::AVX512:
+                return o << "avx512";
+            default:
+                return o << "unknown";
+        }
+    }
+
+    // Whether the running CPU (and OS) can execute the given level
+    inline bool supported(Isa isa) noexcept {
+#ifdef SIMD_X86
+        __builtin_cpu_init();
+        switch (isa) {
+            case Isa::SCALAR:
+                return true;
+            case Isa::SSE2:
+                return __builtin_cpu_supports("sse2");
+            case Isa::AVX2:
+                return __builtin_cpu_supports("avx2");
+            case Isa::AVX512:
+                return __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw");
+        }
+        return false;
+#else
+        return isa == Isa::SCALAR;
+#endif
+    }
+
+    // Highest level supported by the running CPU, detected once
+    inline Isa detected() noexcept {
+        static const Isa best = [] {
+            for (Isa isa : { Isa::AVX512, Isa::AVX2, Isa::SSE2 }) {
+                if (supported(isa)) {
+                    return isa;
+                }
+            }
+            return Isa::SCALAR;
+        }();
+        return best;
+    }
+
+    namespace detail {
+
+        // An iterator a kernel can take: contiguous (see contiguous.h), over arithmetic non-bool elements
+        template <typename Iter>
+        struct kernel_iterator : std::integral_constant<bool,
+            is_contiguous_iterator<Iter>::value &&
+            std::is_arithmetic<typename std::iterator_traits<Iter>::value_type>::value &&
+            !std::is_same<typename std::iterator_traits<Iter>::value_type, bool>::value> {};
+
+        // R, if every iterator that reaches a kernel passes the check
+        template <typename R, typename... Iters>
+        using enable_for_all = typename std::enable_if<(kernel_iterator<Iters>::value && ...), R>::type;
+
+        template <typename Iter, typename R>
+        using enable_for = enable_for_all<R, Iter>;
+
+        template <typename T>
+        T* address(T* p) noexcept { return p; }
+
+        // operator-> gives the pointer without dereferencing (end() may be null)
+        template <typename Iter>
+        typename std::iterator_traits<Iter>::pointer address(const Iter& it) noexcept { return it.operator->(); }
+
+        template <size_t Size> struct lane_int;
+        template <> struct lane_int<1> { using type = int8_t; };
+        template <> struct lane_int<2> { using type = int16_t; };
+        template <> struct lane_int<4> { using type = int32_t; };
+        template <> struct lane_int<8> { using type = int64_t; };
+
+        // A register of Bytes / sizeof(T) lanes, plus the matching comparison mask
+        template <typename T, size_t Bytes>
+        struct lanes {
+            static constexpr size_t count = Bytes / sizeof(T);
+            using mask_lane = typename lane_int<sizeof(T)>::type;
+            typedef T vec __attribute__((vector_size(Bytes)));
+            typedef mask_lane mask __attribute__((vector_size(Bytes)));
+            typedef uint64_t words __attribute__((vector_size(Bytes)));
+        };
+
+        namespace kernel {
+
+            template <typename V, typename T>
+            SIMD_INLINE void load(V& x, const T* p) { std::memcpy(&x, p, sizeof(V)); }
+
+            template <typename V, typename T>
+            SIMD_INLINE void store(T* p, const V& x) { std::memcpy(p, &x, sizeof(V)); }
+
+            template <typename L>
+            SIMD_INLINE bool any(const typename L::mask& m) {
+                typename L::words w = (typename L::words) m;
+                uint64_t r = 0;
+                for (size_t k = 0; k < sizeof(w) / sizeof(uint64_t); k++) {
+                    r |= w[k];
+                }
+                return r != 0;
+            }
+
+            // out = x shifted up by K lanes, zero filled from the bottom
+            template <size_t K, typename V, size_t... I>
+            SIMD_INLINE void shift_up(V& out, const V& x, std::index_sequence<I...>) {
+                out = __builtin_shufflevector(x, V{}, (I >= K ? I - K : sizeof...(I) + I)...);
+            }
+
+            // Hillis-Steele prefix sum within one register: log2(lanes) shift + add steps
+            template <size_t K, typename L>
+            SIMD_INLINE void prefix_lanes(typename L::vec& x) {
+                if constexpr (K < L::count) {
+                    typename L::vec shifted;
+                    shift_up<K>(shifted, x, std::make_index_sequence<L::count>{});
+                    x += shifted;
+                    prefix_lanes<2 * K, L>(x);
+                }
+            }
+
+            template <typename T, size_t Bytes>
+            SIMD_INLINE size_t find(const T* p, size_t n, T value) {
+                using L = lanes<T, Bytes>;
+                const typename L::vec needle = typename L::vec{} + value;
+
+                size_t i = 0;
+                for (; i + L::count <= n; i += L::count) {
+                    typename L::vec x;
+                    load(x, p + i);
+                    if (any<L>(x == needle)) {
+                        break;
+                    }
+                }
+                // finishes the tail or pins down the lane that matched
+                for (; i < n; i++) {
+                    if (p[i] == value) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+
+            template <typename T, size_t Bytes>
+            SIMD_INLINE size_t count(const T* p, size_t n, T value) {
+                using L = lanes<T, Bytes>;
+                // matching lanes are -1 in the mask, so subtracting counts them
+                // the per-lane counters are flushed before they can overflow
+                constexpr size_t flush = std::numeric_limits<typename L::mask_lane>::max();
+                const typename L::vec needle = typename L::vec{} + value;
+
+                typename L::mask acc = {};
+                size_t total = 0, pending = 0, i = 0;
+                for (; i + L::count <= n; i += L::count) {
+                    typename L::vec x;
+                    load(x, p + i);
+                    acc -= (x == needle);
+                    if (++pending == flush) {
+                        for (size_t k = 0; k < L::count; k++) {
+                            total += static_cast<size_t>(acc[k]);
+                        }
+                        acc = typename L::mask{};
+                        pending = 0;
+                    }
+                }
+                for (size_t k = 0; k < L::count; k++) {
+                    total += static_cast<size_t>(acc[k]);
+                }
+                for (; i < n; i++) {
+                    total += (p[i] == value);
+                }
+                return total;
+            }
+
+            // Index of the first minimum (or maximum) element. The range is reduced
+            // chunk by chunk so that only the winning chunk is rescanned for the index.
+            template <typename T, size_t Bytes, bool Max>
+            SIMD_INLINE size_t extreme(const T* p, size_t n) {
+                using L = lanes<T, Bytes>;
+                constexpr size_t chunk = 64 * L::count;
+                auto better = [](T a, T b) { return Max ? b < a : a < b; };
+
+                if (n == 0) {
+                    return 0;
+                }
+
+                T best = p[0];
+                size_t best_start = 0;
+                for (size_t start = 0; start < n; start += chunk) {
+                    const size_t len = n - start < chunk ? n - start : chunk;
+                    const T* q = p + start;
+                    T m = q[0];
+                    size_t i = 0;
+                    if (len >= L::count) {
+                        typename L::vec acc;
+                        load(acc, q);
+                        for (i = L::count; i + L::count <= len; i += L::count) {
+                            typename L::vec x;
+                            load(x, q + i);
+                            if constexpr (Max) {
+                                acc = x > acc ? x : acc;
+                            } else {
+                                acc = x < acc ? x : acc;
+                            }
+                        }
+                        m = acc[0];
+                        for (size_t k = 1; k < L::count; k++) {
+                            if (better(acc[k], m)) {
+                                m = acc[k];
+                            }
+                        }
+                    }
+                    for (; i < len; i++) {
+                        if (better(q[i], m)) {
+                            m = q[i];
+                        }
+                    }
+                    if (better(m, best)) {
+                        best = m;
+                        best_start = start;
+                    }
+                }
+
+                for (size_t i = best_start; i < n; i++) {
+                    if (p[i] == best) {
+                        return i;
+                    }
+                }
+                return best_start;
+            }
+
+            template <typename T, size_t Bytes>
+            SIMD_INLINE T sum(const T* p, size_t n) {
+                using L = lanes<T, Bytes>;
+                typename L::vec a0 = {}, a1 = {};
+                size_t i = 0;
+                // two accumulators keep two adds in flight
+                for (; i + 2 * L::count <= n; i += 2 * L::count) {
+                    typename L::vec x, y;
+                    load(x, p + i);
+                    load(y, p + i + L::count);
+                    a0 += x;
+                    a1 += y;
+                }
+                for (; i + L::count <= n; i += L::count) {
+                    typename L::vec x;
+                    load(x, p + i);
+                    a0 += x;
+                }
+                a0 += a1;
+                T total = 0;
+                for (size_t k = 0; k < L::count; k++) {
+                    total += a0[k];
+                }
+                for (; i < n; i++) {
+                    total += p[i];
+                }
+                return total;
+            }
+
+            template <typename T, size_t Bytes>
+            SIMD_INLINE T dot(const T* a, const T* b, size_t n) {
+                using L = lanes<T, Bytes>;
+                typename L::vec a0 = {}, a1 = {};
+                size_t i = 0;
+                for (; i + 2 * L::count <= n; i += 2 * L::count) {
+                    typename L::vec x0, y0, x1, y1;
+                    load(x0, a + i);
+                    load(y0, b + i);
+                    load(x1, a + i + L::count);
+                    load(y1, b + i + L::count);
+                    a0 += x0 * y0;
+                    a1 += x1 * y1;
+                }
+                for (; i + L::count <= n; i += L::count) {
+                    typename L::vec x, y;
+                    load(x, a + i);
+                    load(y, b + i);
+                    a0 += x * y;
+                }
+                a0 += a1;
+                T total = 0;
+                for (size_t k = 0; k < L::count; k++) {
+                    total += a0[k];
+                }
+                for (; i < n; i++) {
+                    total += a[i] * b[i];
+                }
+                return total;
+            }
+
+            // in and out may be the same array
+            template <typename T, size_t Bytes>
+            SIMD_INLINE void inclusive_scan(const T* in, size_t n, T* out) {
+                using L = lanes<T, Bytes>;
+                T carry = 0;
+                size_t i = 0;
+                for (; i + L::count <= n; i += L::count) {
+                    typename L::vec x;
+                    load(x, in + i);
+                    prefix_lanes<1, L>(x);
+                    x += carry;
+                    store(out + i, x);
+                    carry = x[L::count - 1];
+                }
+                for (; i < n; i++) {
+                    carry += in[i];
+                    out[i] = carry;
+                }
+            }
+        }
+
+        namespace scalar {
+
+            template <typename T>
+            size_t find(const T* p, size_t n, T value) {
+                for (size_t i = 0; i < n; i++) {
+                    if (p[i] == value) {
+                        return i;
+                    }
+                }
+                return n;
+            }
+
+            template <typename T>
+            size_t count(const T* p, size_t n, T value) {
+                size_t total = 0;
+                for (size_t i = 0; i < n; i++) {
+                    total += (p[i] == value);
+                }
+                return total;
+            }
+
+            template <typename T, bool Max>
+            size_t extreme(const T* p, size_t n) {
+                size_t best = 0;
+                for (size_t i = 1; i < n; i++) {
+                    if (Max ? p[best] < p[i] : p[i] < p[best]) {
+                        best = i;
+                    }
+                }
+                return best;
+            }
+
+            template <typename T>
+            size_t min_index(const T* p, size_t n) { return extreme<T, false>(p, n); }
+
+            template <typename T>
+            size_t max_index(const T* p, size_t n) { return extreme<T, true>(p, n); }
+
+            template <typename T>
+            T sum(const T* p, size_t n) {
+                T total = 0;
+                for (size_t i = 0; i < n; i++) {
+                    total += p[i];
+                }
+                return total;
+            }
+
+            template <typename T>
+            T dot(const T* a, const T* b, size_t n) {
+                T total = 0;
+                for (size_t i = 0; i < n; i++) {
+                    total += a[i] * b[i];
+                }
+                return total;
+            }
+
+            template <typename T>
+            void inclusive_scan(const T* in, size_t n, T* out) {
+                T carry = 0;
+                for (size_t i = 0; i < n; i++) {
+                    carry += in[i];
+                    out[i] = carry;
+                }
+            }
+        }
+
+// Stamps out the kernels for one ISA level. The kernels are force-inlined
+// into these wrappers so they are compiled with the wrapper's target.
+#define SIMD_DEFINE_LEVEL(level, target_isa, bytes)                                                 \
+        namespace level {                                                                           \
+            template <typename T> __attribute__((target(target_isa)))                               \
+            size_t find(const T* p, size_t n, T value) { return kernel::find<T, bytes>(p, n, value); } \
+            template <typename T> __attribute__((target(target_isa)))                               \
+            size_t count(const T* p, size_t n, T value) { return kernel::count<T, bytes>(p, n, value); } \
+            template <typename T> __attribute__((target(target_isa)))                               \
+            size_t min_index(const T* p, size_t n) { return kernel::extreme<T, bytes, false>(p, n); } \
+            template <typename T> __attribute__((target(target_isa)))                               \
+            size_t max_index(const T* p, size_t n) { return kernel::extreme<T, bytes, true>(p, n); } \
+            template <typename T> __attribute__((target(target_isa)))                               \
+            T sum(const T* p, size_t n) { return kernel::sum<T, bytes>(p, n); }                     \
+            template <typename T> __attribute__((target(target_isa)))                               \
+            T dot(const T* a, const T* b, size_t n) { return kernel::dot<T, bytes>(a, b, n); }      \
+            template <typename T> __attribute__((target(target_isa)))                               \
+            void inclusive_scan(const T* in, size_t n, T* out) { kernel::inclusive_scan<T, bytes>(in, n, out); } \
+        }
+
+#ifdef SIMD_X86
+        SIMD_DEFINE_LEVEL(sse2, "sse2", 16)
+        SIMD_DEFINE_LEVEL(avx2, "avx2", 32)
+        SIMD_DEFINE_LEVEL(avx512, "avx512f,avx512bw", 64)
+#endif
+
+#undef SIMD_DEFINE_LEVEL
+
+        // Never run a level the CPU lacks; fall back to the best one it has
+        inline Isa resolve(Isa isa) noexcept {
+            return static_cast<int>(isa) > static_cast<int>(detected()) ? detected() : isa;
+        }
+
+        // Expands to a switch calling level::fn(args...) for the resolved level
+#ifdef SIMD_X86
+#define SIMD_DISPATCH(isa, fn, ...)                              \
+        switch (detail::resolve(isa)) {                         \
+            case Isa::AVX512: return detail::avx512::fn(__VA_ARGS__); \
+            case Isa::AVX2:   return detail::avx2::fn(__VA_ARGS__);   \
+            case Isa::SSE2:   return detail::sse2::fn(__VA_ARGS__);   \
+            default:          return detail::scalar::fn(__VA_ARGS__); \
+        }
+#else
+#define SIMD_DISPATCH(isa, fn, ...) return detail::scalar::fn(__VA_ARGS__);
+#endif
+    }
+
+    // Returns the first position holding value, or end
+    template <typename Iter>
+    detail::enable_for<Iter, Iter> find(Iter begin, Iter end,
+        const typename std::iterator_traits<Iter>::value_type& value, Isa isa = detected()) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        const T* p = detail::address(begin);
+        const size_t n = end - begin;
+        auto at = [&]() -> size_t { SIMD_DISPATCH(isa, find<T>, p, n, value) };
+        return begin + at();
+    }
+
+    // Returns how many elements equal value
+    template <typename Iter>
+    detail::enable_for<Iter, size_t> count(Iter begin, Iter end,
+        const typename std::iterator_traits<Iter>::value_type& value, Isa isa = detected()) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        const T* p = detail::address(begin);
+        const size_t n = end - begin;
+        SIMD_DISPATCH(isa, count<T>, p, n, value)
+    }
+
+    // Returns the first smallest element, or end if the range is empty
+    template <typename Iter>
+    detail::enable_for<Iter, Iter> min_element(Iter begin, Iter end, Isa isa = detected()) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        const T* p = detail::address(begin);
+        const size_t n = end - begin;
+        if (n == 0) {
+            return end;
+        }
+        auto at = [&]() -> size_t { SIMD_DISPATCH(isa, min_index<T>, p, n) };
+        return begin + at();
+    }
+
+    // Returns the first largest element, or end if the range is empty
+    template <typename Iter>
+    detail::enable_for<Iter, Iter> max_element(Iter begin, Iter end, Isa isa = detected()) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        const T* p = detail::address(begin);
+        const size_t n = end - begin;
+        if (n == 0) {
+            return end;
+        }
+        auto at = [&]() -> size_t { SIMD_DISPATCH(isa, max_index<T>, p, n) };
+        return begin + at();
+    }
+
+    // Sum of the range (0 if empty), accumulated in the element type
+    template <typename Iter>
+    detail::enable_for<Iter, typename std::iterator_traits<Iter>::value_type>
+    sum(Iter begin, Iter end, Isa isa = detected()) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        const T* p = detail::address(begin);
+        const size_t n = end - begin;
+        SIMD_DISPATCH(isa, sum<T>, p, n)
+    }
+
+    // Inner product of [a_begin, a_end) with the range starting at b_begin
+    template <typename Iter1, typename Iter2>
+    detail::enable_for_all<typename std::iterator_traits<Iter1>::value_type, Iter1, Iter2>
+    dot(Iter1 a_begin, Iter1 a_end, Iter2 b_begin, Isa isa = detected()) {
+        using T = typename std::iterator_traits<Iter1>::value_type;
+        static_assert(std::is_same<T, typename std::iterator_traits<Iter2>::value_type>::value,
+            "dot requires both ranges to hold the same type");
+        const T* a = detail::address(a_begin);
+        const T* b = detail::address(b_begin);
+        const size_t n = a_end - a_begin;
+        SIMD_DISPATCH(isa, dot<T>, a, b, n)
+    }
+
+    // Writes the running totals of [begin, end) starting at out, which may equal begin.
+    // Returns the end of the written range.
+    template <typename Iter, typename OutIter>
+    detail::enable_for_all<OutIter, Iter, OutIter> inclusive_scan(Iter begin, Iter end, OutIter out, Isa isa = detected()) {
+        using T = typename std::iterator_traits<Iter>::value_type;
+        static_assert(std::is_same<T, typename std::iterator_traits<OutIter>::value_type>::value,
+            "inclusive_scan requires the output to hold the input type");
+        const T* in = detail::address(begin);
+        T* o = detail::address(out);
+        const size_t n = end - begin;
+        auto run = [&]() { SIMD_DISPATCH(isa, inclusive_scan<T>, in, n, o) };
+        run();
+        return out + n;
+    }
+}
+
+#undef SIMD_DISPATCH
+#undef SIMD_INLINE
@@ -0,0 +1,161 @@
+#include "executable.h"
+#include "BitVector.h"
+#include "../../../graph/Graph.h"
+
+#include <sstream>
+#include <vector>
+
+TEST(bit_vector_flags_and_count) {
+    Typegen t;
+
+    BitVector bits(1000);
+    std::vector<bool> gt(1000, false);
+    ASSERT_TRUE(bits.none());
+
+    for (size_t i = 0; i < 300; i++) {
+        size_t pos = t.range<size_t>(0, 999);
+        bits.set(pos);
+        gt[pos] = true;
+    }
+
+    size_t expected = 0;
+    for (size_t i = 0; i < gt.size(); i++) {
+        ASSERT_EQ(static_cast<bool>(gt[i]), bits[i]);
+        expected += gt[i];
+    }
+    ASSERT_EQ(expected, bits.count());
+    ASSERT_EQ(16ULL, bits.words());
+    ASSERT_EXCEPTION(bits.at(1000), std::out_of_range);
+
+    // find_first/find_next visit exactly the set flags in order
+    size_t visited = 0;
+    size_t previous = 0;
+    for (size_t i = bits.find_first(); i < bits.size(); i = bits.find_next(i)) {
+        ASSERT_TRUE(gt[i]);
+        if (visited > 0) {
+            ASSERT_LE(previous + 1, i);
+        }
+        previous = i;
+        visited++;
+    }
+    ASSERT_EQ(expected, visited);
+
+    bits.flip();
+    ASSERT_EQ(1000 - expected, bits.count());
+    bits.set_all();
+    ASSERT_TRUE(bits.all());
+    bits.reset_all();
+    ASSERT_EQ(bits.size(), bits.find_first());
+}
+
+TEST(bit_vector_push_back_and_resize) {
+    BitVector bits;
+    for (size_t i = 0; i < 130; i++) {
+        bits.push_back(i % 3 == 0);
+    }
+    ASSERT_EQ(130ULL, bits.size());
+    ASSERT_EQ(44ULL, bits.count());
+
+    bits.resize(65);
+    ASSERT_EQ(22ULL, bits.count());
+
+    // growing again must not resurrect the flags that were cut off
+    bits.resize(200, true);
+    ASSERT_EQ(22ULL + 135ULL, bits.count());
+    ASSERT_FALSE(bits[62]);
+    ASSERT_FALSE(bits[64]);
+    ASSERT_TRUE(bits[65]);
+    ASSERT_TRUE(bits[199]);
+
+    bits.pop_back();
+    ASSERT_EQ(199ULL, bits.size());
+    ASSERT_EQ(22ULL + 134ULL, bits.count());
+
+    BitVector copy = bits;
+    ASSERT_TRUE(copy == bits);
+    copy.flip(0);
+    ASSERT_TRUE(copy != bits);
+}
+
+TEST(bit_vector_word_operations) {
+    Typegen t;
+
+    BitVector a(777), b(777);
+    std::vector<bool> ga(777), gb(777);
+    for (size_t i = 0; i < 777; i++) {
+        ga[i] = t.get<bool>();
+        gb[i] = t.get<bool>();
+        a.set(i, ga[i]);
+        b.set(i, gb[i]);
+    }
+
+    BitVector both = a & b;
+    BitVector either = a | b;
+    BitVector one = a ^ b;
+    BitVector only_a = a;
+    only_a.and_not(b);
+
+    for (size_t i = 0; i < 777; i++) {
+        ASSERT_EQ(ga[i] && gb[i], both[i]);
+        ASSERT_EQ(ga[i] || gb[i], either[i]);
+        ASSERT_EQ(ga[i] != gb[i], one[i]);
+        ASSERT_EQ(ga[i] && !gb[i], only_a[i]);
+    }
+
+    BitVector shorter(10);
+    ASSERT_EXCEPTION(a &= shorter, std::invalid_argument);
+}
+
+TEST(bit_vector_rank_select) {
+    Typegen t;
+
+    BitVector bits(5000);
+    for (size_t i = 0; i < 5000; i++) {
+        bits.set(i, t.range<int>(0, 9) == 0);
+    }
+
+    size_t ones = 0;
+    for (size_t i = 0; i <= bits.size(); i++) {
+        ASSERT_EQ(ones, bits.rank(i));
+        if (i < bits.size() && bits[i]) {
+            ASSERT_EQ(i, bits.select(ones));
+            ones++;
+        }
+    }
+    ASSERT_EQ(bits.size(), bits.select(ones));
+
+    // the index is rebuilt after a change
+    size_t first = bits.find_first();
+    bits.reset(first);
+    ASSERT_EQ(ones - 1, bits.rank(bits.size()));
+    ASSERT_EQ(bits.find_first(), bits.select(0));
+}
+
+TEST(bit_vector_graph_visited_set) {
+    Graph g = {
+        {1, 4, 6},
+        {2, 6},
+        {4, 5},
+        {},
+        {1, 2, 3, 5},
+        {3},
+        {2, 3}
+    };
+
+    // bfs/dfs print the traversal order, compare it with the original VisitedSet
+    std::ostringstream original, bit_packed;
+    std::streambuf* saved = std::cout.rdbuf(original.rdbuf());
+    VisitedSet vs(g.num_vertices());
+    dfs(g, 0, vs);
+    bfs(g, 0);
+    std::cout.rdbuf(bit_packed.rdbuf());
+    BitVisitedSet bvs(g.num_vertices());
+    dfs(g, 0, bvs);
+    bfs<BitVisitedSet>(g, 0);
+    std::cout.rdbuf(saved);
+
+    ASSERT_TRUE(original.str() == bit_packed.str());
+    ASSERT_EQ(7ULL, bvs.visited_flags().count());
+    ASSERT_TRUE(bvs.has_processed(3));
+    ASSERT_EXCEPTION(bvs.has_visited(7), std::invalid_argument);
+}
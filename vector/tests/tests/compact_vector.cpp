@@ -0,0 +1,92 @@
+#include "executable.h"
+#include "CompactVector.h"
+
+#include <string>
+#include <vector>
+
+TEST(compact_vector_is_one_pointer) {
+    Memhook mh;
+
+    ASSERT_EQ(sizeof(void*), sizeof(CompactVector<int>));
+    ASSERT_EQ(sizeof(void*), sizeof(CompactVector<std::string>));
+
+    // empty vectors are a null pointer and never allocate
+    CompactVector<int> v;
+    CompactVector<int> copy(v);
+    CompactVector<int> moved(std::move(copy));
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(0ULL, v.capacity());
+    ASSERT_TRUE(v.data() == nullptr);
+    ASSERT_TRUE(v.begin() == v.end());
+    ASSERT_EQ(0UL, mh.n_allocs());
+
+    // one block holds the counts and the elements
+    v.push_back(1);
+    ASSERT_EQ(1UL, mh.n_allocs());
+    ASSERT_EQ(1ULL, v.size());
+    ASSERT_EQ(1ULL, v.capacity());
+
+    v.pop_back();
+    v.shrink_to_fit();
+    ASSERT_TRUE(v.data() == nullptr);
+}
+
+TEST(compact_vector_matches_vector) {
+    Typegen t;
+
+    CompactVector<int> v;
+    std::vector<int> gt;
+    for (size_t i = 0; i < 1000; i++) {
+        int value = t.get<int>();
+        size_t pos = gt.empty() ? 0 : t.range<size_t>(0, gt.size());
+        v.insert(v.begin() + pos, value);
+        gt.insert(gt.begin() + pos, value);
+    }
+    v.insert(v.begin() + 10, 5, -1);
+    gt.insert(gt.begin() + 10, 5, -1);
+    v.erase(v.begin() + 3);
+    gt.erase(gt.begin() + 3);
+    v.erase(v.begin() + 100, v.begin() + 200);
+    gt.erase(gt.begin() + 100, gt.begin() + 200);
+
+    ASSERT_EQ(gt.size(), v.size());
+    size_t i = 0;
+    for (auto it = v.begin(); it != v.end(); ++it, ++i) {
+        ASSERT_EQ(gt[i], *it);
+    }
+    ASSERT_EQ(gt.front(), v.front());
+    ASSERT_EQ(gt.back(), v.back());
+    ASSERT_EXCEPTION(v.at(gt.size()), std::out_of_range);
+
+    CompactVector<int> copy;
+    copy = v;
+    v.clear();
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(gt.size(), copy.size());
+    ASSERT_EQ(gt[500], copy[500]);
+}
+
+TEST(compact_vector_non_trivial_elements) {
+    using Strings = CompactVector<std::string>;
+
+    std::string long_string(100, 'x');
+    Strings v(3, long_string);
+    v.push_back(v.front()); // aliasing an element while growing
+    for (int i = 0; i < 10; i++) {
+        v.insert(v.begin(), long_string + std::to_string(i));
+    }
+    ASSERT_EQ(14ULL, v.size());
+    ASSERT_TRUE(v.front() == long_string + "9");
+    ASSERT_TRUE(v.back() == long_string);
+
+    v.erase(v.begin(), v.begin() + 9);
+    ASSERT_EQ(5ULL, v.size());
+    ASSERT_TRUE(v.front() == long_string + "0");
+
+    Strings moved = std::move(v);
+    ASSERT_TRUE(v.empty());
+    ASSERT_EQ(5ULL, moved.size());
+
+    Strings defaults(4);
+    ASSERT_TRUE(defaults[3].empty());
+}
@@ -0,0 +1,194 @@
+#include "executable.h"
+#include "ConcurrentVector.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
+TEST(concurrent_vector_single_thread) {
+    ConcurrentVector<int, 4> v;
+    ASSERT_TRUE(v.empty());
+
+    for (int i = 0; i < 100; i++) {
+        ASSERT_EQ(static_cast<size_t>(i), v.push_back(i));
+    }
+    int* first = &v[0];
+
+    ASSERT_EQ(100ULL, v.grow_by(50, -1));
+    ASSERT_EQ(150ULL, v.size());
+    ASSERT_EQ(first, &v[0]);
+    ASSERT_EQ(-1, v[149]);
+    ASSERT_EXCEPTION(v.at(150), std::out_of_range);
+
+    int i = 0;
+    for (auto it = v.begin(); it != v.end(); ++it, ++i) {
+        ASSERT_EQ(i < 100 ? i : -1, *it);
+    }
+
+    ConcurrentVector<int, 4> copy(v);
+    v.clear();
+    ASSERT_EQ(0ULL, v.size());
+    ASSERT_EQ(150ULL, copy.size());
+    ASSERT_EQ(99, copy[99]);
+}
+
+TEST(concurrent_vector_many_producers) {
+    const size_t threads = 4;
+    const size_t per_thread = 20000;
+
+    ConcurrentVector<size_t> v;
+    std::atomic<bool> done{false};
+    std::atomic<size_t> bad_reads{0};
+
+    // A reader scanning the published prefix while the producers run
+    std::thread reader([&] {
+        while (!done.load()) {
+            size_t n = v.size();
+            for (size_t i = 0; i < n; i++) {
+                if (v[i] == 0) {
+                    bad_reads++;
+                }
+            }
+        }
+    });
+
+    std::vector<std::vector<size_t>> batches(threads);
+    std::vector<std::thread> producers;
+    for (size_t t = 0; t < threads; t++) {
+        producers.emplace_back([&, t] {
+            for (size_t i = 0; i < per_thread; i++) {
+                size_t value = t * per_thread + i + 1;
+                if (i % 100 == 0) {
+                    // a batch of 10 copies claims 10 consecutive indices
+                    batches[t].push_back(v.grow_by(10, value));
+                    i += 9;
+                }
+                else {
+                    v.push_back(value);
+                }
+            }
+        });
+    }
+    for (std::thread& p : producers) {
+        p.join();
+    }
+    done = true;
+    reader.join();
+
+    ASSERT_EQ(0ULL, bad_reads.load());
+    ASSERT_EQ(threads * per_thread, v.size());
+
+    for (const std::vector<size_t>& firsts : batches) {
+        for (size_t first : firsts) {
+            for (size_t j = 1; j < 10; j++) {
+                ASSERT_EQ(v[first], v[first + j]);
+            }
+        }
+    }
+
+    // every single push landed exactly once
+    std::vector<size_t> seen(threads * per_thread + 1, 0);
+    for (auto it = v.begin(); it != v.end(); ++it) {
+        seen[*it]++;
+    }
+    for (size_t value = 1; value < seen.size(); value++) {
+        size_t i = (value - 1) % per_thread;
+        if (i % 100 == 0) {
+            ASSERT_EQ(10ULL, seen[value]);
+        }
+        else if (i % 100 >= 10) {
+            ASSERT_EQ(1ULL, seen[value]);
+        }
+    }
+    ASSERT_EQ(0ULL, seen[0]);
+}
+
+namespace {
+    // An element whose constructor waits until the next one has started,
+    // so that from the first append on there is always one in flight
+    struct Overlapping {
+        size_t order;
+
+        Overlapping(std::atomic<size_t>& started, const std::atomic<bool>& stop) : order(started++) {
+            while (started.load() <= order + 1 && !stop.load()) {
+                std::this_thread::yield();
+            }
+        }
+    };
+}
+
+TEST(concurrent_vector_size_grows_under_constant_appends) {
+    ConcurrentVector<Overlapping> v;
+    std::atomic<size_t> started{0};
+    std::atomic<bool> stop{false};
+
+    std::vector<std::thread> writers;
+    for (size_t t = 0; t < 3; t++) {
+        writers.emplace_back([&] {
+            while (!stop.load()) {
+                v.emplace_back(started, stop);
+            }
+        });
+    }
+
+    // the writers never all go idle, yet size() keeps up with them
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+    size_t last = 0;
+    size_t increases = 0;
+    while (increases < 100 && std::chrono::steady_clock::now() < deadline) {
+        size_t n = v.size();
+        if (n > last) {
+            increases++;
+            last = n;
+        }
+        std::this_thread::yield();
+    }
+    const size_t seen_while_running = last;
+    stop = true;
+    for (std::thread& w : writers) {
+        w.join();
+    }
+
+    ASSERT_EQ(100ULL, increases);
+    ASSERT_TRUE(seen_while_running >= 100);
+    ASSERT_EQ(started.load(), v.size());
+}
+
+TEST(concurrent_vector_tiny_blocks_many_producers) {
+    // with blocks of 1, 2, 4, ... elements the appends keep reaching new
+    // blocks, so publishing scans indices whose block nobody has allocated
+    // yet; many rounds make for many fresh blocks
+    for (int round = 0; round < 300; round++) {
+        const size_t threads = 8;
+        const size_t per_thread = 2000;
+        ConcurrentVector<int, 1> v;
+
+        std::vector<std::thread> producers;
+        for (size_t t = 0; t < threads; t++) {
+            producers.emplace_back([&, t] {
+                for (size_t i = 0; i < per_thread; i++) {
+                    if (i % 50 == 0) {
+                        v.grow_by(3, static_cast<int>(t));
+                        i += 2;
+                    }
+                    else {
+                        v.push_back(static_cast<int>(t));
+                    }
+                }
+            });
+        }
+        for (std::thread& p : producers) {
+            p.join();
+        }
+
+        ASSERT_EQ(threads * per_thread, v.size());
+        std::vector<size_t> per_producer(threads, 0);
+        for (auto it = v.begin(); it != v.end(); ++it) {
+            per_producer[*it]++;
+        }
+        for (size_t count : per_producer) {
+            ASSERT_EQ(per_thread, count);
+        }
+    }
+}
@@ -0,0 +1,146 @@
+#include "executable.h"
+#include "CowVector.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(cow_vector_shares_until_written) {
+    Typegen t;
+
+    Vector<int> source;
+    for (size_t i = 0; i < 1000; i++) {
+        source.push_back(t.get<int>());
+    }
+    CowVector<int> a(source);
+    ASSERT_EQ(1ULL, a.use_count());
+
+    {
+        Memhook mh;
+        const CowVector<int> b = a.snapshot();
+        CowVector<int> c = a.share();
+        // copies are O(1): nothing is allocated and the elements are shared
+        ASSERT_EQ(0UL, mh.n_allocs());
+        ASSERT_EQ(3ULL, a.use_count());
+        ASSERT_EQ(b.data(), static_cast<const CowVector<int>&>(a).data());
+
+        // the first write gives c its own copy, a and b are untouched
+        c[0] = source[0] + 1;
+        ASSERT_EQ(2UL, mh.n_allocs());
+        ASSERT_EQ(2ULL, a.use_count());
+        ASSERT_EQ(1ULL, c.use_count());
+        ASSERT_EQ(source[0], b[0]);
+        ASSERT_EQ(source[0] + 1, c[0]);
+
+        // further writes to a private copy do not copy again
+        c[1] = 0;
+        c.pop_back();
+        c.push_back(5);
+        ASSERT_EQ(2UL, mh.n_allocs());
+    }
+    ASSERT_EQ(1ULL, a.use_count());
+
+    const CowVector<int>& ca = a;
+    size_t i = 0;
+    for (auto it = ca.begin(); it != ca.end(); ++it, ++i) {
+        ASSERT_EQ(source[i], *it);
+    }
+    ASSERT_EXCEPTION(ca.at(1000), std::out_of_range);
+}
+
+TEST(cow_vector_push_back_and_pop_back) {
+    CowVector<std::string> a;
+    for (int i = 0; i < 10; i++) {
+        a.push_back(std::string(50, 'a' + i));
+    }
+    CowVector<std::string> b = a;
+
+    a.pop_back();
+    ASSERT_TRUE(a.is_shared());
+    ASSERT_EQ(9ULL, a.size());
+    ASSERT_EQ(10ULL, b.size());
+
+    // pushing into the shared buffer must not clobber b's last element
+    a.push_back(a.front());
+    ASSERT_FALSE(a.is_shared());
+    ASSERT_TRUE(a.back() == std::string(50, 'a'));
+    ASSERT_TRUE(b.get(9) == std::string(50, 'j')); // b.back() would make b unshareable
+
+    CowVector<std::string> moved = std::move(b);
+    ASSERT_EQ(0ULL, b.size());
+    ASSERT_EQ(0ULL, b.use_count());
+    ASSERT_EQ(10ULL, moved.size());
+
+    a = moved;
+    ASSERT_EQ(2ULL, moved.use_count());
+    a.clear();
+    ASSERT_TRUE(a.empty());
+    ASSERT_EQ(10ULL, moved.size());
+}
+
+TEST(cow_vector_concurrent_snapshots) {
+    CowVector<size_t> shared;
+    for (size_t i = 0; i < 10000; i++) {
+        shared.push_back(i);
+    }
+    const CowVector<size_t>& readonly = shared;
+
+    std::vector<size_t> sums(4, 0);
+    std::vector<std::thread> readers;
+    for (size_t t = 0; t < sums.size(); t++) {
+        readers.emplace_back([&, t] {
+            for (int round = 0; round < 100; round++) {
+                const CowVector<size_t> mine = readonly.snapshot();
+                size_t sum = 0;
+                for (size_t v : mine) {
+                    sum += v;
+                }
+                sums[t] = sum;
+            }
+        });
+    }
+    for (std::thread& r : readers) {
+        r.join();
+    }
+
+    for (size_t s : sums) {
+        ASSERT_EQ(10000ULL * 9999ULL / 2, s);
+    }
+    ASSERT_EQ(1ULL, shared.use_count());
+}
+
+TEST(cow_vector_mutable_access_is_never_shared) {
+    CowVector<int> a;
+    for (int i = 0; i < 8; i++) {
+        a.push_back(i);
+    }
+
+    // a reference taken while a is unshared must not reach the snapshot
+    int& first = a[0];
+    const CowVector<int> snap = a.snapshot();
+    ASSERT_EQ(1ULL, a.use_count());
+    first = 100;
+    ASSERT_EQ(0, snap[0]);
+    ASSERT_EQ(100, a.get(0));
+
+    // the same for iterators and data()
+    auto it = a.begin();
+    CowVector<int> copy = a;
+    *it = 200;
+    ASSERT_EQ(100, copy.get(0));
+    int* raw = a.data();
+    copy = a.share();
+    raw[1] = 300;
+    ASSERT_EQ(1, copy.get(1));
+    ASSERT_EQ(300, a.get(1));
+
+    // const access hands out nothing writable, so snapshots share again
+    // once a moves to a new buffer
+    while (a.size() < a.capacity()) {
+        a.push_back(0);
+    }
+    a.push_back(0);
+    const CowVector<int> later = a.snapshot();
+    ASSERT_EQ(2ULL, a.use_count());
+    ASSERT_EQ(static_cast<const CowVector<int>&>(a).data(), later.data());
+}
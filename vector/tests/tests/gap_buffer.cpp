@@ -0,0 +1,105 @@
+#include "executable.h"
+#include "GapBuffer.h"
+#include "../../../sorting/src/sorting.h"
+
+#include <string>
+#include <vector>
+
+TEST(gap_buffer_random_edits) {
+    Typegen t;
+
+    GapBuffer<int> gb;
+    std::vector<int> gt;
+
+    for (size_t step = 0; step < 5000; step++) {
+        size_t pos = gt.empty() ? 0 : t.range<size_t>(0, gt.size());
+        int op = t.range<int>(0, 9);
+        if (op < 6 || gt.empty()) {
+            int value = t.get<int>();
+            auto it = gb.insert(gb.begin() + pos, value);
+            gt.insert(gt.begin() + pos, value);
+            ASSERT_EQ(value, *it);
+        }
+        else if (op < 8) {
+            if (pos == gt.size()) {
+                pos--;
+            }
+            gb.erase(gb.begin() + pos);
+            gt.erase(gt.begin() + pos);
+        }
+        else {
+            size_t count = t.range<size_t>(0, 4);
+            if (pos + count > gt.size()) {
+                count = gt.size() - pos;
+            }
+            gb.erase(gb.begin() + pos, gb.begin() + pos + count);
+            gt.erase(gt.begin() + pos, gt.begin() + pos + count);
+        }
+        ASSERT_EQ(gt.size(), gb.size());
+    }
+
+    for (size_t i = 0; i < gt.size(); i++) {
+        ASSERT_EQ(gt[i], gb[i]);
+    }
+    size_t i = 0;
+    for (auto it = gb.begin(); it != gb.end(); ++it, ++i) {
+        ASSERT_EQ(gt[i], *it);
+    }
+    ASSERT_EXCEPTION(gb.at(gt.size()), std::out_of_range);
+}
+
+TEST(gap_buffer_cursor_editing) {
+    GapBuffer<char> text;
+    std::string typed = "hello world";
+    for (char c : typed) {
+        text.push_back(c);
+    }
+    ASSERT_EQ(typed.size(), text.cursor());
+
+    // typing in the middle keeps the gap right after the inserted text
+    text.set_cursor(5);
+    text.insert(text.begin() + 5, ',');
+    text.insert(text.begin() + 6, 3, '!');
+    ASSERT_EQ(9ULL, text.cursor());
+    text.erase(text.begin() + 8); // backspace
+    ASSERT_EQ(8ULL, text.cursor());
+
+    std::string result;
+    for (char c : text) {
+        result += c;
+    }
+    ASSERT_TRUE(result == "hello,!! world");
+    ASSERT_EQ('h', text.front());
+    ASSERT_EQ('d', text.back());
+
+    // the gap does not change what a copy contains
+    GapBuffer<char> copy = text;
+    GapBuffer<char> moved = std::move(text);
+    ASSERT_EQ(0ULL, text.size());
+    ASSERT_EQ(copy.size(), moved.size());
+    for (size_t i = 0; i < copy.size(); i++) {
+        ASSERT_EQ(copy[i], moved[i]);
+    }
+    moved.clear();
+    ASSERT_TRUE(moved.empty());
+    moved.pop_back();
+    ASSERT_TRUE(moved.empty());
+}
+
+TEST(gap_buffer_sorting_algorithms) {
+    Typegen t;
+
+    GapBuffer<int> gb;
+    std::vector<int> gt;
+    for (size_t i = 0; i < 200; i++) {
+        int value = t.get<int>();
+        gb.insert(gb.begin() + i / 2, value);
+        gt.insert(gt.begin() + i / 2, value);
+    }
+    // the gap sits in the middle while sorting
+    sort::insertion(gb.begin(), gb.end());
+    sort::insertion(gt.begin(), gt.end());
+    for (size_t i = 0; i < gt.size(); i++) {
+        ASSERT_EQ(gt[i], gb[i]);
+    }
+}
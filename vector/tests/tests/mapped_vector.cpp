@@ -0,0 +1,156 @@
+#include "executable.h"
+#include "MappedVector.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+    struct Record {
+        int id;
+        double value;
+        char tag[4];
+    };
+
+    // Reserves a fresh, empty file name under /tmp
+    std::string temp_path() {
+        char path[] = "/tmp/mapped_vector_XXXXXX";
+        int fd = mkstemp(path);
+        close(fd);
+        return path;
+    }
+}
+
+TEST(mapped_vector_push_back_and_reopen) {
+    Typegen t;
+    std::string path = temp_path();
+
+    std::vector<Record> gt(5000);
+    for (Record& r : gt) {
+        r.id = t.get<int>();
+        r.value = t.get<double>();
+        r.tag[0] = t.get<char>();
+    }
+
+    {
+        MappedVector<Record> mv(path);
+        ASSERT_TRUE(mv.empty());
+
+        Record* first = nullptr;
+        for (size_t i = 0; i < gt.size(); i++) {
+            mv.push_back(gt[i]);
+            if (i == 0) {
+                first = &mv[0];
+            }
+            // growth happens in place, the array never moves
+            ASSERT_EQ(first, &mv[0]);
+        }
+        ASSERT_EQ(gt.size(), mv.size());
+        ASSERT_LE(mv.size(), mv.capacity());
+        mv.flush();
+    }
+
+    {
+        MappedVector<Record> ro(path, MappedVector<Record>::READ_ONLY);
+        ASSERT_TRUE(ro.read_only());
+        ASSERT_EQ(gt.size(), ro.size());
+
+        size_t i = 0;
+        for (auto it = ro.begin(); it != ro.end(); ++it, ++i) {
+            ASSERT_EQ(gt[i].id, it->id);
+            ASSERT_EQ(gt[i].value, it->value);
+            ASSERT_EQ(gt[i].tag[0], it->tag[0]);
+        }
+        ASSERT_EQ(gt.size(), i);
+        ASSERT_EXCEPTION(ro.push_back(gt[0]), std::logic_error);
+    }
+
+    {
+        // reopening for writing appends after the existing records
+        MappedVector<Record> mv(path);
+        ASSERT_EQ(gt.size(), mv.size());
+        mv.pop_back();
+        mv.push_back(gt[0]);
+        ASSERT_EQ(gt[0].id, mv.back().id);
+        ASSERT_EXCEPTION(mv.at(mv.size()), std::out_of_range);
+    }
+
+    unlink(path.c_str());
+}
+
+TEST(mapped_vector_type_mismatch) {
+    std::string path = temp_path();
+
+    {
+        MappedVector<int> mv(path);
+        mv.push_back(1);
+    }
+
+    ASSERT_EXCEPTION(MappedVector<double>{path}, std::runtime_error);
+    ASSERT_EXCEPTION(MappedVector<int>{"/nonexistent-dir/file.dat"}, std::runtime_error);
+
+    unlink(path.c_str());
+}
+
+TEST(mapped_vector_move) {
+    std::string path = temp_path();
+
+    MappedVector<int> a(path);
+    for (int i = 0; i < 100; i++) {
+        a.push_back(i);
+    }
+
+    MappedVector<int> b(std::move(a));
+    ASSERT_EQ(0ULL, a.size());
+    ASSERT_EQ(100ULL, b.size());
+    ASSERT_EQ(99, b[99]);
+
+    unlink(path.c_str());
+}
+
+TEST(mapped_vector_leaves_foreign_files_alone) {
+    std::string path = temp_path();
+    auto file_size = [&] {
+        struct stat st;
+        stat(path.c_str(), &st);
+        return static_cast<size_t>(st.st_size);
+    };
+
+    // 100 bytes of text: mapping it as 24 byte records would cut it to 88
+    const std::string text(100, 'x');
+    {
+        FILE* f = fopen(path.c_str(), "wb");
+        fwrite(text.data(), 1, text.size(), f);
+        fclose(f);
+    }
+    ASSERT_EXCEPTION(MappedVector<Record>{path}, std::runtime_error);
+    ASSERT_EXCEPTION((MappedVector<Record>{path, MappedVector<Record>::READ_ONLY}), std::runtime_error);
+    ASSERT_EQ(text.size(), file_size());
+    {
+        std::string back(text.size(), '\0');
+        FILE* f = fopen(path.c_str(), "rb");
+        ASSERT_EQ(text.size(), fread(&back[0], 1, back.size(), f));
+        fclose(f);
+        ASSERT_TRUE(text == back);
+    }
+
+    // a MappedVector of another type keeps its size too
+    {
+        MappedVector<int> mv(path + ".ints");
+        mv.push_back(7);
+    }
+    std::string ints = path + ".ints";
+    struct stat before;
+    stat(ints.c_str(), &before);
+    ASSERT_EXCEPTION(MappedVector<Record>{ints}, std::runtime_error);
+    struct stat after;
+    stat(ints.c_str(), &after);
+    ASSERT_EQ(before.st_size, after.st_size);
+    ASSERT_EQ(7, MappedVector<int>(ints, MappedVector<int>::READ_ONLY)[0]);
+
+    unlink(ints.c_str());
+    unlink(path.c_str());
+}
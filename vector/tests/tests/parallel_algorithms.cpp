@@ -0,0 +1,129 @@
+#include "executable.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+    // Every combination of pool size, schedule and grain the tests run under
+    template <typename Fn>
+    void for_each_configuration(Fn fn) {
+        for (size_t threads : { 1, 2, 5 }) {
+            ThreadPool pool(threads);
+            for (Schedule schedule : { Schedule::STATIC, Schedule::DYNAMIC }) {
+                for (size_t grain : { 0, 1, 7, 1000 }) {
+                    fn(ParallelOptions{ schedule, grain, &pool });
+                }
+            }
+        }
+    }
+}
+
+TEST(parallel_for_each_and_transform) {
+    Typegen t;
+
+    for_each_configuration([&](const ParallelOptions& opts) {
+        for (size_t sz : { 0, 1, 13, 2049 }) {
+            Vector<int> vec(sz), out(sz);
+            std::vector<int> gt(sz);
+            for (size_t i = 0; i < sz; i++) {
+                vec[i] = gt[i] = t.range<int>(-1000, 1000);
+            }
+
+            parallel_for_each(vec.begin(), vec.end(), [](int& x) { x *= 3; }, opts);
+            auto last = parallel_transform(vec.begin(), vec.end(), out.begin(), [](int x) { return x - 1; }, opts);
+            ASSERT_TRUE(last == out.end());
+
+            for (size_t i = 0; i < sz; i++) {
+                ASSERT_EQ(gt[i] * 3, vec[i]);
+                ASSERT_EQ(gt[i] * 3 - 1, out[i]);
+            }
+        }
+    });
+}
+
+TEST(parallel_reduce_and_scan) {
+    Typegen t;
+
+    for_each_configuration([&](const ParallelOptions& opts) {
+        for (size_t sz : { 0, 1, 13, 2049 }) {
+            Vector<long long> vec(sz), out(sz);
+            std::vector<long long> gt(sz);
+            for (size_t i = 0; i < sz; i++) {
+                vec[i] = gt[i] = t.range<int>(-1000, 1000);
+            }
+
+            ASSERT_EQ(std::accumulate(gt.begin(), gt.end(), 5LL),
+                parallel_reduce(vec.begin(), vec.end(), 5LL, std::plus<long long>{}, opts));
+
+            std::partial_sum(gt.begin(), gt.end(), gt.begin());
+            parallel_inclusive_scan(vec.begin(), vec.end(), out.begin(), std::plus<long long>{}, opts);
+            // in place
+            parallel_inclusive_scan(vec.begin(), vec.end(), vec.begin(), std::plus<long long>{}, opts);
+            for (size_t i = 0; i < sz; i++) {
+                ASSERT_EQ(gt[i], out[i]);
+                ASSERT_EQ(gt[i], vec[i]);
+            }
+        }
+    });
+}
+
+TEST(parallel_reduce_keeps_order) {
+    // string concatenation is associative but not commutative
+    std::vector<std::string> letters;
+    for (char c = 'a'; c <= 'z'; c++) {
+        letters.push_back(std::string(1, c));
+    }
+
+    for_each_configuration([&](const ParallelOptions& opts) {
+        std::string joined = parallel_reduce(letters.begin(), letters.end(), std::string(), std::plus<std::string>{}, opts);
+        ASSERT_TRUE(joined == "abcdefghijklmnopqrstuvwxyz");
+    });
+}
+
+TEST(parallel_copy_if) {
+    Typegen t;
+
+    for_each_configuration([&](const ParallelOptions& opts) {
+        for (size_t sz : { 0, 1, 13, 2049 }) {
+            Vector<int> vec(sz), out(sz);
+            std::vector<int> gt;
+            for (size_t i = 0; i < sz; i++) {
+                vec[i] = t.range<int>(0, 100);
+                if (vec[i] % 3 == 0) {
+                    gt.push_back(vec[i]);
+                }
+            }
+
+            auto last = parallel_copy_if(vec.begin(), vec.end(), out.begin(), [](int x) { return x % 3 == 0; }, opts);
+            ASSERT_EQ(static_cast<ptrdiff_t>(gt.size()), last - out.begin());
+            for (size_t i = 0; i < gt.size(); i++) {
+                ASSERT_EQ(gt[i], out[i]);
+            }
+        }
+    });
+}
+
+TEST(parallel_nested_and_exceptions) {
+    ThreadPool pool(4);
+    ParallelOptions opts{ Schedule::DYNAMIC, 1, &pool };
+
+    Vector<int> outer(16, 0);
+    parallel_for_each(outer.begin(), outer.end(), [&](int& x) {
+        // a nested call runs serially on the calling thread
+        Vector<int> inner(100, 1);
+        x = parallel_reduce(inner.begin(), inner.end(), 0, std::plus<int>{}, opts);
+    }, opts);
+    for (size_t i = 0; i < outer.size(); i++) {
+        ASSERT_EQ(100, outer[i]);
+    }
+
+    ASSERT_EXCEPTION(parallel_for_each(outer.begin(), outer.end(), [](int& x) {
+        if (x == 100) throw std::runtime_error("boom");
+    }, opts), std::runtime_error);
+
+    // the pool is still usable afterwards
+    ASSERT_EQ(1600, parallel_reduce(outer.begin(), outer.end(), 0, std::plus<int>{}, opts));
+}
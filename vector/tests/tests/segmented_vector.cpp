@@ -0,0 +1,89 @@
+#include "executable.h"
+#include "SegmentedVector.h"
+#include "../../../sorting/src/sorting.h"
+
+#include <string>
+#include <vector>
+
+TEST(segmented_vector_stable_addresses) {
+    Typegen t;
+
+    SegmentedVector<int, 4> v;
+    std::vector<int> gt;
+    std::vector<int*> addresses;
+
+    for (size_t i = 0; i < 5000; i++) {
+        gt.push_back(t.get<int>());
+        v.push_back(gt.back());
+        addresses.push_back(&v.back());
+    }
+
+    ASSERT_EQ(gt.size(), v.size());
+    ASSERT_LE(v.size(), v.capacity());
+
+    // blocks of 4, 8, 16, ... so 11 blocks hold 4 * (2^11 - 1) elements
+    ASSERT_EQ(11ULL, v.block_count());
+    ASSERT_EQ(8188ULL, v.capacity());
+
+    for (size_t i = 0; i < gt.size(); i++) {
+        // nothing moved while the vector grew
+        ASSERT_EQ(addresses[i], &v[i]);
+        ASSERT_EQ(gt[i], v[i]);
+    }
+
+    size_t i = 0;
+    for (auto it = v.begin(); it != v.end(); ++it, ++i) {
+        ASSERT_EQ(gt[i], *it);
+    }
+    ASSERT_EQ(gt.size(), i);
+    ASSERT_EXCEPTION(v.at(gt.size()), std::out_of_range);
+}
+
+TEST(segmented_vector_iterators_survive_growth) {
+    SegmentedVector<std::string> v;
+    v.push_back("first");
+    auto it = v.begin();
+    std::string* p = &v.front();
+
+    for (int i = 0; i < 1000; i++) {
+        v.emplace_back(100, 'x');
+    }
+    ASSERT_TRUE(*it == "first");
+    ASSERT_EQ(p, &*it);
+    ASSERT_EQ(1001, v.end() - it);
+
+    v.pop_back();
+    ASSERT_EQ(1000ULL, v.size());
+
+    SegmentedVector<std::string> copy = v;
+    SegmentedVector<std::string> moved = std::move(v);
+    ASSERT_EQ(0ULL, v.size());
+    ASSERT_EQ(p, &moved.front());
+    ASSERT_TRUE(copy.back() == moved.back());
+
+    moved.clear();
+    ASSERT_TRUE(moved.empty());
+    ASSERT_LE(1000ULL, moved.capacity());
+}
+
+TEST(segmented_vector_sorting_algorithms) {
+    Typegen t;
+
+    for (size_t algo = 0; algo < 3; algo++) {
+        SegmentedVector<int, 2> v;
+        std::vector<int> gt;
+        for (size_t i = 0; i < 300; i++) {
+            gt.push_back(t.range<int>(-1000, 1000));
+            v.push_back(gt.back());
+        }
+
+        if (algo == 0) sort::bubble(v.begin(), v.end());
+        if (algo == 1) sort::insertion(v.begin(), v.end());
+        if (algo == 2) sort::selection(v.begin(), v.end());
+
+        sort::insertion(gt.begin(), gt.end());
+        for (size_t i = 0; i < gt.size(); i++) {
+            ASSERT_EQ(gt[i], v[i]);
+        }
+    }
+}
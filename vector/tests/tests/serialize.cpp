@@ -0,0 +1,194 @@
+#include "executable.h"
+#include "serialize.h"
+#include "../../../iterators/src/Vector_Basic.h"
+#include "SegmentedVector.h"
+
+#include <deque>
+#include <list>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace {
+    struct Sample {
+        int id;
+        float value;
+        char tag;
+    };
+
+    // Whether serial::write accepts a range of Iter
+    template <typename Iter, typename = void>
+    struct writable : std::false_type {};
+
+    template <typename Iter>
+    struct writable<Iter, std::void_t<decltype(serial::write(std::declval<std::ostream&>(), std::declval<Iter>(), std::declval<Iter>()))>>
+        : std::true_type {};
+
+    // A stream buffer that cannot seek, like a pipe's
+    struct Unseekable : std::stringbuf {
+        explicit Unseekable(const std::string& bytes) : std::stringbuf(bytes) {}
+
+    protected:
+        pos_type seekoff(off_type, std::ios::seekdir, std::ios::openmode) override { return pos_type(off_type(-1)); }
+        pos_type seekpos(pos_type, std::ios::openmode) override { return pos_type(off_type(-1)); }
+    };
+}
+
+TEST(serialize_round_trip_raw) {
+    Typegen t;
+
+    Vector<Sample> v;
+    for (size_t i = 0; i < 3000; i++) {
+        v.push_back(Sample{ t.get<int>(), t.get<float>(), t.get<char>() });
+    }
+
+    std::stringstream buffer;
+    serial::write(buffer, v.begin(), v.end());
+    ASSERT_EQ(sizeof(serial::Header) + v.size() * sizeof(Sample), buffer.str().size());
+
+    Vector<Sample> back = serial::read<Sample>(buffer);
+    ASSERT_EQ(v.size(), back.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        ASSERT_EQ(v[i].id, back[i].id);
+        ASSERT_EQ(v[i].value, back[i].value);
+        ASSERT_EQ(v[i].tag, back[i].tag);
+    }
+
+    // Vector_Basic iterators are contiguous too
+    std::vector<double> source(100);
+    for (double& d : source) {
+        d = t.get<double>();
+    }
+    Vector_Basic<double> basic(source);
+    std::stringstream basic_buffer;
+    serial::write(basic_buffer, basic.begin(), basic.end());
+    Vector<double> doubles = serial::read<double>(basic_buffer);
+    ASSERT_EQ(source.size(), doubles.size());
+    for (size_t i = 0; i < source.size(); i++) {
+        ASSERT_EQ(source[i], doubles[i]);
+    }
+}
+
+TEST(serialize_round_trip_strings) {
+    Vector<std::string> v;
+    v.push_back("");
+    v.push_back("short");
+    v.push_back(std::string(1000, 'x'));
+    v.push_back(std::string("embedded\0nul", 12));
+
+    std::stringstream buffer;
+    serial::write(buffer, v.begin(), v.end());
+    Vector<std::string> back = serial::read<std::string>(buffer);
+
+    ASSERT_EQ(v.size(), back.size());
+    for (size_t i = 0; i < v.size(); i++) {
+        ASSERT_TRUE(v[i] == back[i]);
+    }
+
+    // strings are not readable as raw elements
+    std::stringstream again;
+    serial::write(again, v.begin(), v.end());
+    ASSERT_EXCEPTION(serial::read<int>(again), std::runtime_error);
+}
+
+TEST(serialize_view_and_errors) {
+    Vector<int> v;
+    for (int i = 0; i < 1000; i++) {
+        v.push_back(i * i);
+    }
+    std::stringstream buffer;
+    serial::write(buffer, v.begin(), v.end());
+    std::string bytes = buffer.str();
+
+    // adopt a copy held in suitably aligned memory without another copy
+    Vector<long long> aligned(bytes.size() / sizeof(long long) + 1);
+    std::memcpy(aligned.data(), bytes.data(), bytes.size());
+    serial::View<int> view = serial::view<int>(aligned.data(), bytes.size());
+    ASSERT_EQ(1000ULL, view.size());
+    ASSERT_EQ(reinterpret_cast<const char*>(aligned.data()) + sizeof(serial::Header),
+              reinterpret_cast<const char*>(view.data()));
+    ASSERT_EQ(999 * 999, view[999]);
+
+    // a flipped payload byte fails the checksum
+    reinterpret_cast<char*>(aligned.data())[sizeof(serial::Header) + 10] ^= 1;
+    ASSERT_EXCEPTION(serial::view<int>(aligned.data(), bytes.size()), std::runtime_error);
+    serial::View<int> unchecked = serial::view<int>(aligned.data(), bytes.size(), false);
+    ASSERT_EQ(1000ULL, unchecked.size());
+
+    // wrong element size, truncation and bad magic
+    std::stringstream wrong_type(bytes);
+    ASSERT_EXCEPTION(serial::read<double>(wrong_type), std::runtime_error);
+    std::stringstream truncated(bytes.substr(0, bytes.size() - 1));
+    ASSERT_EXCEPTION(serial::read<int>(truncated), std::runtime_error);
+    std::stringstream garbage(std::string(100, 'g'));
+    ASSERT_EXCEPTION(serial::read<int>(garbage), std::runtime_error);
+}
+
+TEST(serialize_forged_count) {
+    Vector<int> v;
+    for (int i = 0; i < 100; i++) {
+        v.push_back(i);
+    }
+    std::stringstream buffer;
+    serial::write(buffer, v.begin(), v.end());
+    const std::string bytes = buffer.str();
+
+    auto forge = [&](uint64_t count, uint64_t payload_bytes) {
+        std::string forged = bytes;
+        serial::Header h;
+        std::memcpy(&h, forged.data(), sizeof(h));
+        h.count = count;
+        h.payload_bytes = payload_bytes;
+        std::memcpy(&forged[0], &h, sizeof(h));
+        return forged;
+    };
+
+    // count * sizeof(int) wraps around to the real payload size
+    const uint64_t wrapping = (uint64_t(1) << 62) + 100;
+    std::stringstream wrapped(forge(wrapping, wrapping * sizeof(int)));
+    ASSERT_EXCEPTION(serial::read<int>(wrapped), std::runtime_error);
+    std::string wrapped_bytes = forge(wrapping, wrapping * sizeof(int));
+    Vector<long long> aligned(wrapped_bytes.size() / sizeof(long long) + 1);
+    std::memcpy(aligned.data(), wrapped_bytes.data(), wrapped_bytes.size());
+    ASSERT_EXCEPTION(serial::view<int>(aligned.data(), wrapped_bytes.size()), std::runtime_error);
+
+    // a consistent header claiming 4 TiB: fails on the length of the input,
+    // before allocating, whether the stream can seek or not
+    const uint64_t huge = uint64_t(1) << 40;
+    std::stringstream seekable(forge(huge, huge * sizeof(int)));
+    ASSERT_EXCEPTION(serial::read<int>(seekable), std::runtime_error);
+
+    Unseekable pipe_buf(forge(huge, huge * sizeof(int)));
+    std::istream pipe(&pipe_buf);
+    ASSERT_EXCEPTION(serial::read<int>(pipe), std::runtime_error);
+
+    Unseekable string_buf(forge(huge, huge));
+    std::istream string_pipe(&string_buf);
+    ASSERT_EXCEPTION(serial::read<std::string>(string_pipe), std::runtime_error);
+
+    // an unseekable stream still reads a well formed vector
+    Unseekable good_buf(bytes);
+    std::istream good(&good_buf);
+    Vector<int> back = serial::read<int>(good);
+    ASSERT_EQ(100ULL, back.size());
+    ASSERT_EQ(99, back[99]);
+}
+
+TEST(serialize_write_needs_contiguous_iterators) {
+    // one block of bytes from &*first: only ranges that are one block compile
+    static_assert(writable<int*>::value, "pointers are contiguous");
+    static_assert(writable<Vector<int>::iterator>::value, "Vector is contiguous");
+    static_assert(writable<Vector_Basic<int>::iterator>::value, "Vector_Basic is marked contiguous");
+    static_assert(!writable<std::deque<int>::iterator>::value, "deque is stored in blocks");
+    static_assert(!writable<std::list<int>::iterator>::value, "list is stored in nodes");
+    static_assert(!writable<SegmentedVector<int>::iterator>::value, "SegmentedVector is stored in blocks");
+    // strings are written one by one, from any iterator
+    static_assert(writable<std::list<std::string>::iterator>::value, "strings take any iterator");
+
+    std::list<std::string> words = { "a", "bc", "" };
+    std::stringstream buffer;
+    serial::write(buffer, words.begin(), words.end());
+    Vector<std::string> back = serial::read<std::string>(buffer);
+    ASSERT_EQ(3ULL, back.size());
+    ASSERT_TRUE(back[1] == "bc");
+}
@@ -0,0 +1,168 @@
+#include "executable.h"
+#include "simd.h"
+#include "SmallVector.h"
+#include "../../../iterators/src/Vector_Basic.h"
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <list>
+#include <numeric>
+#include <vector>
+
+namespace {
+    // Whether simd::dot / simd::inclusive_scan accept these iterators
+    template <typename A, typename B, typename = void>
+    struct dot_takes : std::false_type {};
+    template <typename A, typename B>
+    struct dot_takes<A, B, std::void_t<decltype(simd::dot(std::declval<A>(), std::declval<A>(), std::declval<B>()))>>
+        : std::true_type {};
+
+    template <typename In, typename Out, typename = void>
+    struct scan_takes : std::false_type {};
+    template <typename In, typename Out>
+    struct scan_takes<In, Out, std::void_t<decltype(simd::inclusive_scan(std::declval<In>(), std::declval<In>(), std::declval<Out>()))>>
+        : std::true_type {};
+
+    const simd::Isa levels[] = { simd::Isa::SCALAR, simd::Isa::SSE2, simd::Isa::AVX2, simd::Isa::AVX512 };
+}
+
+TEST(simd_find_and_count) {
+    Typegen t;
+
+    for (simd::Isa isa : levels) {
+        for (size_t sz = 0; sz < 300; sz++) {
+            Vector<int> vec(sz);
+            std::vector<int> gt(sz);
+            for (size_t i = 0; i < sz; i++) {
+                vec[i] = gt[i] = t.range<int>(0, 8);
+            }
+
+            for (int needle = -1; needle <= 8; needle++) {
+                auto it = simd::find(vec.begin(), vec.end(), needle, isa);
+                ASSERT_EQ(std::find(gt.begin(), gt.end(), needle) - gt.begin(), it - vec.begin());
+                ASSERT_EQ(static_cast<size_t>(std::count(gt.begin(), gt.end(), needle)),
+                    simd::count(vec.begin(), vec.end(), needle, isa));
+            }
+        }
+    }
+}
+
+TEST(simd_count_narrow_lanes) {
+    // More than 127 full registers of int8_t so the lane counters must be flushed
+    for (simd::Isa isa : levels) {
+        Vector<int8_t> vec(100000, 3);
+        vec[7] = 4;
+        ASSERT_EQ(99999ULL, simd::count(vec.begin(), vec.end(), int8_t(3), isa));
+        ASSERT_EQ(1ULL, simd::count(vec.begin(), vec.end(), int8_t(4), isa));
+    }
+}
+
+TEST(simd_min_max_element) {
+    Typegen t;
+
+    for (simd::Isa isa : levels) {
+        for (size_t sz = 0; sz < 3000; sz += 1 + sz / 4) {
+            Vector<double> vec(sz);
+            std::vector<double> gt(sz);
+            for (size_t i = 0; i < sz; i++) {
+                // few distinct values so the first-occurrence rule matters
+                vec[i] = gt[i] = t.range<int>(-20, 20) * 0.5;
+            }
+
+            ASSERT_EQ(std::min_element(gt.begin(), gt.end()) - gt.begin(),
+                simd::min_element(vec.begin(), vec.end(), isa) - vec.begin());
+            ASSERT_EQ(std::max_element(gt.begin(), gt.end()) - gt.begin(),
+                simd::max_element(vec.begin(), vec.end(), isa) - vec.begin());
+        }
+    }
+}
+
+TEST(simd_sum_and_dot) {
+    Typegen t;
+
+    for (simd::Isa isa : levels) {
+        for (size_t sz = 0; sz < 500; sz++) {
+            Vector<int> a(sz), b(sz);
+            Vector<float> fa(sz), fb(sz);
+            long long gt_sum = 0, gt_dot = 0;
+            double gt_fsum = 0, gt_fdot = 0;
+            for (size_t i = 0; i < sz; i++) {
+                a[i] = t.range<int>(-1000, 1000);
+                b[i] = t.range<int>(-1000, 1000);
+                fa[i] = t.range<float>(-1, 1);
+                fb[i] = t.range<float>(-1, 1);
+                gt_sum += a[i];
+                gt_dot += a[i] * b[i];
+                gt_fsum += fa[i];
+                gt_fdot += fa[i] * fb[i];
+            }
+
+            ASSERT_EQ(gt_sum, simd::sum(a.begin(), a.end(), isa));
+            ASSERT_EQ(gt_dot, simd::dot(a.begin(), a.end(), b.begin(), isa));
+            ASSERT_NEAR(gt_fsum, simd::sum(fa.begin(), fa.end(), isa), 1e-3);
+            ASSERT_NEAR(gt_fdot, simd::dot(fa.begin(), fa.end(), fb.begin(), isa), 1e-3);
+        }
+    }
+}
+
+TEST(simd_inclusive_scan) {
+    Typegen t;
+
+    for (simd::Isa isa : levels) {
+        for (size_t sz = 0; sz < 300; sz++) {
+            Vector<int> vec(sz), out(sz);
+            std::vector<int> gt(sz);
+            for (size_t i = 0; i < sz; i++) {
+                vec[i] = gt[i] = t.range<int>(-1000, 1000);
+            }
+            std::partial_sum(gt.begin(), gt.end(), gt.begin());
+
+            auto last = simd::inclusive_scan(vec.begin(), vec.end(), out.begin(), isa);
+            ASSERT_TRUE(last == out.end());
+            for (size_t i = 0; i < sz; i++) {
+                ASSERT_EQ(gt[i], out[i]);
+            }
+
+            // in place
+            simd::inclusive_scan(vec.begin(), vec.end(), vec.begin(), isa);
+            for (size_t i = 0; i < sz; i++) {
+                ASSERT_EQ(gt[i], vec[i]);
+            }
+        }
+    }
+}
+
+TEST(simd_takes_any_contiguous_iterator) {
+    // Vector_Basic::iterator is no Vector<T>::iterator, it only carries the is_contiguous marker
+    std::vector<int> source(1000);
+    std::iota(source.begin(), source.end(), -500);
+    Vector_Basic<int> basic(source);
+    SmallVector<int, 4> small;
+    for (int value : source) {
+        small.push_back(value);
+    }
+
+    for (simd::Isa isa : levels) {
+        ASSERT_EQ(-500, *simd::min_element(basic.begin(), basic.end(), isa));
+        ASSERT_EQ(1ULL, simd::count(basic.begin(), basic.end(), 7, isa));
+        ASSERT_EQ(499, *simd::max_element(small.begin(), small.end(), isa));
+        ASSERT_EQ(-500LL, static_cast<long long>(simd::sum(small.begin(), small.end(), isa)));
+    }
+}
+
+TEST(simd_checks_every_iterator) {
+    // the second range of dot and the output of inclusive_scan are read and
+    // written as raw arrays too, so they must be contiguous as well
+    using V = Vector<int>::iterator;
+    static_assert(dot_takes<V, int*>::value, "pointer as the second range");
+    static_assert(dot_takes<int*, V>::value, "Vector as the second range");
+    static_assert(!dot_takes<V, std::list<int>::iterator>::value, "list as the second range");
+    static_assert(!dot_takes<V, std::deque<int>::iterator>::value, "deque as the second range");
+    static_assert(scan_takes<V, int*>::value, "pointer as the output");
+    static_assert(!scan_takes<V, std::deque<int>::iterator>::value, "deque as the output");
+    static_assert(!scan_takes<std::list<int>::iterator, int*>::value, "list as the input");
+
+    int a[] = { 1, 2, 3 };
+    Vector<int> b(3, 2);
+    ASSERT_EQ(12, simd::dot(a, a + 3, b.begin()));
+}
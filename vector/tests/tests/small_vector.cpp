@@ -0,0 +1,82 @@
+#include "executable.h"
+#include "SmallVector.h"
+
+#include <string>
+
+TEST(small_vector_stays_inline) {
+    Typegen t;
+    Memhook mh;
+
+    SmallVector<int, 8> v;
+    int gt[8];
+    for (size_t i = 0; i < 8; i++) {
+        gt[i] = t.get<int>();
+        v.push_back(gt[i]);
+    }
+
+    ASSERT_TRUE(v.is_inline());
+    ASSERT_EQ(8ULL, v.size());
+    ASSERT_EQ(0UL, mh.n_allocs());
+
+    size_t i = 0;
+    for (auto it = v.begin(); it != v.end(); ++it, ++i) {
+        ASSERT_EQ(gt[i], *it);
+    }
+
+    // moving an inline vector copies the elements, still no allocations
+    SmallVector<int, 8> moved(std::move(v));
+    ASSERT_EQ(8ULL, moved.size());
+    ASSERT_EQ(0ULL, v.size());
+    ASSERT_EQ(gt[7], moved.back());
+    ASSERT_EQ(0UL, mh.n_allocs());
+}
+
+TEST(small_vector_spills_to_heap) {
+    Memhook mh;
+
+    SmallVector<int, 4> v;
+    for (int i = 0; i < 5; i++) {
+        v.push_back(i);
+    }
+    ASSERT_FALSE(v.is_inline());
+    ASSERT_EQ(1UL, mh.n_allocs());
+    ASSERT_EQ(8ULL, v.capacity());
+
+    // moving a heap vector steals the buffer
+    int* data = v.data();
+    SmallVector<int, 4> moved(std::move(v));
+    ASSERT_EQ(data, moved.data());
+    ASSERT_TRUE(v.is_inline());
+    ASSERT_EQ(1UL, mh.n_allocs());
+
+    moved.insert(moved.begin() + 1, 2, -1);
+    moved.erase(moved.begin());
+    int gt[] = { -1, -1, 1, 2, 3, 4 };
+    ASSERT_EQ(6ULL, moved.size());
+    for (size_t i = 0; i < moved.size(); i++) {
+        ASSERT_EQ(gt[i], moved[i]);
+    }
+    ASSERT_EXCEPTION(moved.at(6), std::out_of_range);
+}
+
+TEST(small_vector_non_trivial_elements) {
+    SmallVector<std::string, 2> v;
+    std::string long_string(100, 'x');
+    for (int i = 0; i < 10; i++) {
+        v.insert(v.begin(), long_string + std::to_string(i));
+    }
+    v.push_back(v.front()); // aliasing an element while growing
+
+    ASSERT_EQ(11ULL, v.size());
+    ASSERT_TRUE(v.back() == long_string + "9");
+    ASSERT_TRUE(v[9] == long_string + "0");
+
+    v.erase(v.begin(), v.begin() + 9);
+    ASSERT_EQ(2ULL, v.size());
+    ASSERT_TRUE(v.front() == long_string + "0");
+
+    SmallVector<std::string, 2> copy = v;
+    v.clear();
+    ASSERT_TRUE(v.empty());
+    ASSERT_TRUE(copy[1] == long_string + "9");
+}
@@ -0,0 +1,117 @@
+#include "executable.h"
+#include "SoAVector.h"
+#include "../../../sorting/src/sorting.h"
+
+#include <numeric>
+#include <tuple>
+#include <vector>
+
+namespace {
+    using Record = std::tuple<int, double, char>;
+    using Pair = std::tuple<int, int>;
+}
+
+TEST(soa_vector_push_back_and_columns) {
+    Typegen t;
+
+    SoAVector<int, double, char> v;
+    std::vector<Record> gt;
+
+    for (size_t i = 0; i < 1000; i++) {
+        gt.emplace_back(t.get<int>(), t.get<double>(), t.get<char>());
+        if (i % 2 == 0) {
+            v.push_back(std::get<0>(gt.back()), std::get<1>(gt.back()), std::get<2>(gt.back()));
+        }
+        else {
+            v.push_back(gt.back());
+        }
+    }
+
+    ASSERT_EQ(gt.size(), v.size());
+    ASSERT_EQ(1024ULL, v.capacity());
+
+    auto ints = v.column<0>();
+    auto doubles = v.column<1>();
+    ASSERT_EQ(gt.size(), ints.size());
+    ASSERT_EQ(v.data<0>(), ints.data());
+
+    for (size_t i = 0; i < gt.size(); i++) {
+        ASSERT_EQ(std::get<0>(gt[i]), ints[i]);
+        ASSERT_EQ(std::get<1>(gt[i]), doubles[i]);
+        ASSERT_EQ(std::get<2>(gt[i]), v.get<2>(i));
+        ASSERT_TRUE(gt[i] == static_cast<Record>(v[i]));
+    }
+
+    // every column is contiguous
+    ASSERT_EQ(static_cast<ptrdiff_t>(gt.size()), ints.end() - ints.begin());
+    ASSERT_EXCEPTION(v.at(gt.size()), std::out_of_range);
+}
+
+TEST(soa_vector_proxy_reference) {
+    SoAVector<int, double> v;
+    v.push_back(1, 1.5);
+    v.push_back(2, 2.5);
+
+    // assigning through the proxy writes the record
+    v[0] = v[1];
+    ASSERT_EQ(2, v.get<0>(0));
+    ASSERT_EQ(2.5, v.get<1>(0));
+
+    v[1] = std::make_tuple(3, 3.5);
+    swap(v[0], v[1]);
+    ASSERT_EQ(3, v.front().get<0>());
+    ASSERT_EQ(2.5, v.back().get<1>());
+
+    // a copied proxy still refers to the record
+    auto ref = *v.begin();
+    ref.get<0>() = 7;
+    ASSERT_EQ(7, v.get<0>(0));
+
+    SoAVector<int, double> copy = v;
+    SoAVector<int, double> moved = std::move(v);
+    ASSERT_EQ(0ULL, v.size());
+    ASSERT_TRUE(copy[0] == moved[0]);
+    ASSERT_TRUE(copy[1] == moved[1]);
+}
+
+TEST(soa_vector_sorting_algorithms) {
+    Typegen t;
+
+    for (size_t algo = 0; algo < 3; algo++) {
+        SoAVector<int, size_t> v;
+        for (size_t i = 0; i < 200; i++) {
+            v.push_back(t.range<int>(-50, 50), i);
+        }
+
+        // sort by the first field only, comparing through the proxies
+        auto by_key = [](const SoAVector<int, size_t>::reference& a, const SoAVector<int, size_t>::reference& b) {
+            return a.get<0>() < b.get<0>();
+        };
+
+        if (algo == 0) sort::bubble(v.begin(), v.end(), by_key);
+        if (algo == 1) sort::insertion(v.begin(), v.end(), by_key);
+        if (algo == 2) sort::selection(v.begin(), v.end(), by_key);
+
+        std::vector<size_t> seen(v.size(), 0);
+        for (size_t i = 0; i < v.size(); i++) {
+            if (i > 0) {
+                ASSERT_LE(v.get<0>(i - 1), v.get<0>(i));
+            }
+            seen[v.get<1>(i)]++;
+        }
+        // records moved as a whole: every original index is still present once
+        for (size_t s : seen) {
+            ASSERT_EQ(1ULL, s);
+        }
+    }
+
+    // the default comparator orders by the whole tuple
+    SoAVector<int, int> v;
+    v.push_back(2, 1);
+    v.push_back(1, 9);
+    v.push_back(2, 0);
+    sort::insertion(v.begin(), v.end());
+    ASSERT_TRUE(std::make_tuple(1, 9) == static_cast<Pair>(v[0]));
+    ASSERT_TRUE(std::make_tuple(2, 0) == static_cast<Pair>(v[1]));
+    ASSERT_TRUE(std::make_tuple(2, 1) == static_cast<Pair>(v[2]));
+}